@@ -9,9 +9,14 @@
 #include "src/CubaVegasAlgorithm.hpp"
 
 #include "src/GSLMonteCarloMiserAlgorithm.hpp"
+#include "src/GSLMonteCarloParallelMiserAlgorithm.hpp"
 #include "src/GSLMonteCarloPlainAlgorithm.hpp"
 #include "src/GSLMonteCarloVegasAlgorithm.hpp"
 
+#include "src/GSLQuasiMonteCarloAlgorithm.hpp"
+
+#include "src/LatticeRuleAlgorithm.hpp"
+
 #include "src/GSLNestedCQUADAlgorithm.hpp"
 #include "src/GSLNestedQAGAlgorithm.hpp"
 #include "src/GSLNestedQAGSAlgorithm.hpp"
@@ -22,6 +27,18 @@
 #include "src/CubatureParallelHAdaptiveAlgorithm.hpp"
 #include "src/CubatureParallelPAdaptiveAlgorithm.hpp"
 
+#include "src/HAdaptiveCubatureAlgorithm.hpp"
+#include "src/ParallelHAdaptiveCubatureAlgorithm.hpp"
+#include "src/ParallelPAdaptiveCubatureAlgorithm.hpp"
+#include "src/SparseGridAlgorithm.hpp"
+
+#include "src/TanhSinhAlgorithm.hpp"
+
+#include "src/AutoAlgorithm.hpp"
+#include "src/FallbackAlgorithm.hpp"
+#include "src/PortfolioAlgorithm.hpp"
+#include "src/DecomposedAlgorithm.hpp"
+
 /**
  * \mainpage MultiDimInt
  * C++ library providing a uniform interface for multi-dimensional integrations using various open source integration libraries 
@@ -0,0 +1,128 @@
+#include "../MultiDimInt.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+/**
+ * PAdaptive_benchmark demo:
+ *
+ * Compares the vectorised p-adaptive cubature algorithm of the Cubature library, parallelized via
+ * CubatureParallelPAdaptiveAlgorithm, to the native ParallelPAdaptiveCubatureAlgorithm, which takes the Clenshaw-Curtis
+ * nodes and weights from a shared precomputed table and traverses the whole grid in parallel with a lock-free cache of the
+ * integrand values.
+ *
+ * Both integrate the smooth function f(y) = exp(-(y0^2+...+yN^2)) * cos(y0+...+yN) over the unit hypercube in 3, 4 and
+ * 5 dimensions several times, and the mean run time of a single integration is written to the standard output along
+ * with the results.
+ *
+ * Afterwards, the native algorithm integrates the Gaussian g(y) = exp(-(y0^2+...+yN^2)) over the whole space in 1, 2 and 3
+ * dimensions, whose exact value is pi^(N/2). The outermost Clenshaw-Curtis nodes lie on the infinite bounds, where they
+ * must not be evaluated.
+ */
+
+const double absErr = 0.0;				// absolute error limit
+const double relErr = 1e-8;				// relative error limit
+const std::size_t maxEval = 1e7;		// maximal number of function evaluations
+const int numRepetitions = 10;			// number of integrations that are timed for each case
+
+const MultiDimInt::CubatureParallelPAdaptiveAlgorithm cubatureAlg(absErr, relErr, maxEval);		// p-adaptive algorithm of the Cubature library
+const MultiDimInt::ParallelPAdaptiveCubatureAlgorithm nativeAlg(absErr, relErr, maxEval);		// native p-adaptive algorithm
+
+template <std::size_t Dim>
+double function (const MultiDimInt::Arguments<Dim>& intArgs_y)	// smooth function of Dim variables
+{
+	double squareSum = 0.0;
+	double sum = 0.0;
+
+	for ( std::size_t i = 0; i < Dim; ++i )
+	{
+		squareSum += intArgs_y[i] * intArgs_y[i];
+		sum += intArgs_y[i];
+	}
+
+	return std::exp(-squareSum) * std::cos(sum);	// evaluate f(y)
+}
+
+template <std::size_t Dim>
+double gaussian (const MultiDimInt::Arguments<Dim>& intArgs_y)	// Gaussian of Dim variables
+{
+	double squareSum = 0.0;
+
+	for ( std::size_t i = 0; i < Dim; ++i )
+	{
+		squareSum += intArgs_y[i] * intArgs_y[i];
+	}
+
+	return std::exp(-squareSum);	// evaluate g(y)
+}
+
+template <std::size_t Dim>
+double mean_run_time (const MultiDimInt::Algorithm& alg, double& result, double& error)	// integrate the function of Dim variables 'numRepetitions' times using 'alg' and return the mean run time in seconds
+{
+	const MultiDimInt::Integrator<0,Dim> integrator(function<Dim>, alg);
+
+	const auto startTime = std::chrono::steady_clock::now();
+
+	for ( int i = 0; i < numRepetitions; ++i )
+	{
+		integrator.integrate(result, error);
+	}
+
+	const std::chrono::duration<double> runTime = std::chrono::steady_clock::now() - startTime;
+
+	return runTime.count() / numRepetitions;
+}
+
+template <std::size_t Dim>
+void compare ()	// compare both algorithms for the function of Dim variables and write the results to the standard output
+{
+	double cubatureResult, nativeResult;	// the integration results will be written into these variables
+	double cubatureError, nativeError;		// the respective errors will be written into these variables
+
+	const double cubatureTime = mean_run_time<Dim>(cubatureAlg, cubatureResult, cubatureError);
+	const double nativeTime = mean_run_time<Dim>(nativeAlg, nativeResult, nativeError);
+
+	std::cout << std::scientific
+			  << Dim << " dimensions:" << std::endl
+			  << "	Cubature p-adaptive: " << cubatureResult << " +- " << cubatureError << " in " << cubatureTime << " s" << std::endl
+			  << "	Native p-adaptive:   " << nativeResult << " +- " << nativeError << " in " << nativeTime << " s" << std::endl
+			  << "	Speedup:             " << cubatureTime / nativeTime << std::endl
+			  << std::endl;
+}
+
+template <std::size_t Dim>
+void check_infinite_bounds ()	// integrate the Gaussian of Dim variables over the whole space using the native algorithm and write the result to the standard output
+{
+	const MultiDimInt::Integrator<0,Dim> integrator(gaussian<Dim>, nativeAlg);
+
+	MultiDimInt::Arguments<Dim> lowerBounds, upperBounds;	// integration boundaries
+
+	lowerBounds.fill(MultiDimInt::NegativeInfinity);
+	upperBounds.fill(MultiDimInt::PositiveInfinity);
+
+	double result, error;	// the integration result and its error will be written into these variables
+
+	integrator.integrate(lowerBounds, upperBounds, result, error);
+
+	std::cout << std::scientific
+			  << Dim << " dimensions, infinite bounds:" << std::endl
+			  << "	Native p-adaptive:   " << result << " +- " << error << std::endl
+			  << "	Exact:               " << std::pow(M_PI, 0.5 * Dim) << std::endl
+			  << std::endl;
+}
+
+int main()
+{
+	std::cout << std::endl;
+
+	compare<3>();
+	compare<4>();
+	compare<5>();
+
+	check_infinite_bounds<1>();
+	check_infinite_bounds<2>();
+	check_infinite_bounds<3>();
+
+	return 0;
+}
@@ -1,16 +1,85 @@
 #include "Algorithm.hpp"
 
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <memory>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // public
 
+MultiDimInt::Algorithm::Result MultiDimInt::Algorithm::refine (const InternalIntegrand& func, const std::size_t dimInt, const double* argsFix, const double absErr, const double relErr, const std::size_t extraEval) const
+{
+	std::unique_ptr<Algorithm> refinedAlgorithm (clone());
+	
+	refinedAlgorithm->AbsErr = absErr;
+	refinedAlgorithm->RelErr = relErr;
+	
+	return refinedAlgorithm->run(func, dimInt, argsFix);
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::Algorithm::run_batch (const InternalBatchIntegrand& func, const std::size_t dimInt, const double* argsFix) const
+{
+	const InternalIntegrand pointwiseFunc = [&func] (const double* argsFix, const double* argsInt)	// evaluate the batch integrand for single points
+	{
+		double value;
+		
+		func(argsFix, 1, argsInt, &value);
+		
+		return value;
+	};
+	
+	return run(pointwiseFunc, dimInt, argsFix);
+}
+
+void MultiDimInt::Algorithm::set_context (const Context& context)
+{
+	IntegrationContext = context;
+}
+
+void MultiDimInt::Algorithm::set_given_points (const std::vector<double>& givenPoints)
+{}
+
+void MultiDimInt::Algorithm::set_infinite_bounds (const std::vector<bool>& infiniteBounds)
+{
+	if ( infiniteBounds != InfiniteBounds )	// the flags are usually the same for all integrations, which may run concurrently
+	{
+		InfiniteBounds = infiniteBounds;
+	}
+}
+
+double MultiDimInt::Algorithm::absolute_error_limit () const
+{
+	return AbsErr;
+}
+
+double MultiDimInt::Algorithm::relative_error_limit () const
+{
+	return RelErr;
+}
+
+std::size_t MultiDimInt::Algorithm::evaluation_limit () const
+{
+	return 0;
+}
+
+bool MultiDimInt::Algorithm::is_finite (const double value)
+{
+	std::uint64_t bits;
+	
+	std::memcpy(&bits, &value, sizeof(bits));
+	
+	return (bits & 0x7FF0000000000000ULL) != 0x7FF0000000000000ULL;	// infinite values and NaN are the only ones with all exponent bits set
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // protected
 
 MultiDimInt::Algorithm::Algorithm (const double absErr, const double relErr) :
 	AbsErr(absErr),
-	RelErr(relErr)
+	RelErr(relErr),
+	IntegrationContext{"", 0, Deadline(), nullptr},
+	InfiniteBounds()
 {
 	if ( AbsErr < 0 )
 	{
@@ -31,5 +100,30 @@ MultiDimInt::Algorithm::Algorithm (const double absErr, const double relErr) :
 	}
 }
 
+bool MultiDimInt::Algorithm::deadline_reached () const
+{
+	return IntegrationContext.IntegrationDeadline.is_reached();
+}
+
+void MultiDimInt::Algorithm::report_progress (const double value, const double error, const std::size_t numEval) const
+{
+	if ( IntegrationContext.Monitor )
+	{
+		IntegrationContext.Monitor->report(value, error, numEval);
+	}
+}
+
+bool MultiDimInt::Algorithm::progress_monitored () const
+{
+	return static_cast<bool>(IntegrationContext.Monitor);
+}
+
+bool MultiDimInt::Algorithm::infinite_bound (const std::size_t i_dim, const bool upper) const
+{
+	const std::size_t i_bound = 2 * i_dim + (upper ? 1 : 0);
+	
+	return (i_bound < InfiniteBounds.size()) && InfiniteBounds[i_bound];
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // private
\ No newline at end of file
@@ -1,8 +1,13 @@
 #ifndef MULTIDIMINT_ALGORITHM_H
 #define MULTIDIMINT_ALGORITHM_H
 
+#include "Deadline.hpp"
+#include "ProgressMonitor.hpp"
+
 #include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace MultiDimInt
 {
@@ -24,10 +29,22 @@ namespace MultiDimInt
 		 */
 		using InternalIntegrand = std::function<double(const double* argsFix, const double* argsInt)>;
 		
+		/**
+		 * Internal wrapper for a MultiDimInt::BatchIntegrand that evaluates the integrand at \a numPoints points at once.
+		 * The integration variables of all points are stored consecutively in \a argsInt, with dimInt values each, and the
+		 * integrand values are written into \a values. \a argsFix denotes the arguments which are kept fixed, as for
+		 * Algorithm::InternalIntegrand.
+		 */
+		using InternalBatchIntegrand = std::function<void(const double* argsFix, std::size_t numPoints, const double* argsInt, double* values)>;
+		
 		/**
 		 * Structure that contains all relevant results of an integration run. \a Failed is a \c bool that will be set to
 		 * \c true if the integration failed, \a Value is the actual numerical value of the integral and \a Error the estimated
-		 * absolute error. Furthermore, additional information can be passed via the \c string \a Comment.
+		 * absolute error. Furthermore, additional information can be passed via the \c string \a Comment. \a DeadlineReached
+		 * is set to \c true if the integration was stopped by its Deadline before meeting the error limits, in which case
+		 * \a Value and \a Error are the estimates so far, but the integration does not count as failed. \a History holds
+		 * the progress reported after each iteration if the Integrator records it (see Integrator::set_history_recording),
+		 * and is empty otherwise.
 		 * 
 		 * These information are used by Integrator::integrate, Integrator:integrand_without_warning and Integrator::error_handler.
 		 */
@@ -37,6 +54,26 @@ namespace MultiDimInt
 			double Value;
 			double Error;
 			std::string Comment;
+			bool DeadlineReached;
+			std::vector<ProgressMonitor::Progress> History;
+		};
+		
+		/**
+		 * Structure describing the context an Algorithm is used in. \a Identifier is the identifier of the Integrator
+		 * using the Algorithm, \a DimFix is the number of fixed arguments argsFix passed to Algorithm::run, and
+		 * \a IntegrationDeadline is the Deadline at which a running integration has to stop, which is never reached
+		 * unless the Integrator has a time limit or a CancellationToken, and \a Monitor is the ProgressMonitor receiving
+		 * the progress of the integration, which is empty unless the Integrator has a progress callback or records the
+		 * history.
+		 * 
+		 * This information is e.g. used to derive names of files an Algorithm stores persistent data in.
+		 */
+		struct Context
+		{
+			std::string Identifier;
+			std::size_t DimFix;
+			Deadline IntegrationDeadline;
+			std::shared_ptr<ProgressMonitor> Monitor;
 		};
 
 		/**
@@ -46,6 +83,23 @@ namespace MultiDimInt
 		 */
 		virtual Result run (const InternalIntegrand& func, std::size_t dimInt, const double* argsFix) const = 0;
 		
+		/**
+		 * Performs the integration of the Algorithm::InternalBatchIntegrand \a func, which evaluates whole batches of points
+		 * at once, and returns the resulting Algorithm::Result. Algorithms that sample the integrand in batches, e.g.
+		 * CubatureSerialHAdaptiveAlgorithm, pass these batches on to \a func directly. By default, \a func is called for
+		 * one point at a time by Algorithm::run.
+		 */
+		virtual Result run_batch (const InternalBatchIntegrand& func, std::size_t dimInt, const double* argsFix) const;
+		
+		/**
+		 * Performs the integration of the Algorithm::InternalIntegrand \a func again with the tighter absolute and relative
+		 * error limits \a absErr and \a relErr, using at most \a extraEval further integrand evaluations, and returns the
+		 * resulting Algorithm::Result. Algorithms that keep the state of their last integration, e.g. HAdaptiveCubatureAlgorithm,
+		 * continue from that state. By default, the integration is simply repeated from scratch by a copy of this Algorithm
+		 * with the new error limits, ignoring \a extraEval.
+		 */
+		virtual Result refine (const InternalIntegrand& func, std::size_t dimInt, const double* argsFix, double absErr, double relErr, std::size_t extraEval) const;
+		
 		/**
 		 * Returns 'true' if this integration algorithm uses multiple cores in parallel and 'false' if it only runs
 		 * on a single core.
@@ -63,6 +117,57 @@ namespace MultiDimInt
 		 */
 		virtual Algorithm* clone () const = 0;
 		
+		/**
+		 * Sets the Algorithm::Context \a context this Algorithm is used in. This is called by the Integrator the Algorithm
+		 * is passed to.
+		 */
+		void set_context (const Context& context);
+		
+		/**
+		 * Passes points \a givenPoints on the unit hypercube at which the integrand is known to be large, e.g. the locations
+		 * of its peaks, to the Algorithm. They are concatenated into a single vector, such that each consecutive group of
+		 * dimInt values forms one point. This is called by the Integrator the Algorithm is passed to.
+		 * 
+		 * Algorithms that can make use of such points override this method, while all others ignore them.
+		 */
+		virtual void set_given_points (const std::vector<double>& givenPoints);
+		
+		/**
+		 * Passes the flags \a infiniteBounds to the Algorithm, which tell for each integration variable whether the
+		 * coordinates 0 and 1 on the unit hypercube correspond to an infinite bound of the integration region, where the
+		 * transformed integrand cannot be evaluated. The entries 2i and 2i+1 belong to the coordinates 0 and 1 of the
+		 * integration variable i. An empty vector means that the integration region is the unit hypercube itself, while
+		 * custom bounds that are all finite come with flags that are all \c false. This is called by the Integrator the
+		 * Algorithm is passed to before each integration.
+		 * 
+		 * Algorithms that evaluate the integrand on the boundary of the unit hypercube skip these points, and algorithms
+		 * combining other algorithms pass the flags on to them.
+		 */
+		virtual void set_infinite_bounds (const std::vector<bool>& infiniteBounds);
+		
+		/**
+		 * Returns the absolute error limit.
+		 */
+		double absolute_error_limit () const;
+		
+		/**
+		 * Returns the relative error limit.
+		 */
+		double relative_error_limit () const;
+		
+		/**
+		 * Returns the maximal number of integrand evaluations of one integration, where 0 means that there is no limit or
+		 * that the Algorithm does not tell it. Algorithms that continue from their state in Algorithm::refine override this,
+		 * such that algorithms combining other algorithms can use it as the budget of a refinement.
+		 */
+		virtual std::size_t evaluation_limit () const;
+		
+		/**
+		 * Returns \c true if \a value is neither infinite nor NaN. In contrast to \c std::isfinite, this inspects the
+		 * bits of \a value, such that it is not optimized away when compiling with \c -ffast-math.
+		 */
+		static bool is_finite (double value);
+		
 		/**
 		 * Default assignment operator.
 		 */
@@ -88,6 +193,31 @@ namespace MultiDimInt
 		 */
 		Algorithm (const Algorithm& otherAlgorithm) = default;
 		
+		/**
+		 * Returns \c true if the Deadline of the Algorithm::Context has been reached. Algorithms that iterate check this
+		 * between their iterations and stop, returning their estimate so far with Algorithm::Result::DeadlineReached set.
+		 */
+		bool deadline_reached () const;
+		
+		/**
+		 * Reports the current estimates \a value and \a error of the integral after \a numEval integrand evaluations to
+		 * the ProgressMonitor of the Algorithm::Context, if there is one. Algorithms that iterate call this after each
+		 * iteration.
+		 */
+		void report_progress (double value, double error, std::size_t numEval) const;
+		
+		/**
+		 * Returns \c true if the Algorithm::Context has a ProgressMonitor, such that algorithms can avoid work that is
+		 * only needed for reporting the progress.
+		 */
+		bool progress_monitored () const;
+		
+		/**
+		 * Returns \c true if the coordinate 1 of the integration variable \a i_dim on the unit hypercube if \a upper is
+		 * \c true, or its coordinate 0 otherwise, corresponds to an infinite bound, see Algorithm::set_infinite_bounds.
+		 */
+		bool infinite_bound (std::size_t i_dim, bool upper) const;
+		
 		/**
 		 * Absolute error limit.
 		 */
@@ -97,6 +227,16 @@ namespace MultiDimInt
 		 * Relative error limit.
 		 */
 		double RelErr;
+		
+		/**
+		 * Context this Algorithm is used in.
+		 */
+		Context IntegrationContext;
+		
+		/**
+		 * Flags passed via Algorithm::set_infinite_bounds.
+		 */
+		std::vector<bool> InfiniteBounds;
 	};
 }
 
@@ -0,0 +1,580 @@
+#include "AutoAlgorithm.hpp"
+
+#include "CubaVegasAlgorithm.hpp"
+#include "HAdaptiveCubatureAlgorithm.hpp"
+#include "LatticeRuleAlgorithm.hpp"
+#include "ParallelHAdaptiveCubatureAlgorithm.hpp"
+#include "ParallelPAdaptiveCubatureAlgorithm.hpp"
+#include "SparseGridAlgorithm.hpp"
+#include "TanhSinhAlgorithm.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <numeric>
+
+#include <omp.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::AutoAlgorithm::AutoAlgorithm (const double absErr, const double relErr, const std::size_t maxEval, const std::size_t probeEval) :
+	Algorithm(absErr, relErr),
+	MaxEval(maxEval),
+	ProbeEval(probeEval),
+	GivenPoints()
+{
+	if ( ProbeEval == 0 )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::AutoAlgorithm Error: Number of probe evaluations is zero" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::AutoAlgorithm::run (const InternalIntegrand& func, const std::size_t dimInt, const double* argsFix) const
+{
+	const InternalBatchIntegrand batchFunc = [&func, dimInt] (const double* argsFix, const std::size_t numPoints, const double* argsInt, double* values)	// evaluate the probe points one by one
+	{
+		for ( std::size_t i_point = 0; i_point < numPoints; ++i_point )
+		{
+			values[i_point] = func(argsFix, &argsInt[i_point * dimInt]);
+		}
+	};
+
+	std::unique_ptr<Algorithm> backend;
+	Backend selectedBackend;
+
+	const Algorithm::Result preparation = prepare_backend(batchFunc, dimInt, argsFix, backend, selectedBackend);
+
+	if ( preparation.Failed )
+	{
+		return preparation;
+	}
+
+	return annotate(backend->run(func, dimInt, argsFix), selectedBackend);
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::AutoAlgorithm::run_batch (const InternalBatchIntegrand& func, const std::size_t dimInt, const double* argsFix) const
+{
+	std::unique_ptr<Algorithm> backend;
+	Backend selectedBackend;
+
+	const Algorithm::Result preparation = prepare_backend(func, dimInt, argsFix, backend, selectedBackend);
+
+	if ( preparation.Failed )
+	{
+		return preparation;
+	}
+
+	return annotate(backend->run_batch(func, dimInt, argsFix), selectedBackend);
+}
+
+bool MultiDimInt::AutoAlgorithm::is_parallelized () const
+{
+	return true;	// most backends are parallelized
+}
+
+MultiDimInt::AutoAlgorithm* MultiDimInt::AutoAlgorithm::clone () const
+{
+	return new AutoAlgorithm(*this);
+}
+
+void MultiDimInt::AutoAlgorithm::set_given_points (const std::vector<double>& givenPoints)
+{
+	GivenPoints = givenPoints;
+}
+
+MultiDimInt::AutoAlgorithm::Backend MultiDimInt::AutoAlgorithm::select_backend (const Features& features, const std::size_t dimInt, const std::size_t numProbeEval) const
+{
+	const double budget = (MaxEval > 0) ? static_cast<double>(MaxEval - std::min(MaxEval, numProbeEval)) : std::numeric_limits<double>::infinity();
+	const double numThreads = omp_get_max_threads();
+
+	const Backend candidates[] = {Backend::PAdaptiveCubature, Backend::SparseGrid, Backend::HAdaptiveCubature, Backend::ParallelHAdaptiveCubature,
+								  Backend::TanhSinh, Backend::LatticeRule, Backend::Vegas};
+
+	Backend selectedBackend = Backend::Vegas;	// the only candidate that is always applicable
+	bool selectedFits = false;
+	double selectedTime = std::numeric_limits<double>::infinity();
+
+	const bool infiniteBounds = (std::find(InfiniteBounds.begin(), InfiniteBounds.end(), true) != InfiniteBounds.end());
+
+	for ( const Backend backend : candidates )
+	{
+		if ( ((backend == Backend::PAdaptiveCubature) || (backend == Backend::SparseGrid)) && infiniteBounds )	// their nested rules sample the faces of the unit hypercube, where the transformed integrand blows up or decays too slowly for them to converge
+		{
+			continue;
+		}
+
+		if ( ((backend == Backend::HAdaptiveCubature) || (backend == Backend::ParallelHAdaptiveCubature)) && (dimInt > 30) )	// the Genz-Malik rule samples all corners of a subregion
+		{
+			continue;
+		}
+
+		if ( (backend == Backend::LatticeRule) && (budget < 4096) )	// minimal number of integrand evaluations of the lattice rule
+		{
+			continue;
+		}
+
+		const bool parallel = (backend != Backend::HAdaptiveCubature) && (backend != Backend::TanhSinh);
+
+		const double numEval = predicted_evaluations(backend, features, dimInt);
+		const double bookkeepingTime = (parallel ? 2e-8 : 1e-8) * static_cast<double>(dimInt);	// rough time spent on each point besides its evaluation, which is larger if threads have to synchronize
+		const double time = numEval * (features.EvaluationTime / (parallel ? numThreads : 1.0) + bookkeepingTime);
+		const bool fits = (numEval <= budget);
+
+		if ( (fits && (not selectedFits)) || ((fits == selectedFits) && (time < selectedTime)) )	// prefer backends that are predicted to stay within the maximal number of integrand evaluations
+		{
+			selectedBackend = backend;
+			selectedFits = fits;
+			selectedTime = time;
+		}
+	}
+
+	return selectedBackend;
+}
+
+std::string MultiDimInt::AutoAlgorithm::backend_name (const Backend backend)
+{
+	switch ( backend )
+	{
+		case Backend::PAdaptiveCubature:
+			return "ParallelPAdaptiveCubatureAlgorithm";
+		case Backend::SparseGrid:
+			return "SparseGridAlgorithm";
+		case Backend::HAdaptiveCubature:
+			return "HAdaptiveCubatureAlgorithm";
+		case Backend::ParallelHAdaptiveCubature:
+			return "ParallelHAdaptiveCubatureAlgorithm";
+		case Backend::TanhSinh:
+			return "TanhSinhAlgorithm";
+		case Backend::LatticeRule:
+			return "LatticeRuleAlgorithm";
+		case Backend::Vegas:
+			return "CubaVegasAlgorithm";
+	}
+
+	return "";
+}
+
+void MultiDimInt::AutoAlgorithm::clear_cache ()
+{
+	std::lock_guard<std::mutex> lock (feature_cache_mutex());
+
+	feature_cache().clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
+
+MultiDimInt::AutoAlgorithm::Features MultiDimInt::AutoAlgorithm::features (const InternalBatchIntegrand& func, const std::size_t dimInt, const double* argsFix, std::size_t& numProbeEval) const
+{
+	numProbeEval = 0;
+
+	if ( IntegrationContext.Identifier.empty() )
+	{
+		return probe(func, dimInt, argsFix, numProbeEval);
+	}
+
+	std::string key = IntegrationContext.Identifier + "/" + std::to_string(dimInt) + "/";	// the transformed integrand depends on the type of the bounds
+
+	if ( InfiniteBounds.empty() )
+	{
+		key += "unit";
+	}
+	else
+	{
+		for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )
+		{
+			key += infinite_bound(i_dim, false) ? (infinite_bound(i_dim, true) ? 'i' : 's') : 'f';	// infinite, semi-infinite or finite
+		}
+	}
+
+	bool cached = false;
+	Features cachedFeatures;
+
+	{
+		std::lock_guard<std::mutex> lock (feature_cache_mutex());
+
+		const auto cacheEntry = feature_cache().find(key);
+
+		if ( cacheEntry != feature_cache().end() )
+		{
+			cached = true;
+			cachedFeatures = cacheEntry->second;
+		}
+	}
+
+	if ( cached )	// the magnitude of the integrand depends on its fixed arguments, so it is estimated anew
+	{
+		estimate_magnitude(func, dimInt, argsFix, numProbeEval, cachedFeatures);
+
+		return cachedFeatures;
+	}
+
+	const Features probedFeatures = probe(func, dimInt, argsFix, numProbeEval);	// the cache is not locked while probing, as the integrand may itself use an AutoAlgorithm
+
+	Features scaleFreeFeatures = probedFeatures;
+
+	scaleFreeFeatures.Mean = 0.0;
+	scaleFreeFeatures.Deviation = 0.0;
+
+	std::lock_guard<std::mutex> lock (feature_cache_mutex());
+
+	feature_cache().emplace(key, scaleFreeFeatures);
+
+	return probedFeatures;
+}
+
+MultiDimInt::AutoAlgorithm::Features MultiDimInt::AutoAlgorithm::probe (const InternalBatchIntegrand& func, const std::size_t dimInt, const double* argsFix, std::size_t& numProbeEval) const
+{
+	const double step = 1.0 / 32.0;				// distance of the axial neighbors, which is also kept from the faces of the unit hypercube by all other points
+	const double boundaryDistance = 1e-9;		// distance of the points close to the faces of the unit hypercube
+
+	const std::size_t numBase = std::max(dimInt, (ProbeEval > 2 * dimInt) ? (ProbeEval - 2 * dimInt) / 3 : 0);	// each point of the low-discrepancy sequence comes with two axial neighbors
+	const std::size_t numPoints = 3 * numBase + 2 * dimInt;
+
+	const std::vector<double> sequencePoints = sequence_points(dimInt, numBase, step);
+
+	std::vector<double> points (numPoints * dimInt);
+	std::vector<double> values (numPoints);
+
+	for ( std::size_t i_base = 0; i_base < numBase; ++i_base )
+	{
+		double* basePoint = &points[3 * i_base * dimInt];
+
+		std::copy_n(&sequencePoints[i_base * dimInt], dimInt, basePoint);
+		std::copy_n(basePoint, dimInt, basePoint + dimInt);
+		std::copy_n(basePoint, dimInt, basePoint + 2 * dimInt);
+
+		const std::size_t i_axis = i_base % dimInt;	// the axes of the neighbors cycle through all dimensions
+
+		basePoint[dimInt + i_axis] -= step;
+		basePoint[2 * dimInt + i_axis] += step;
+	}
+
+	for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )	// points close to the lower and upper face in each dimension, starting from the center of the unit hypercube
+	{
+		double* lowerPoint = &points[(3 * numBase + 2 * i_dim) * dimInt];
+		double* upperPoint = lowerPoint + dimInt;
+
+		std::fill_n(lowerPoint, 2 * dimInt, 0.5);
+
+		lowerPoint[i_dim] = boundaryDistance;
+		upperPoint[i_dim] = 1.0 - boundaryDistance;
+	}
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	func(argsFix, numPoints, points.data(), values.data());
+
+	const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+	numProbeEval = numPoints;
+
+	Features features = {0.0, 0.0, 1.0, 0.0, 1, false, duration.count() / static_cast<double>(numPoints)};
+
+	std::size_t numFinite = 0;
+	double sum = 0.0;
+	double sumOfSquares = 0.0;
+	double sumOfAbsolutes = 0.0;
+	double maxAbsolute = 0.0;
+	double minValue = std::numeric_limits<double>::infinity();
+	double maxValue = -std::numeric_limits<double>::infinity();
+
+	for ( std::size_t i_point = 0; i_point < 3 * numBase; ++i_point )
+	{
+		const double value = values[i_point];
+
+		if ( not is_finite(value) )
+		{
+			continue;
+		}
+
+		minValue = std::min(minValue, value);
+		maxValue = std::max(maxValue, value);
+		maxAbsolute = std::max(maxAbsolute, std::abs(value));
+
+		if ( i_point % 3 == 0 )	// only the points of the low-discrepancy sequence estimate the distribution of the values
+		{
+			++numFinite;
+
+			sum += value;
+			sumOfSquares += value * value;
+			sumOfAbsolutes += std::abs(value);
+		}
+	}
+
+	if ( numFinite > 0 )
+	{
+		features.Mean = sum / static_cast<double>(numFinite);
+		features.Deviation = std::sqrt(std::max(0.0, sumOfSquares / static_cast<double>(numFinite) - features.Mean * features.Mean));
+
+		if ( sumOfAbsolutes > 0.0 )
+		{
+			features.Peakedness = maxAbsolute / (sumOfAbsolutes / static_cast<double>(numFinite));
+		}
+	}
+
+	const double range = (maxValue > minValue) ? maxValue - minValue : 0.0;
+
+	std::vector<double> sensitivities (dimInt, 0.0);	// mean variation along each axis
+	std::size_t numRough = 0;
+
+	for ( std::size_t i_base = 0; i_base < numBase; ++i_base )
+	{
+		const double center = values[3 * i_base];
+		const double lower = values[3 * i_base + 1];
+		const double upper = values[3 * i_base + 2];
+
+		if ( (not is_finite(center)) || (not is_finite(lower)) || (not is_finite(upper)) )
+		{
+			++numRough;
+
+			continue;
+		}
+
+		if ( std::abs(upper - 2.0 * center + lower) > 0.25 * range )
+		{
+			++numRough;
+		}
+
+		sensitivities[i_base % dimInt] += std::abs(upper - lower);
+	}
+
+	features.Roughness = static_cast<double>(numRough) / static_cast<double>(numBase);
+
+	const double totalSensitivity = std::accumulate(sensitivities.begin(), sensitivities.end(), 0.0);
+
+	if ( totalSensitivity > 0.0 )
+	{
+		std::sort(sensitivities.begin(), sensitivities.end(), std::greater<double>());
+
+		double partialSensitivity = sensitivities[0];
+
+		while ( (features.EffectiveDim < dimInt) && (partialSensitivity < 0.99 * totalSensitivity) )
+		{
+			partialSensitivity += sensitivities[features.EffectiveDim];
+
+			++features.EffectiveDim;
+		}
+	}
+
+	for ( std::size_t i_point = 3 * numBase; i_point < numPoints; ++i_point )
+	{
+		const double value = values[i_point];
+
+		if ( (not is_finite(value)) || (std::abs(value) > 100.0 * maxAbsolute + std::numeric_limits<double>::min()) )
+		{
+			features.EndpointSingular = true;
+		}
+	}
+
+	return features;
+}
+
+void MultiDimInt::AutoAlgorithm::estimate_magnitude (const InternalBatchIntegrand& func, const std::size_t dimInt, const double* argsFix, std::size_t& numProbeEval, Features& features) const
+{
+	const double step = 1.0 / 32.0;	// distance kept from the faces of the unit hypercube, as by the probe points
+
+	const std::size_t numPoints = std::max(dimInt, ProbeEval / 8);
+
+	const std::vector<double> points = sequence_points(dimInt, numPoints, step);
+	std::vector<double> values (numPoints);
+
+	func(argsFix, numPoints, points.data(), values.data());
+
+	numProbeEval = numPoints;
+
+	std::size_t numFinite = 0;
+	double sum = 0.0;
+	double sumOfSquares = 0.0;
+
+	for ( const double value : values )
+	{
+		if ( is_finite(value) )
+		{
+			++numFinite;
+
+			sum += value;
+			sumOfSquares += value * value;
+		}
+	}
+
+	features.Mean = 0.0;
+	features.Deviation = 0.0;
+
+	if ( numFinite > 0 )
+	{
+		features.Mean = sum / static_cast<double>(numFinite);
+		features.Deviation = std::sqrt(std::max(0.0, sumOfSquares / static_cast<double>(numFinite) - features.Mean * features.Mean));
+	}
+}
+
+std::vector<double> MultiDimInt::AutoAlgorithm::sequence_points (const std::size_t dimInt, const std::size_t numPoints, const double step)
+{
+	double phi = 2.0;	// the low-discrepancy sequence is the additive recurrence based on the generalized golden ratio, i.e. the positive root of phi^(dimInt + 1) = phi + 1
+
+	for ( int i_iteration = 0; i_iteration < 64; ++i_iteration )
+	{
+		phi = std::pow(1.0 + phi, 1.0 / static_cast<double>(dimInt + 1));
+	}
+
+	std::vector<double> alpha (dimInt);
+
+	for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )
+	{
+		alpha[i_dim] = std::fmod(std::pow(1.0 / phi, static_cast<double>(i_dim + 1)), 1.0);
+	}
+
+	std::vector<double> points (numPoints * dimInt);
+
+	for ( std::size_t i_point = 0; i_point < numPoints; ++i_point )
+	{
+		for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )
+		{
+			points[i_point * dimInt + i_dim] = step + (1.0 - 2.0 * step) * std::fmod(0.5 + static_cast<double>(i_point + 1) * alpha[i_dim], 1.0);
+		}
+	}
+
+	return points;
+}
+
+double MultiDimInt::AutoAlgorithm::predicted_evaluations (const Backend backend, const Features& features, const std::size_t dimInt) const
+{
+	const double dim = static_cast<double>(dimInt);
+	const double effectiveDim = static_cast<double>(features.EffectiveDim);
+
+	const double scale = std::max(std::max(std::abs(features.Mean), features.Deviation), std::numeric_limits<double>::min());
+	const double tolerance = std::min(1.0, std::max(1e-15, std::max(AbsErr, RelErr * std::abs(features.Mean)) / scale));	// error limit relative to the typical integrand value
+	const double digits = std::max(1.0, -std::log10(tolerance));
+	const double variation = features.Deviation / scale;
+
+	const bool smooth = (features.Roughness <= 0.02) && (not features.EndpointSingular);
+	const bool peaked = (features.Peakedness > 20.0) || (not GivenPoints.empty());
+
+	const double peakFactor = peaked ? std::max(20.0, features.Peakedness) : 1.0;
+	const double unsuited = 1e12;	// factor for backends whose convergence breaks down for the integrand
+
+	const double numNodes = std::pow(2.0, std::ceil(std::log2(2.0 * digits))) + 1.0;	// nodes of the Clenshaw-Curtis rule per dimension needed for an analytic integrand
+
+	double numEval = 0.0;
+
+	switch ( backend )
+	{
+		case Backend::PAdaptiveCubature:
+			numEval = std::pow(numNodes, effectiveDim) * std::pow(3.0, dim - effectiveDim) * (smooth ? peakFactor : unsuited);
+			break;
+
+		case Backend::SparseGrid:
+			numEval = (2.0 * dim + 1.0 + numNodes * std::pow(1.0 + std::log2(numNodes), effectiveDim - 1.0) / std::tgamma(effectiveDim)) * (smooth ? peakFactor : unsuited);
+			break;
+
+		case Backend::HAdaptiveCubature:
+		case Backend::ParallelHAdaptiveCubature:
+		{
+			const double rulePoints = (dimInt == 1) ? 15.0 : std::pow(2.0, dim) + 2.0 * dim * dim + 2.0 * dim + 1.0;	// Gauss-Kronrod or Genz-Malik rule
+			const double convergenceOrder = smooth ? 8.0 : (features.EndpointSingular ? 2.0 : 1.0);	// power of the subregion size the error decreases with
+
+			numEval = rulePoints * std::pow(10.0, digits * effectiveDim / convergenceOrder) * (1.0 + std::log2(peakFactor));
+			break;
+		}
+
+		case Backend::TanhSinh:
+			numEval = std::pow(7.0 * digits, effectiveDim) * std::pow(7.0, dim - effectiveDim) * ((smooth || features.EndpointSingular) ? peakFactor : unsuited);
+			break;
+
+		case Backend::LatticeRule:
+			numEval = std::max(4096.0, 16.0 * std::pow(variation / tolerance, smooth ? 1.0 : 1.5));
+			break;
+
+		case Backend::Vegas:
+			numEval = std::max(1000.0, std::pow(variation / tolerance, 2.0) / peakFactor);
+			break;
+	}
+
+	return std::min(numEval, 1e300);
+}
+
+std::unique_ptr<MultiDimInt::Algorithm> MultiDimInt::AutoAlgorithm::create_backend (const Backend backend, const std::size_t maxEval) const
+{
+	switch ( backend )
+	{
+		case Backend::PAdaptiveCubature:
+			return std::unique_ptr<Algorithm>(new ParallelPAdaptiveCubatureAlgorithm(AbsErr, RelErr, maxEval));
+		case Backend::SparseGrid:
+			return std::unique_ptr<Algorithm>(new SparseGridAlgorithm(AbsErr, RelErr, maxEval));
+		case Backend::HAdaptiveCubature:
+			return std::unique_ptr<Algorithm>(new HAdaptiveCubatureAlgorithm(AbsErr, RelErr, maxEval));
+		case Backend::ParallelHAdaptiveCubature:
+			return std::unique_ptr<Algorithm>(new ParallelHAdaptiveCubatureAlgorithm(AbsErr, RelErr, maxEval));
+		case Backend::TanhSinh:
+			return std::unique_ptr<Algorithm>(new TanhSinhAlgorithm(AbsErr, RelErr, maxEval));
+		case Backend::LatticeRule:
+			return std::unique_ptr<Algorithm>(new LatticeRuleAlgorithm(AbsErr, RelErr, maxEval));
+		case Backend::Vegas:
+			break;
+	}
+
+	const std::size_t maxIntEval = std::numeric_limits<int>::max();	// Cuba counts the integrand evaluations as int
+
+	return std::unique_ptr<Algorithm>(new CubaVegasAlgorithm(AbsErr, RelErr, static_cast<int>(((maxEval > 0) && (maxEval < maxIntEval)) ? maxEval : maxIntEval)));
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::AutoAlgorithm::prepare_backend (const InternalBatchIntegrand& func, const std::size_t dimInt, const double* argsFix, std::unique_ptr<Algorithm>& backend, Backend& selectedBackend) const
+{
+	std::size_t numProbeEval;
+
+	const Features integrandFeatures = features(func, dimInt, argsFix, numProbeEval);
+
+	if ( (MaxEval > 0) && (numProbeEval >= MaxEval) )
+	{
+		return Algorithm::Result{true, integrandFeatures.Mean, integrandFeatures.Deviation, "	-Auto algorithm error: Maximal number of integrand evaluations used up by probing the integrand"};
+	}
+
+	selectedBackend = select_backend(integrandFeatures, dimInt, numProbeEval);
+
+	backend = create_backend(selectedBackend, (MaxEval > 0) ? MaxEval - numProbeEval : 0);
+
+	backend->set_context(IntegrationContext);
+	backend->set_infinite_bounds(InfiniteBounds);
+
+	if ( not GivenPoints.empty() )
+	{
+		backend->set_given_points(GivenPoints);
+	}
+
+	return Algorithm::Result{false, 0.0, 0.0, ""};
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::AutoAlgorithm::annotate (Algorithm::Result integral, const Backend selectedBackend)
+{
+	if ( integral.Failed || integral.DeadlineReached )
+	{
+		integral.Comment += std::string("\n") + std::string("	-Auto algorithm: Integration was dispatched to ") + backend_name(selectedBackend);
+	}
+
+	return integral;
+}
+
+std::map<std::string, MultiDimInt::AutoAlgorithm::Features>& MultiDimInt::AutoAlgorithm::feature_cache ()
+{
+	static std::map<std::string, Features> cache;
+
+	return cache;
+}
+
+std::mutex& MultiDimInt::AutoAlgorithm::feature_cache_mutex ()
+{
+	static std::mutex mutex;
+
+	return mutex;
+}
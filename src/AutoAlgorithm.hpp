@@ -0,0 +1,196 @@
+#ifndef MULTIDIMINT_AUTO_ALGORITHM_H
+#define MULTIDIMINT_AUTO_ALGORITHM_H
+
+#include "Algorithm.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class implementing a meta-algorithm that selects the integration algorithm on its own.
+	 *
+	 * Before the integration, the integrand is probed with a small number of evaluations: at points of a low-discrepancy
+	 * sequence inside the unit hypercube, at their neighbors along one of the axes, and close to the faces of the unit
+	 * hypercube. From these, the AutoAlgorithm estimates the scatter and the peakedness of the integrand, its smoothness,
+	 * its effective dimension, whether it is singular at the boundaries, and the time one evaluation takes (see
+	 * AutoAlgorithm::Features). It then predicts the number of evaluations each of the candidate backends (see
+	 * AutoAlgorithm::Backend) needs to meet the error limits, and dispatches the integration to the one that is expected to
+	 * finish first, preferring those that stay within the maximal number of integrand evaluations. If any bound is
+	 * infinite, the backends evaluating the integrand on the faces of the unit hypercube are not considered.
+	 *
+	 * The features are cached per identifier of the Integrator using the AutoAlgorithm, per number of integration
+	 * variables and per type of the integration bounds (the unit hypercube, or custom bounds of which each is finite,
+	 * semi-infinite or infinite), such that later integrations by Integrators with the same identifier skip the probing,
+	 * regardless of their fixed arguments. Only the scale-free Features are cached, while the magnitude of the integrand,
+	 * i.e. AutoAlgorithm::Features::Mean and AutoAlgorithm::Features::Deviation, is estimated anew by each integration from
+	 * an eighth of the probe evaluations. Integrators without identifier are probed every time, and
+	 * AutoAlgorithm::clear_cache removes all cached Features. The probe evaluations count towards the maximal number of
+	 * integrand evaluations, while they are not reused by the selected backend.
+	 *
+	 * The prediction is a rough model and is only meant to avoid choices that are off by orders of magnitude. If the
+	 * selected backend fails, the comment of the returned Algorithm::Result names it.
+	 */
+	class AutoAlgorithm : public Algorithm
+	{
+	public:
+		/**
+		 * Integration algorithms the AutoAlgorithm can dispatch to:
+		 *
+		 *  - PAdaptiveCubature: ParallelPAdaptiveCubatureAlgorithm, for smooth integrands in few dimensions
+		 *  - SparseGrid: SparseGridAlgorithm, for smooth integrands in many dimensions
+		 *  - HAdaptiveCubature: HAdaptiveCubatureAlgorithm, for peaked or non-smooth integrands in few dimensions
+		 *  - ParallelHAdaptiveCubature: ParallelHAdaptiveCubatureAlgorithm, the same for expensive integrands
+		 *  - TanhSinh: TanhSinhAlgorithm, for integrands with singularities at the boundaries
+		 *  - LatticeRule: LatticeRuleAlgorithm, for moderately smooth integrands in many dimensions
+		 *  - Vegas: CubaVegasAlgorithm, for peaked or non-smooth integrands in many dimensions
+		 */
+		enum class Backend {PAdaptiveCubature, SparseGrid, HAdaptiveCubature, ParallelHAdaptiveCubature, TanhSinh, LatticeRule, Vegas};
+
+		/**
+		 * Structure containing the properties of an integrand estimated from the probe evaluations. \a Mean and \a Deviation
+		 * are the mean and the standard deviation of the integrand values at the points of the low-discrepancy sequence.
+		 * \a Peakedness is the ratio of the largest to the mean absolute value there, and \a Roughness the fraction of the
+		 * axial neighbors whose second differences are comparable to the range of the integrand values. \a EffectiveDim
+		 * is the number of integration variables that account for 99% of the variation along the axes, \a EndpointSingular
+		 * is \c true if the integrand grows strongly towards the faces of the unit hypercube, and \a EvaluationTime is
+		 * the mean time of one evaluation in seconds.
+		 */
+		struct Features
+		{
+			double Mean;
+			double Deviation;
+			double Peakedness;
+			double Roughness;
+			std::size_t EffectiveDim;
+			bool EndpointSingular;
+			double EvaluationTime;
+		};
+
+		/**
+		 * Constructor instantiating an automatically selected integration scheme with absolute error limit \a absErr,
+		 * relative error limit \a absRel and maximal number of integrand evaluations \a maxEval, which is unlimited if it
+		 * is 0, using about \a probeEval of them to probe the integrand. At least 3 probe evaluations per integration
+		 * variable are used.
+		 */
+		AutoAlgorithm (double absErr, double relErr, std::size_t maxEval, std::size_t probeEval = 256);
+
+		Algorithm::Result run (const InternalIntegrand& func, std::size_t dimInt, const double* argsFix) const;
+
+		Algorithm::Result run_batch (const InternalBatchIntegrand& func, std::size_t dimInt, const double* argsFix) const;
+
+		bool is_parallelized () const;
+
+		AutoAlgorithm* clone () const;
+
+		/**
+		 * Stores the points \a givenPoints to pass them on to the selected backend. If any are given, the integrand is
+		 * treated as peaked.
+		 */
+		void set_given_points (const std::vector<double>& givenPoints);
+
+		/**
+		 * Returns the Backend the AutoAlgorithm selects for an integrand with the Features \a features and \a dimInt
+		 * integration variables, given that \a numProbeEval integrand evaluations have already been used for probing and
+		 * the infinite bounds passed via Algorithm::set_infinite_bounds.
+		 */
+		Backend select_backend (const Features& features, std::size_t dimInt, std::size_t numProbeEval) const;
+
+		/**
+		 * Returns the name of the integration algorithm class corresponding to the Backend \a backend.
+		 */
+		static std::string backend_name (Backend backend);
+
+		/**
+		 * Removes the cached Features of all integrands, e.g. after their identifiers have been reused for different
+		 * integrands, such that all following integrations probe the integrand again.
+		 */
+		static void clear_cache ();
+
+	private:
+		/**
+		 * Returns the Features of the Algorithm::InternalBatchIntegrand \a func with fixed arguments \a argsFix and \a dimInt
+		 * integration variables, either from the cache or by probing it, in which case the number of probe evaluations
+		 * is written to \a numProbeEval.
+		 */
+		Features features (const InternalBatchIntegrand& func, std::size_t dimInt, const double* argsFix, std::size_t& numProbeEval) const;
+
+		/**
+		 * Evaluates the Algorithm::InternalBatchIntegrand \a func with fixed arguments \a argsFix and \a dimInt integration
+		 * variables at the probe points, writes their number to \a numProbeEval, and returns the resulting Features.
+		 */
+		Features probe (const InternalBatchIntegrand& func, std::size_t dimInt, const double* argsFix, std::size_t& numProbeEval) const;
+
+		/**
+		 * Estimates the magnitude of the Algorithm::InternalBatchIntegrand \a func with fixed arguments \a argsFix and
+		 * \a dimInt integration variables from its values at the first points of the low-discrepancy sequence, writes it to
+		 * AutoAlgorithm::Features::Mean and AutoAlgorithm::Features::Deviation of \a features, and writes the number of
+		 * evaluations to \a numProbeEval.
+		 */
+		void estimate_magnitude (const InternalBatchIntegrand& func, std::size_t dimInt, const double* argsFix, std::size_t& numProbeEval, Features& features) const;
+
+		/**
+		 * Returns the first \a numPoints points of the low-discrepancy sequence in \a dimInt dimensions used for probing,
+		 * which keep the distance \a step from the faces of the unit hypercube, concatenated into a single vector.
+		 */
+		static std::vector<double> sequence_points (std::size_t dimInt, std::size_t numPoints, double step);
+
+		/**
+		 * Returns the number of integrand evaluations the Backend \a backend is predicted to need for an integrand with the
+		 * Features \a features and \a dimInt integration variables.
+		 */
+		double predicted_evaluations (Backend backend, const Features& features, std::size_t dimInt) const;
+
+		/**
+		 * Dynamically creates the integration algorithm corresponding to the Backend \a backend with the error limits of
+		 * this AutoAlgorithm and the maximal number of integrand evaluations \a maxEval, which is unlimited if it is 0.
+		 */
+		std::unique_ptr<Algorithm> create_backend (Backend backend, std::size_t maxEval) const;
+
+		/**
+		 * Prepares the integration by determining the Features of the Algorithm::InternalBatchIntegrand \a func with fixed
+		 * arguments \a argsFix and \a dimInt integration variables and creating the selected backend, which is written to
+		 * \a backend. Returns an Algorithm::Result that is marked as failed if the probing already exhausted the maximal
+		 * number of integrand evaluations.
+		 */
+		Algorithm::Result prepare_backend (const InternalBatchIntegrand& func, std::size_t dimInt, const double* argsFix, std::unique_ptr<Algorithm>& backend, Backend& selectedBackend) const;
+
+		/**
+		 * Adds the name of the selected Backend \a selectedBackend to the comment of the Algorithm::Result \a integral if
+		 * it failed, and returns it.
+		 */
+		static Algorithm::Result annotate (Algorithm::Result integral, Backend selectedBackend);
+
+		/**
+		 * Returns the cache of the scale-free Features, with the identifier of the Integrator, the number of integration
+		 * variables and the type of the integration bounds as key, which is shared by all instances of AutoAlgorithm.
+		 */
+		static std::map<std::string, Features>& feature_cache ();
+
+		/**
+		 * Returns the mutex guarding the cache of the Features.
+		 */
+		static std::mutex& feature_cache_mutex ();
+
+		/**
+		 * Maximal number of integrand evaluations, which is unlimited if this is 0.
+		 */
+		std::size_t MaxEval;
+
+		/**
+		 * Number of integrand evaluations used for probing.
+		 */
+		std::size_t ProbeEval;
+
+		/**
+		 * Points passed on to the selected backend via Algorithm::set_given_points.
+		 */
+		std::vector<double> GivenPoints;
+	};
+}
+
+#endif
@@ -0,0 +1,29 @@
+#include "CancellationToken.hpp"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::CancellationToken::CancellationToken () :
+	Cancelled(std::make_shared<std::atomic<bool>>(false))
+{}
+
+void MultiDimInt::CancellationToken::cancel () const
+{
+	Cancelled->store(true);
+}
+
+void MultiDimInt::CancellationToken::reset () const
+{
+	Cancelled->store(false);
+}
+
+bool MultiDimInt::CancellationToken::is_cancelled () const
+{
+	return Cancelled->load(std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
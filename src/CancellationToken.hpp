@@ -0,0 +1,48 @@
+#ifndef MULTIDIMINT_CANCELLATION_TOKEN_H
+#define MULTIDIMINT_CANCELLATION_TOKEN_H
+
+#include <atomic>
+#include <memory>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class implementing a flag that cooperatively cancels running integrations.
+	 *
+	 * All copies of a CancellationToken share the same flag, so a token handed to an Integrator via
+	 * Integrator::set_cancellation_token can be cancelled from any other thread, e.g. by a request handler whose client
+	 * has gone away. The integration algorithms check the flag between their iterations, like a Deadline, and return
+	 * their estimate so far once it is set.
+	 */
+	class CancellationToken
+	{
+	public:
+		/**
+		 * Constructor instantiating a new token that is not cancelled.
+		 */
+		CancellationToken ();
+
+		/**
+		 * Cancels all integrations using this token or any of its copies. This can be called from any thread.
+		 */
+		void cancel () const;
+
+		/**
+		 * Resets the token, such that later integrations using it run normally again.
+		 */
+		void reset () const;
+
+		/**
+		 * Returns \c true if the token has been cancelled.
+		 */
+		bool is_cancelled () const;
+
+	private:
+		/**
+		 * Flag shared by all copies of the token.
+		 */
+		std::shared_ptr<std::atomic<bool>> Cancelled;
+	};
+}
+
+#endif
@@ -0,0 +1,99 @@
+#include "ClenshawCurtisTable.hpp"
+
+#include <cmath>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+constexpr std::size_t MultiDimInt::ClenshawCurtisTable::MaxLevel;
+
+const MultiDimInt::ClenshawCurtisTable& MultiDimInt::ClenshawCurtisTable::shared ()
+{
+	static const ClenshawCurtisTable table;	// the initialization of local static variables is thread-safe
+
+	return table;
+}
+
+std::size_t MultiDimInt::ClenshawCurtisTable::number_of_nodes (const std::size_t level) const
+{
+	return Nodes[level].size();
+}
+
+double MultiDimInt::ClenshawCurtisTable::node (const std::size_t level, const std::size_t i_node) const
+{
+	return Nodes[level][i_node];
+}
+
+double MultiDimInt::ClenshawCurtisTable::weight (const std::size_t level, const std::size_t i_node) const
+{
+	return Weights[level][i_node];
+}
+
+std::size_t MultiDimInt::ClenshawCurtisTable::fine_index (const std::size_t level, const std::size_t i_node) const
+{
+	if ( level == 0 )	// the midpoint
+	{
+		return std::size_t(1) << (MaxLevel - 1);
+	}
+
+	return i_node << (MaxLevel - level);
+}
+
+double MultiDimInt::ClenshawCurtisTable::weight_at_fine_index (const std::size_t level, const std::size_t fineIndex) const
+{
+	if ( level == 0 )
+	{
+		return (fineIndex == fine_index(0, 0)) ? Weights[0][0] : 0.0;
+	}
+
+	const std::size_t stride = std::size_t(1) << (MaxLevel - level);
+
+	return (fineIndex % stride == 0) ? Weights[level][fineIndex / stride] : 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
+
+MultiDimInt::ClenshawCurtisTable::ClenshawCurtisTable () :
+	Nodes(MaxLevel + 1),
+	Weights(MaxLevel + 1)
+{
+	Nodes[0] = {0.5};
+	Weights[0] = {1.0};
+
+	for ( std::size_t level = 1; level <= MaxLevel; ++level )
+	{
+		const std::size_t numIntervals = std::size_t(1) << level;
+
+		std::vector<double> cosines (2 * numIntervals);	// cos(m*pi/numIntervals) for all m needed below
+
+		for ( std::size_t m = 0; m < 2 * numIntervals; ++m )
+		{
+			cosines[m] = std::cos(M_PI * m / numIntervals);
+		}
+
+		Nodes[level].resize(numIntervals + 1);
+		Weights[level].resize(numIntervals + 1);
+
+		for ( std::size_t k = 0; k <= numIntervals; ++k )
+		{
+			Nodes[level][k] = 0.5 * (1.0 - cosines[k]);
+
+			double sum = 1.0;
+
+			for ( std::size_t j = 1; j <= numIntervals / 2; ++j )
+			{
+				const double factor = (j == numIntervals / 2) ? 1.0 : 2.0;
+
+				sum -= factor / (4.0 * j * j - 1.0) * cosines[(2 * j * k) % (2 * numIntervals)];
+			}
+
+			const double factor = (k == 0 || k == numIntervals) ? 1.0 : 2.0;
+
+			Weights[level][k] = 0.5 * factor / numIntervals * sum;	// the factor 0.5 normalizes the rule from (-1, 1) to the unit interval
+		}
+	}
+}
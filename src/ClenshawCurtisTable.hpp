@@ -0,0 +1,86 @@
+#ifndef MULTIDIMINT_CLENSHAW_CURTIS_TABLE_H
+#define MULTIDIMINT_CLENSHAW_CURTIS_TABLE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class holding the nodes and weights of the nested Clenshaw-Curtis rules on the unit interval.
+	 *
+	 * The rule of level 0 consists of the midpoint only, while the rule of level l > 0 has the 2^l+1 nodes (1-cos(k*pi/2^l))/2
+	 * with k = 0..2^l. As each rule contains all nodes of the rules of lower levels, every node can be identified by its
+	 * index on the finest grid of level ClenshawCurtisTable::MaxLevel, independently of the level it is used at.
+	 *
+	 * There is only one table, which is computed when it is first accessed via ClenshawCurtisTable::shared and never modified
+	 * afterwards, so it can be read by any number of threads and integrations at once.
+	 */
+	class ClenshawCurtisTable
+	{
+	public:
+		/**
+		 * Highest level of the tabulated rules.
+		 */
+		static constexpr std::size_t MaxLevel = 12;
+
+		/**
+		 * Returns the shared table, computing it on the first call.
+		 */
+		static const ClenshawCurtisTable& shared ();
+
+		/**
+		 * Returns the number of nodes of the rule of level \a level.
+		 */
+		std::size_t number_of_nodes (std::size_t level) const;
+
+		/**
+		 * Returns the node with index \a i_node of the rule of level \a level.
+		 */
+		double node (std::size_t level, std::size_t i_node) const;
+
+		/**
+		 * Returns the weight of the node with index \a i_node of the rule of level \a level.
+		 */
+		double weight (std::size_t level, std::size_t i_node) const;
+
+		/**
+		 * Returns the index on the finest grid of the node with index \a i_node of the rule of level \a level.
+		 */
+		std::size_t fine_index (std::size_t level, std::size_t i_node) const;
+
+		/**
+		 * Returns the weight of the rule of level \a level for the node with index \a fineIndex on the finest grid, which
+		 * is 0 if the node does not belong to that rule.
+		 */
+		double weight_at_fine_index (std::size_t level, std::size_t fineIndex) const;
+
+		/**
+		 * Deleted copy-constructor, as there shall only be the shared table.
+		 */
+		ClenshawCurtisTable (const ClenshawCurtisTable& otherTable) = delete;
+
+		/**
+		 * Deleted assignment operator, as there shall only be the shared table.
+		 */
+		ClenshawCurtisTable& operator= (const ClenshawCurtisTable& otherTable) = delete;
+
+	private:
+		/**
+		 * Constructor computing the nodes and weights of the rules of all levels up to ClenshawCurtisTable::MaxLevel.
+		 */
+		ClenshawCurtisTable ();
+
+		/**
+		 * Nodes of the rules of all levels.
+		 */
+		std::vector<std::vector<double>> Nodes;
+
+		/**
+		 * Weights of the rules of all levels, normalized to the unit interval.
+		 */
+		std::vector<std::vector<double>> Weights;
+	};
+}
+
+#endif
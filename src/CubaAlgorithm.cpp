@@ -1,9 +1,19 @@
 #include "CubaAlgorithm.hpp"
 
+#include "Tracepoints.hpp"
+
+#include <cctype>
 #include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+
+#include <cuba.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // public
@@ -23,12 +33,30 @@ MultiDimInt::Algorithm::Result MultiDimInt::CubaAlgorithm::run (const InternalIn
 	
 	CubaData cubaData(func, argsFix);
 	
+	cubaData.Spin = Spin;
+	cubaData.Statefile = CheckpointDirectory.empty() ? Statefile : checkpoint_file(dimInt, argsFix);
+	
 	bool integrationSucceeded;		// if the integration succeeds, this is set to 'true', otherwise to 'false'
 	double prob;					// chi^2 probability that the estimated error is not a reliable estimate of the true integration error
 	std::string furtherComment("");	// if the integration fails, an additional comment may be written to this string
 	
+	if ( ThreadBatchSize > 0 )
+	{
+		begin_thread_mode(ThreadBatchSize);
+	}
+	
 	integrationSucceeded = cuba_integration(static_cast<int>(dimInt), cubaData, integral.Value, integral.Error, prob, furtherComment);
 	
+	if ( ThreadBatchSize > 0 )
+	{
+		end_thread_mode();
+	}
+	
+	if ( integrationSucceeded && (not CheckpointDirectory.empty()) )	// Cuba keeps the state file if bit 4 of the flags is set, from which later integrations would resume
+	{
+		std::remove(cubaData.Statefile.c_str());
+	}
+	
 	if ( not integrationSucceeded )	// if integration failed, write Cuba error message, the value of 'prob', and 'furtherComment' into 'integral.Comment'
 	{
 		integral.Failed = true;
@@ -50,6 +78,68 @@ bool MultiDimInt::CubaAlgorithm::is_parallelized () const
   return true;	// all Cuba integration algorithms parallelize the sampling of the integrand
 }
 
+void MultiDimInt::CubaAlgorithm::set_number_of_cores (const int numCores, const int numPointsPerCore)
+{
+	if ( numCores < 0 )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::CubaAlgorithm Error: Number of cores is negative" << std::endl
+				  << std::endl;
+		
+		exit(EXIT_FAILURE);
+	}
+	
+	if ( numPointsPerCore <= 0 )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::CubaAlgorithm Error: Number of points per core is not positive" << std::endl
+				  << std::endl;
+		
+		exit(EXIT_FAILURE);
+	}
+	
+	std::lock_guard<std::mutex> lock (CoresMutex);
+	
+	NumCores = numCores;
+	NumPointsPerCore = numPointsPerCore;
+	
+	if ( NumThreadModeIntegrations == 0 )	// otherwise, the setting is applied by the last integration in the thread mode
+	{
+		apply_number_of_cores();
+	}
+}
+
+void MultiDimInt::CubaAlgorithm::set_thread_mode (const bool useThreadMode, const int batchSize)
+{
+	if ( not useThreadMode )
+	{
+		ThreadBatchSize = 0;
+		
+		return;
+	}
+	
+	if ( batchSize <= 0 )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::CubaAlgorithm Error: Batch size of the thread mode is not positive" << std::endl
+				  << std::endl;
+		
+		exit(EXIT_FAILURE);
+	}
+	
+	ThreadBatchSize = batchSize;
+}
+
+bool MultiDimInt::CubaAlgorithm::uses_thread_mode () const
+{
+	return (ThreadBatchSize > 0);
+}
+
+void MultiDimInt::CubaAlgorithm::set_checkpointing (const std::string& directory)
+{
+	CheckpointDirectory = directory;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // protected
 
@@ -59,7 +149,9 @@ MultiDimInt::CubaAlgorithm::CubaAlgorithm (const double absErr, const double rel
 	Flags(0),
 	Mineval(0),
 	Statefile(),
-	Spin(NULL)
+	Spin(NULL),
+	ThreadBatchSize(0),
+	CheckpointDirectory()
 {
 	if ( MaxEval <= 0 )
 	{
@@ -78,7 +170,9 @@ MultiDimInt::CubaAlgorithm::CubaAlgorithm (const double absErr, const double rel
 	Flags(flags),
 	Mineval(mineval),
 	Statefile(statefile),
-	Spin(spin)
+	Spin(spin),
+	ThreadBatchSize(0),
+	CheckpointDirectory()
 {
 	if ( MaxEval <= 0 )
 	{
@@ -108,14 +202,127 @@ MultiDimInt::CubaAlgorithm::CubaAlgorithm (const double absErr, const double rel
 	}
 }
 
-int MultiDimInt::CubaAlgorithm::cuba_integrand (const int* dimInt, const double* argsInt, const int* ncomp, double* result, void* cubaData)
+int MultiDimInt::CubaAlgorithm::cuba_integrand (const int* dimInt, const double* argsInt, const int* ncomp, double* result, void* cubaData, const int* nvec)
 {
 	CubaData* data = (CubaData*) cubaData;
 	
-	result[0] = data->Func(data->ArgsFix, argsInt);	// evaluate integrand
+	if ( *nvec == 1 )
+	{
+		result[0] = data->Func(data->ArgsFix, argsInt);	// evaluate integrand
+		
+		return 0;
+	}
+	
+	MULTIDIMINT_TRACEPOINT1(cuba__batch__start, *nvec);
+	
+	#pragma omp parallel for schedule(dynamic)	// in the thread mode, evaluate the whole batch in parallel
+	for ( int i_point = 0; i_point < *nvec; ++i_point )
+	{
+		result[i_point] = data->Func(data->ArgsFix, &argsInt[i_point * (*dimInt)]);
+	}
+	
+	MULTIDIMINT_TRACEPOINT1(cuba__batch__done, *nvec);
 	
 	return 0;
 }
 
+int MultiDimInt::CubaAlgorithm::batch_size () const
+{
+	return (ThreadBatchSize > 0) ? ThreadBatchSize : 1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-// private
\ No newline at end of file
+// private
+
+int MultiDimInt::CubaAlgorithm::NumCores = -1;
+
+int MultiDimInt::CubaAlgorithm::NumPointsPerCore = -1;
+
+int MultiDimInt::CubaAlgorithm::NumThreadModeIntegrations = 0;
+
+std::mutex MultiDimInt::CubaAlgorithm::CoresMutex;
+
+void MultiDimInt::CubaAlgorithm::begin_thread_mode (const int batchSize)
+{
+	std::lock_guard<std::mutex> lock (CoresMutex);
+	
+	if ( NumThreadModeIntegrations++ == 0 )
+	{
+		cubacores(0, batchSize);	// evaluate all points in the main process
+	}
+}
+
+void MultiDimInt::CubaAlgorithm::end_thread_mode ()
+{
+	std::lock_guard<std::mutex> lock (CoresMutex);
+	
+	if ( --NumThreadModeIntegrations == 0 )
+	{
+		apply_number_of_cores();
+	}
+}
+
+void MultiDimInt::CubaAlgorithm::apply_number_of_cores ()
+{
+	if ( NumCores >= 0 )
+	{
+		cubacores(NumCores, NumPointsPerCore);
+		
+		return;
+	}
+	
+	const char* numCoresVariable = std::getenv("CUBACORES");	// Cuba has no way to query its setting, so its default is derived in the same way
+	const char* numPointsPerCoreVariable = std::getenv("CUBACORESMAX");
+	
+	const int numCores = (numCoresVariable != NULL) ? std::atoi(numCoresVariable) : static_cast<int>(std::thread::hardware_concurrency());
+	const int numPointsPerCore = (numPointsPerCoreVariable != NULL) ? std::atoi(numPointsPerCoreVariable) : 10000;
+	
+	cubacores(numCores, numPointsPerCore);
+}
+
+std::string MultiDimInt::CubaAlgorithm::checkpoint_file (const std::size_t dimInt, const double* argsFix) const
+{
+	if ( IntegrationContext.Identifier.empty() )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::CubaAlgorithm Error: Checkpointing requires the Integrator to have a non-empty identifier" << std::endl
+				  << std::endl;
+		
+		exit(EXIT_FAILURE);
+	}
+	
+	std::uint64_t hash = 14695981039346656037ULL;	// 64-bit FNV-1a hash of the number of integration variables and the bit patterns of the fixed arguments
+	
+	auto hash_bytes = [&hash] (const void* data, const std::size_t numBytes)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		
+		for ( std::size_t i = 0; i < numBytes; ++i )
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ULL;
+		}
+	};
+	
+	hash_bytes(&dimInt, sizeof(dimInt));
+	
+	if ( argsFix != NULL )
+	{
+		hash_bytes(argsFix, IntegrationContext.DimFix * sizeof(double));
+	}
+	
+	std::string identifier = IntegrationContext.Identifier;	// replace all characters that might not be allowed in file names
+	
+	for ( char& character : identifier )
+	{
+		if ( not std::isalnum(static_cast<unsigned char>(character)) && (character != '-') && (character != '_') )
+		{
+			character = '_';
+		}
+	}
+	
+	std::stringstream fileName;
+	fileName << CheckpointDirectory << "/" << identifier << "_" << std::hex << hash << ".state";
+	
+	return fileName.str();
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "Algorithm.hpp"
 
+#include <mutex>
 #include <string>
 
 namespace MultiDimInt
@@ -24,6 +25,47 @@ namespace MultiDimInt
 		
 		virtual CubaAlgorithm* clone () const = 0;
 		
+		/**
+		 * Sets the number of worker processes used by all Cuba integration routines to \a numCores and the maximal
+		 * number of points sent to a worker at once to \a numPointsPerCore, replacing the environment variables
+		 * \c CUBACORES and \c CUBACORESMAX. If \a numCores is 0, the integrand is evaluated in the main process only
+		 * and no workers are forked at all. While integrations in the thread mode are running, the new setting only takes
+		 * effect after the last of them has finished.
+		 */
+		static void set_number_of_cores (int numCores, int numPointsPerCore);
+		
+		/**
+		 * Switches the thread mode on or off, depending on \a useThreadMode. In the thread mode, Cuba passes batches of
+		 * up to \a batchSize points to the integrand, which are evaluated in parallel by the OpenMP threads of the main
+		 * process instead of by forked worker processes. The integrand then works on truly shared memory, such that it can
+		 * e.g. update shared caches (taking care of the synchronization itself) or keep per-thread caches in \c thread_local
+		 * variables, and no time is spent on forking.
+		 * 
+		 * As Cuba provides no way to disable the forking for a single integration, the number of Cuba worker processes is
+		 * set to zero for all Cuba algorithms of the process while integrations in the thread mode are running. Afterwards,
+		 * the setting of CubaAlgorithm::set_number_of_cores is restored or, if it has never been called, the default
+		 * derived from \c CUBACORES and \c CUBACORESMAX (or the number of cores of the machine).
+		 */
+		void set_thread_mode (bool useThreadMode, int batchSize = 1000);
+		
+		/**
+		 * Returns whether the thread mode is switched on, see CubaAlgorithm::set_thread_mode.
+		 */
+		bool uses_thread_mode () const;
+		
+		/**
+		 * Switches checkpointing on, storing the state files in the existing directory \a directory, or off if \a directory
+		 * is empty. The state of the integration is then saved by Cuba after each iteration in a state file whose name is
+		 * derived from the identifier of the Integrator using this Algorithm and from the fixed arguments of the integrand.
+		 * If an integration is interrupted, e.g. because the job is preempted, repeating it in a new process resumes it from
+		 * the saved state, which gives bitwise identical results to an uninterrupted run. The state file is removed as soon
+		 * as the integration succeeds, even if bit 4 of the flags tells Cuba to keep it.
+		 * 
+		 * To get unique file names, all Integrator objects using checkpointing need distinct, non-empty identifiers. The
+		 * automatic state files replace the one passed to the constructor (or to CubaVegasAlgorithm::set_grid_file).
+		 */
+		void set_checkpointing (const std::string& directory);
+		
 	protected:
 		/**
 		 * Constructor instantiating an integration scheme using some algorithm of the Cuba library with absolute error
@@ -60,11 +102,15 @@ namespace MultiDimInt
 		{
 			CubaData (const InternalIntegrand& func, const double* argsFix) :
 				Func(func),
-				ArgsFix(argsFix)
+				ArgsFix(argsFix),
+				Spin(NULL),
+				Statefile()
 			{};
 			
 			const InternalIntegrand& Func;
 			const double* ArgsFix;
+			void* Spin;				// spin handle to be passed to the Cuba integration routine
+			std::string Statefile;	// name of the state file to be passed to the Cuba integration routine
 		};
 		
 		/**
@@ -82,9 +128,19 @@ namespace MultiDimInt
 		 * all information needed by the integrand has to be provided via the \c void pointer \a cubaData, since static
 		 * methods cannot access the non-public members of their class. \a dimInt is the number of integration variables
 		 * gathered in \a argsInt, \a ncomp is the number of components of the integrand (always 1 in MultiDimInt::Function),
-		 * and the value of the integral is written into \a value.
+		 * and the value of the integral is written into \a value. In the thread mode, \a argsInt and \a value contain a batch
+		 * of \a nvec points, which are evaluated in parallel.
+		 * 
+		 * As it takes the additional argument \a nvec passed by Cuba, it has to be cast to \c integrand_t when passed to
+		 * the Cuba integration routines.
 		 */
-		static int cuba_integrand (const int* dimInt, const double* argsInt, const int* ncomp, double* value, void* cubaData);
+		static int cuba_integrand (const int* dimInt, const double* argsInt, const int* ncomp, double* value, void* cubaData, const int* nvec);
+		
+		/**
+		 * Returns the maximal number of points Cuba passes to CubaAlgorithm::cuba_integrand at once, which is 1 unless
+		 * the thread mode is switched on.
+		 */
+		int batch_size () const;
 		
 		/**
 		 * Maximal number of integrand evaluations.
@@ -97,6 +153,51 @@ namespace MultiDimInt
 		std::string Statefile;
 		void* Spin;
 		int Key;
+		
+		/**
+		 * Maximal number of points evaluated at once in the thread mode, which is switched off if this is 0.
+		 */
+		int ThreadBatchSize;
+		
+		/**
+		 * Directory the state files are stored in if checkpointing is switched on, and empty otherwise.
+		 */
+		std::string CheckpointDirectory;
+		
+	private:
+		/**
+		 * Sets the number of Cuba worker processes to zero for an integration in the thread mode with batches of
+		 * \a batchSize points, if no other integration in the thread mode is running.
+		 */
+		static void begin_thread_mode (int batchSize);
+		
+		/**
+		 * Restores the number of Cuba worker processes after an integration in the thread mode, if it was the last one
+		 * running.
+		 */
+		static void end_thread_mode ();
+		
+		/**
+		 * Passes the number of worker processes set by CubaAlgorithm::set_number_of_cores, or the default if it has never
+		 * been called, to Cuba.
+		 */
+		static void apply_number_of_cores ();
+		
+		/**
+		 * Number of worker processes and maximal number of points per worker set by CubaAlgorithm::set_number_of_cores,
+		 * or -1 if it has never been called, the number of integrations in the thread mode currently running, and the
+		 * mutex guarding them.
+		 */
+		static int NumCores;
+		static int NumPointsPerCore;
+		static int NumThreadModeIntegrations;
+		static std::mutex CoresMutex;
+		
+		/**
+		 * Returns the name of the state file used by the checkpointing for an integrand with \a dimInt integration variables
+		 * and fixed arguments \a argsFix. It consists of the identifier of the Integrator and a hash of the fixed arguments.
+		 */
+		std::string checkpoint_file (std::size_t dimInt, const double* argsFix) const;
 	};
 }
 
@@ -31,21 +31,23 @@ MultiDimInt::CubaCuhreAlgorithm* MultiDimInt::CubaCuhreAlgorithm::clone () const
 bool MultiDimInt::CubaCuhreAlgorithm::cuba_integration (const int dimInt, CubaData& cubaData, double& value, double& error, double& prob, std::string& furtherComment) const
 {
 	const int ncomp = 1;	// number of components of the integrand (always 1 in MultiDimInt::Function)
-	const int nvec = 1;		// number of integration points sampled at the same time (always 1 in MultiDimInt::Function)
+	const int nvec = batch_size();	// number of integration points sampled at the same time (1 unless the thread mode is switched on)
 	
 	int nregions;	// actual number of subregions needed (will not be used)
-	int neval;		// actual number of integrand evaluations needed (will not be used)
+	int neval;		// actual number of integrand evaluations needed (reported as the progress)
 	int fail;		// Cuba error code
 	
 	Cuhre(dimInt, ncomp,
-		  &cuba_integrand, &cubaData, nvec,
+		  reinterpret_cast<integrand_t>(&cuba_integrand), &cubaData, nvec,
 		  RelErr, AbsErr,
 		  Flags,
 		  Mineval, MaxEval,
-		  Key, Statefile.c_str(), Spin,
+		  Key, cubaData.Statefile.c_str(), cubaData.Spin,
 		  &nregions, &neval, &fail,
 		  &value, &error, &prob);
 	
+	report_progress(value, error, neval);
+	
 	if ( fail == 0 )	// if integration succeeded, return 'true'
 	{
 		return true;
@@ -1,5 +1,7 @@
 #include "CubaDivonneAlgorithm.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -22,7 +24,10 @@ MultiDimInt::CubaDivonneAlgorithm::CubaDivonneAlgorithm (const double absErr, co
 	Ngiven(0),
 	Xgiven(),
 	Nextra(0),
-	Peakfinder(NULL)
+	Peakfinder(NULL),
+	GivenPoints(),
+	NumFeedForwardPeaks(0),
+	Peaks()
 {}
 
 MultiDimInt::CubaDivonneAlgorithm::CubaDivonneAlgorithm (const double absErr, const double relErr, const int maxEval,
@@ -41,7 +46,10 @@ MultiDimInt::CubaDivonneAlgorithm::CubaDivonneAlgorithm (const double absErr, co
 	Ngiven(ngiven),
 	Xgiven(xgiven),
 	Nextra(nextra),
-	Peakfinder(peakfinder)
+	Peakfinder(peakfinder),
+	GivenPoints(),
+	NumFeedForwardPeaks(0),
+	Peaks()
 {
 	if ( Seed < 0 )
 	{
@@ -112,34 +120,105 @@ MultiDimInt::CubaDivonneAlgorithm* MultiDimInt::CubaDivonneAlgorithm::clone () c
 	return new CubaDivonneAlgorithm(*this);
 }
 
+void MultiDimInt::CubaDivonneAlgorithm::set_given_points (const std::vector<double>& givenPoints)
+{
+	GivenPoints = givenPoints;
+}
+
+void MultiDimInt::CubaDivonneAlgorithm::set_peak_feed_forward (const int numPeaks)
+{
+	if ( numPeaks < 0 )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::CubaDivonneAlgorithm Error: Number of feed-forward peaks is negative" << std::endl
+				  << std::endl;
+		
+		exit(EXIT_FAILURE);
+	}
+	
+	NumFeedForwardPeaks = numPeaks;
+	
+	if ( NumFeedForwardPeaks == 0 )
+	{
+		Peaks.reset();
+	}
+	else if ( not Peaks )
+	{
+		Peaks = std::make_shared<PeakMemory>();
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // protected
 
 bool MultiDimInt::CubaDivonneAlgorithm::cuba_integration (const int dimInt, CubaData& cubaData, double& value, double& error, double& prob, std::string& furtherComment) const
 {
 	const int ncomp = 1;	// number of components of the integrand (always 1 in MultiDimInt::Function)
-	const int nvec = 1;		// number of integration points sampled at the same time (always 1 in MultiDimInt::Function)
+	const int nvec = batch_size();	// number of integration points sampled at the same time (1 unless the thread mode is switched on)
 	
-	const int ldxgiven = dimInt;	// offset between one point and the next in the array 'Xgiven' (always assumed to be given by 'dimInt', i.e. the dimension of a sample point)
+	const int ldxgiven = dimInt;	// offset between one point and the next in the array 'xgiven' (always assumed to be given by 'dimInt', i.e. the dimension of a sample point)
+	
+	std::vector<double> xgiven (Xgiven.begin(), Xgiven.begin() + std::min(Xgiven.size(), static_cast<std::size_t>(Ngiven * dimInt)));	// gather the points given to the constructor, the ones passed by the Integrator and the remembered peaks
+	
+	xgiven.insert(xgiven.end(), GivenPoints.begin(), GivenPoints.end());
+	
+	if ( Peaks )
+	{
+		std::lock_guard<std::mutex> lock (Peaks->Mutex);
+		
+		if ( Peaks->DimInt == static_cast<std::size_t>(dimInt) )
+		{
+			xgiven.insert(xgiven.end(), Peaks->Points.begin(), Peaks->Points.end());
+		}
+	}
+	
+	const int ngiven = xgiven.size() / dimInt;
+	
+	PeakMemory recordedPeaks;	// peaks of this integration, which are only merged into the shared ones at the end, as copies of this Algorithm may be used concurrently
+	
+	recordedPeaks.DimInt = dimInt;
+	
+	const InternalIntegrand recordingFunc = [this, &cubaData, &recordedPeaks, dimInt] (const double* argsFix, const double* argsInt)	// integrand offering each of its values to the feed-forward
+	{
+		const double value = cubaData.Func(argsFix, argsInt);
+		
+		record_peak(recordedPeaks, dimInt, argsInt, value);
+		
+		return value;
+	};
+	
+	CubaData recordingData (recordingFunc, cubaData.ArgsFix);
+	
+	recordingData.Spin = cubaData.Spin;
+	recordingData.Statefile = cubaData.Statefile;
+	
+	CubaData& integrandData = Peaks ? recordingData : cubaData;
 	
 	int nregions;	// actual number of subregions needed (will not be used)
-	int neval;		// actual number of integrand evaluations needed (will not be used)
+	int neval;		// actual number of integrand evaluations needed (reported as the progress)
 	int fail;		// Cuba error code
 	
 	Divonne(dimInt, ncomp,
-			&cuba_integrand, &cubaData, nvec,
+			reinterpret_cast<integrand_t>(&cuba_integrand), &integrandData, nvec,
 			RelErr, AbsErr,
 			Flags, Seed,
 			Mineval, MaxEval,
 			Key1, Key2, Key3,
 			Maxpass, Border,
 			Maxchisq, Mindeviation,
-			Ngiven, ldxgiven, const_cast<double*>(Xgiven.data()),
+			ngiven, ldxgiven, xgiven.data(),
 			Nextra, Peakfinder,
-			Statefile.c_str(), Spin,
+			cubaData.Statefile.c_str(), cubaData.Spin,
 			&nregions, &neval, &fail,
 			&value, &error, &prob);
 	
+	report_progress(value, error, neval);
+	
+	if ( Peaks )
+	{
+		remember_peaks(recordedPeaks, dimInt);
+	}
+	
 	if ( fail == 0 )	// if integration succeeded, return 'true'
 	{
 		return true;
@@ -154,4 +233,101 @@ bool MultiDimInt::CubaDivonneAlgorithm::cuba_integration (const int dimInt, Cuba
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-// private
\ No newline at end of file
+// private
+
+void MultiDimInt::CubaDivonneAlgorithm::record_peak (PeakMemory& peaks, const std::size_t dimInt, const double* argsInt, const double value) const
+{
+	const double absValue = std::abs(value);
+	
+	if ( not (absValue > peaks.Threshold) )	// most integrand values are too small to matter, which is checked without locking (and also discards NaN values)
+	{
+		return;
+	}
+	
+	std::lock_guard<std::mutex> lock (peaks.Mutex);
+	
+	const std::size_t numPeaks = peaks.Values.size();
+	
+	std::size_t i_replaced = numPeaks;	// index of the remembered peak to be replaced, or 'numPeaks' if the point is added as a new peak
+	
+	for ( std::size_t i_peak = 0; i_peak < numPeaks; ++i_peak )	// look for a remembered peak close to the point
+	{
+		double distance = 0.0;
+		
+		for ( std::size_t i = 0; i < dimInt; ++i )
+		{
+			distance = std::max(distance, std::abs(peaks.Points[i_peak * dimInt + i] - argsInt[i]));
+		}
+		
+		if ( distance < 0.05 )
+		{
+			if ( absValue <= peaks.Values[i_peak] )	// the point belongs to a peak that is already remembered with a larger value
+			{
+				return;
+			}
+			
+			i_replaced = i_peak;
+			
+			break;
+		}
+	}
+	
+	if ( (i_replaced == numPeaks) && (numPeaks == static_cast<std::size_t>(NumFeedForwardPeaks)) )	// if the point is a new peak but the memory is full, replace the smallest remembered peak
+	{
+		i_replaced = std::min_element(peaks.Values.begin(), peaks.Values.end()) - peaks.Values.begin();
+	}
+	
+	if ( i_replaced == numPeaks )
+	{
+		peaks.Points.insert(peaks.Points.end(), argsInt, argsInt + dimInt);
+		peaks.Values.push_back(absValue);
+	}
+	else
+	{
+		std::copy(argsInt, argsInt + dimInt, peaks.Points.begin() + i_replaced * dimInt);
+		peaks.Values[i_replaced] = absValue;
+	}
+	
+	if ( peaks.Values.size() == static_cast<std::size_t>(NumFeedForwardPeaks) )	// once the memory is full, only values larger than the smallest remembered one can change it
+	{
+		peaks.Threshold = *std::min_element(peaks.Values.begin(), peaks.Values.end());
+	}
+}
+
+void MultiDimInt::CubaDivonneAlgorithm::remember_peaks (const PeakMemory& peaks, const std::size_t dimInt) const
+{
+	std::lock_guard<std::mutex> lock (Peaks->Mutex);
+	
+	std::vector<double> points (peaks.Points);
+	std::vector<double> values (peaks.Values);
+	
+	if ( Peaks->DimInt == dimInt )	// keep the previously remembered peaks that are not close to a new one as long as there is room for them
+	{
+		for ( std::size_t i_peak = 0; (i_peak < Peaks->Values.size()) && (values.size() < static_cast<std::size_t>(NumFeedForwardPeaks)); ++i_peak )
+		{
+			bool close = false;
+			
+			for ( std::size_t i_new = 0; (i_new < peaks.Values.size()) && not close; ++i_new )
+			{
+				double distance = 0.0;
+				
+				for ( std::size_t i = 0; i < dimInt; ++i )
+				{
+					distance = std::max(distance, std::abs(Peaks->Points[i_peak * dimInt + i] - peaks.Points[i_new * dimInt + i]));
+				}
+				
+				close = (distance < 0.05);
+			}
+			
+			if ( not close )
+			{
+				points.insert(points.end(), Peaks->Points.begin() + i_peak * dimInt, Peaks->Points.begin() + (i_peak + 1) * dimInt);
+				values.push_back(Peaks->Values[i_peak]);
+			}
+		}
+	}
+	
+	Peaks->DimInt = dimInt;
+	Peaks->Points.swap(points);
+	Peaks->Values.swap(values);
+}
\ No newline at end of file
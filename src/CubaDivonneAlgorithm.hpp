@@ -3,6 +3,9 @@
 
 #include "CubaAlgorithm.hpp"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -74,6 +77,25 @@ namespace MultiDimInt
 		
 		CubaDivonneAlgorithm* clone () const;
 		
+		void set_given_points (const std::vector<double>& givenPoints);
+		
+		/**
+		 * Switches the feed-forward of peaks on, remembering the \a numPeaks points with the largest absolute integrand
+		 * values found during each integration, or off if \a numPeaks is 0. The remembered points are passed to the next
+		 * integration as additional given points (see the Cuba parameter \a xgiven), such that Divonne can start its
+		 * partitioning from the peaks found before, which is useful if many similar integrals are performed, e.g. for
+		 * slowly varying fixed arguments. Points closer to each other than 0.05 in every unit hypercube coordinate are
+		 * counted as the same peak. The remembered points are shared by this Algorithm and all its copies. Each integration
+		 * records its peaks separately and, when it has finished, replaces the remembered points by them, filled up with
+		 * the previously remembered ones that are not close to any of them, such that concurrent integrations do not
+		 * discard each other's peaks.
+		 * 
+		 * Note that only integrand evaluations in the main process can be observed, whereas those done by Cuba worker
+		 * processes are lost. For the feed-forward to see all evaluations, either the thread mode has to be switched on
+		 * or the number of workers has to be set to zero (see CubaAlgorithm::set_thread_mode and CubaAlgorithm::set_number_of_cores).
+		 */
+		void set_peak_feed_forward (int numPeaks);
+		
 	protected:
 		bool cuba_integration (int dimInt, CubaData& cubaData, double& value, double& error, double& prob, std::string& furtherComment) const;
 		
@@ -91,6 +113,58 @@ namespace MultiDimInt
 		std::vector<double> Xgiven;
 		int Nextra;
 		peakfinder_t Peakfinder;
+		
+		/**
+		 * Points on the unit hypercube passed by the Integrator via CubaDivonneAlgorithm::set_given_points, which are
+		 * sampled in addition to the ones in CubaDivonneAlgorithm::Xgiven.
+		 */
+		std::vector<double> GivenPoints;
+		
+		/**
+		 * Maximal number of peaks remembered by the feed-forward, which is switched off if this is 0.
+		 */
+		int NumFeedForwardPeaks;
+		
+		/**
+		 * Structure holding peaks of the feed-forward. \a Points contains the \a DimInt coordinates of each peak and
+		 * \a Values the corresponding absolute integrand values. While the peaks of an integration are recorded, only
+		 * integrand values larger than \a Threshold can change them, which avoids locking \a Mutex for most integrand
+		 * evaluations.
+		 */
+		struct PeakMemory
+		{
+			PeakMemory () :
+				Mutex(),
+				DimInt(0),
+				Points(),
+				Values(),
+				Threshold(0.0)
+			{};
+			
+			std::mutex Mutex;
+			std::size_t DimInt;
+			std::vector<double> Points;
+			std::vector<double> Values;
+			std::atomic<double> Threshold;
+		};
+		
+		/**
+		 * Peaks shared by this Algorithm and all its copies, or an empty pointer if the feed-forward is switched off.
+		 */
+		std::shared_ptr<PeakMemory> Peaks;
+		
+		/**
+		 * Offers the point \a argsInt with \a dimInt coordinates and integrand value \a value to the peaks \a peaks
+		 * recorded by an integration. It is called concurrently in the thread mode.
+		 */
+		void record_peak (PeakMemory& peaks, std::size_t dimInt, const double* argsInt, double value) const;
+		
+		/**
+		 * Replaces the peaks remembered in CubaDivonneAlgorithm::Peaks by the peaks \a peaks recorded by an integration
+		 * with \a dimInt integration variables, filled up with the previously remembered ones that are not close to any
+		 * of them.
+		 */
+		void remember_peaks (const PeakMemory& peaks, std::size_t dimInt) const;
 	};
 }
 
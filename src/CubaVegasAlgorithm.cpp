@@ -15,7 +15,9 @@ MultiDimInt::CubaVegasAlgorithm::CubaVegasAlgorithm (const double absErr, const
 	Nstart(1000),
 	Nincrease(500),
 	Nbatch(1000),
-	Gridno(0)
+	Gridno(0),
+	GridFile(),
+	Slot()
 {}
 
 MultiDimInt::CubaVegasAlgorithm::CubaVegasAlgorithm (const double absErr, const double relErr, const int maxEval,
@@ -27,7 +29,9 @@ MultiDimInt::CubaVegasAlgorithm::CubaVegasAlgorithm (const double absErr, const
 	Nstart(nstart),
 	Nincrease(nincrease),
 	Nbatch(nbatch),
-	Gridno(gridno)
+	Gridno(gridno),
+	GridFile(),
+	Slot()
 {
 	if ( Seed < 0 )
 	{
@@ -80,27 +84,81 @@ MultiDimInt::CubaVegasAlgorithm* MultiDimInt::CubaVegasAlgorithm::clone () const
 	return new CubaVegasAlgorithm(*this);
 }
 
+void MultiDimInt::CubaVegasAlgorithm::set_grid_cache (const bool useGridCache)
+{
+	if ( not useGridCache )
+	{
+		Gridno = 0;
+		Slot.reset();	// the slot is released as soon as no other copy shares it anymore
+		
+		return;
+	}
+	
+	if ( (Gridno != 0) || Slot )	// keep a slot that has been chosen explicitly or assigned before
+	{
+		Gridno = std::abs(Gridno);
+		
+		return;
+	}
+	
+	std::lock_guard<std::mutex> lock (GridSlotsMutex);
+	
+	for ( int i_slot = 0; i_slot < 10; ++i_slot )
+	{
+		if ( not GridSlotsUsed[i_slot] )
+		{
+			GridSlotsUsed[i_slot] = true;
+			
+			Slot = std::make_shared<GridSlot>(i_slot + 1);	// Cuba counts the slots from 1
+			
+			return;
+		}
+	}
+	
+	std::cout << std::endl
+			  << " MultiDimInt::CubaVegasAlgorithm Error: All 10 grid slots of the Cuba library are in use" << std::endl
+			  << std::endl;
+	
+	exit(EXIT_FAILURE);
+}
+
+void MultiDimInt::CubaVegasAlgorithm::set_grid_file (const std::string& gridFile)
+{
+	GridFile = gridFile;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // protected
 
 bool MultiDimInt::CubaVegasAlgorithm::cuba_integration (const int dimInt, CubaData& cubaData, double& value, double& error, double& prob, std::string& furtherComment) const
 {
 	const int ncomp = 1;	// number of components of the integrand (always 1 in MultiDimInt::Function)
-	const int nvec = 1;		// number of integration points sampled at the same time (always 1 in MultiDimInt::Function)
+	const int nvec = batch_size();	// number of integration points sampled at the same time (1 unless the thread mode is switched on)
 	
-	int neval;	// actual number of integrand evaluations needed (will not be used)
+	int neval;	// actual number of integrand evaluations needed (reported as the progress)
 	int fail;	// Cuba error code
 	
+	int flags = Flags;
+	std::string statefile = cubaData.Statefile;
+	
+	if ( CheckpointDirectory.empty() && not GridFile.empty() )	// retain the grid file (bit 4) and only reuse the grid stored in it (bit 5), which must not affect the state files of the checkpointing
+	{
+		flags |= 16 | 32;
+		statefile = GridFile;
+	}
+	
 	Vegas(dimInt, ncomp,
-		  &cuba_integrand, &cubaData, nvec,
+		  reinterpret_cast<integrand_t>(&cuba_integrand), &cubaData, nvec,
 		  RelErr, AbsErr,
-		  Flags, Seed,
+		  flags, Seed,
 		  Mineval, MaxEval,
 		  Nstart, Nincrease, Nbatch,
-		  Gridno, Statefile.c_str(), Spin,
+		  grid_number(), statefile.c_str(), cubaData.Spin,
 		  &neval, &fail,
 		  &value, &error, &prob);
 	
+	report_progress(value, error, neval);
+	
 	if ( fail == 0 )	// if integration succeeded, return 'true'
 	{
 		return true;
@@ -112,4 +170,35 @@ bool MultiDimInt::CubaVegasAlgorithm::cuba_integration (const int dimInt, CubaDa
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-// private
\ No newline at end of file
+// private
+
+bool MultiDimInt::CubaVegasAlgorithm::GridSlotsUsed[10] = {false, false, false, false, false, false, false, false, false, false};
+
+std::mutex MultiDimInt::CubaVegasAlgorithm::GridSlotsMutex;
+
+MultiDimInt::CubaVegasAlgorithm::GridSlot::GridSlot (const int number) :
+	Number(number),
+	Clear(true)
+{}
+
+MultiDimInt::CubaVegasAlgorithm::GridSlot::~GridSlot ()
+{
+	std::lock_guard<std::mutex> lock (GridSlotsMutex);
+	
+	GridSlotsUsed[Number - 1] = false;
+}
+
+int MultiDimInt::CubaVegasAlgorithm::grid_number () const
+{
+	if ( not Slot )
+	{
+		return Gridno;
+	}
+	
+	if ( Slot->Clear.exchange(false) )	// a negative slot number makes Cuba clear the grid left in the slot by its previous owner before using it
+	{
+		return -Slot->Number;
+	}
+	
+	return Slot->Number;
+}
\ No newline at end of file
@@ -3,6 +3,9 @@
 
 #include "CubaAlgorithm.hpp"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 
 namespace MultiDimInt
@@ -54,6 +57,29 @@ namespace MultiDimInt
 		
 		CubaVegasAlgorithm* clone () const;
 		
+		/**
+		 * Switches the grid cache on or off, depending on \a useGridCache. If it is switched on, the grid adapted during
+		 * an integration is stored in one of the internal grid slots of the Cuba library and used as the starting grid of
+		 * the next integration with the same number of integration variables, instead of training a new grid from scratch.
+		 * Unless a slot has already been chosen via the \a gridno constructor argument, a free slot is assigned automatically.
+		 * Copies of this algorithm share the slot, which is released again when the cache is switched off or the last of
+		 * them is destroyed, and is cleared before its first integration after being assigned.
+		 * 
+		 * Note that the Cuba library only provides 10 grid slots per process, so at most 10 algorithms (not counting their
+		 * copies) can use the grid cache at the same time.
+		 */
+		void set_grid_cache (bool useGridCache);
+		
+		/**
+		 * Stores the grid in the file \a gridFile, such that it can be exported to and imported from other runs. This
+		 * uses the Cuba state file mechanism: the state file is kept after a successful integration (\a flags bit 4),
+		 * and at the start of an integration only the grid is read from it, while the rest of the integrator's state
+		 * is reset (\a flags bit 5). These flags are only set for the grid file, not for the state files of
+		 * CubaAlgorithm::set_checkpointing, which take precedence over the grid file. Passing an empty string stops using
+		 * the file.
+		 */
+		void set_grid_file (const std::string& gridFile);
+		
 	protected:
 		bool cuba_integration (int dimInt, CubaData& cubaData, double& value, double& error, double& prob, std::string& furtherComment) const;
 		
@@ -64,6 +90,44 @@ namespace MultiDimInt
 		int Nincrease;
 		int Nbatch;
 		int Gridno;
+		
+		/**
+		 * File the grid is stored in, see CubaVegasAlgorithm::set_grid_file, or an empty string if no such file is used.
+		 */
+		std::string GridFile;
+		
+		/**
+		 * Structure holding an internal grid slot of the Cuba library assigned by CubaVegasAlgorithm::set_grid_cache,
+		 * which releases the slot when it is destroyed. \a Clear is \c true until the slot has been cleared at the start
+		 * of its first integration.
+		 */
+		struct GridSlot
+		{
+			GridSlot (int number);
+			
+			~GridSlot ();
+			
+			int Number;
+			std::atomic<bool> Clear;
+		};
+		
+		/**
+		 * Grid slot assigned automatically and shared by this Algorithm and all its copies, or an empty pointer if the
+		 * grid cache is switched off or the slot has been chosen explicitly.
+		 */
+		std::shared_ptr<GridSlot> Slot;
+		
+		/**
+		 * Returns the \a gridno parameter to be passed to the next integration.
+		 */
+		int grid_number () const;
+		
+		/**
+		 * Whether each of the internal grid slots of the Cuba library is currently assigned by
+		 * CubaVegasAlgorithm::set_grid_cache, and the mutex guarding them.
+		 */
+		static bool GridSlotsUsed[10];
+		static std::mutex GridSlotsMutex;
 	};
 }
 
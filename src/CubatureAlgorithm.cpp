@@ -8,6 +8,37 @@
 // public
 
 MultiDimInt::Algorithm::Result MultiDimInt::CubatureAlgorithm::run(const InternalIntegrand &func, const std::size_t dimInt, const double *argsFix) const
+{
+	return integrate(func, NULL, dimInt, argsFix);
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::CubatureAlgorithm::run_batch(const InternalBatchIntegrand &func, const std::size_t dimInt, const double *argsFix) const
+{
+	const InternalIntegrand pointwiseFunc = [&func](const double *argsFix, const double *argsInt) // needed by the scalar Cubature routines and the parallelized evaluation
+	{
+		double value;
+
+		func(argsFix, 1, argsInt, &value);
+
+		return value;
+	};
+
+	return integrate(pointwiseFunc, &func, dimInt, argsFix);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+MultiDimInt::CubatureAlgorithm::CubatureAlgorithm(const double absErr, const double relErr, const std::size_t maxEval)
+	: Algorithm(absErr, relErr),
+	  MaxEval(maxEval)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
+
+MultiDimInt::Algorithm::Result MultiDimInt::CubatureAlgorithm::integrate(const InternalIntegrand &func, const InternalBatchIntegrand *batchFunc, const std::size_t dimInt, const double *argsFix) const
 {
 	if (dimInt > INT_MAX) // Cubature algorithms only accept an 'unsigned' as the number of integration variables, not a potentially larger 'size_t'; in practice 'dimInt' will of course never exceed the largest possible 'unsigned' value, but explicitly checking this won't hurt
 	{
@@ -20,7 +51,7 @@ MultiDimInt::Algorithm::Result MultiDimInt::CubatureAlgorithm::run(const Interna
 
 	Algorithm::Result integral = {false, 0.0, 0.0, ""};
 
-	CubatureData cubatureData(func, argsFix);
+	CubatureData cubatureData(func, argsFix, this, batchFunc);
 
 	bool integrationSucceeded;		// if the integration succeeds, this is set to 'true', otherwise to 'false'
 	std::string furtherComment(""); // if the integration fails, an additional comment may be written to this string
@@ -35,16 +66,4 @@ MultiDimInt::Algorithm::Result MultiDimInt::CubatureAlgorithm::run(const Interna
 	}
 
 	return integral;
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-// protected
-
-MultiDimInt::CubatureAlgorithm::CubatureAlgorithm(const double absErr, const double relErr, const std::size_t maxEval)
-	: Algorithm(absErr, relErr),
-	  MaxEval(maxEval)
-{
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-// private
\ No newline at end of file
+}
\ No newline at end of file
@@ -21,6 +21,8 @@ namespace MultiDimInt
 	public:
 		Algorithm::Result run(const InternalIntegrand &func, std::size_t dimInt, const double *argsFix) const;
 
+		Algorithm::Result run_batch(const InternalBatchIntegrand &func, std::size_t dimInt, const double *argsFix) const;
+
 		virtual bool is_parallelized() const = 0;
 
 		virtual CubatureAlgorithm *clone() const = 0;
@@ -35,15 +37,22 @@ namespace MultiDimInt
 		/**
 		 * Structure gathering all information needed by CubatureAlgorithm::cubature_integration and
 		 * CubatureAlgorithm::cubature_integrand. \a Func is the Algorithm::InternalIntegrand to be integrated for fixed
-		 * arguments \a ArgsFix.
+		 * arguments \a ArgsFix, and \a ThisCubatureAlgorithm points to the CubatureAlgorithm performing the integration,
+		 * giving the static integrand access to its settings. If the integration was started by CubatureAlgorithm::run_batch,
+		 * \a BatchFunc points to the Algorithm::InternalBatchIntegrand that \a Func evaluates point by point, and it is
+		 * \c NULL otherwise.
 		 */
 		struct CubatureData
 		{
-			CubatureData(const InternalIntegrand &func, const double *argsFix) : Func(func),
-																				 ArgsFix(argsFix){};
+			CubatureData(const InternalIntegrand &func, const double *argsFix, const CubatureAlgorithm *thisCubatureAlgorithm, const InternalBatchIntegrand *batchFunc = NULL) : Func(func),
+																																										  ArgsFix(argsFix),
+																																										  ThisCubatureAlgorithm(thisCubatureAlgorithm),
+																																										  BatchFunc(batchFunc){};
 
 			const InternalIntegrand &Func;
 			const double *ArgsFix;
+			const CubatureAlgorithm *ThisCubatureAlgorithm;
+			const InternalBatchIntegrand *BatchFunc;
 		};
 
 		/**
@@ -59,6 +68,14 @@ namespace MultiDimInt
 		 * Maximal number of integrand evaluations.
 		 */
 		int MaxEval;
+
+	private:
+		/**
+		 * Performs the integration shared by CubatureAlgorithm::run and CubatureAlgorithm::run_batch of the
+		 * Algorithm::InternalIntegrand \a func, which evaluates the Algorithm::InternalBatchIntegrand \a batchFunc point
+		 * by point if \a batchFunc is not \c NULL, and returns the resulting Algorithm::Result.
+		 */
+		Algorithm::Result integrate(const InternalIntegrand &func, const InternalBatchIntegrand *batchFunc, std::size_t dimInt, const double *argsFix) const;
 	};
 }
 
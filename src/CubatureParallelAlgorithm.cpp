@@ -1,5 +1,13 @@
 #include "CubatureParallelAlgorithm.hpp"
 
+#include "Tracepoints.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <omp.h>
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // public
 
@@ -8,26 +16,161 @@ bool MultiDimInt::CubatureParallelAlgorithm::is_parallelized() const
 	return true; // all vectorised Cubature integration algorithms are used to parallelize the sampling of the integrand
 }
 
+void MultiDimInt::CubatureParallelAlgorithm::set_schedule(const Schedule schedule, const int chunkSize)
+{
+	if (chunkSize < 0)
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::CubatureParallelAlgorithm Error: Chunk size is negative" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+
+	SchedulePolicy = schedule;
+	ChunkSize = chunkSize;
+}
+
+void MultiDimInt::CubatureParallelAlgorithm::set_min_batch_size(const std::size_t minBatchSize)
+{
+	MinBatchSize = minBatchSize;
+}
+
+void MultiDimInt::CubatureParallelAlgorithm::set_number_of_threads(const int numThreads)
+{
+	if (numThreads < 0)
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::CubatureParallelAlgorithm Error: Number of threads is negative" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+
+	NumThreads = numThreads;
+}
+
+void MultiDimInt::CubatureParallelAlgorithm::set_timing(const bool useTiming)
+{
+	std::lock_guard<std::mutex> lock(Timing->Mutex);
+
+	if (useTiming)
+	{
+		Timing->Statistics = TimingStatistics{0, 0, 0.0, 0.0, 0.0};
+	}
+
+	Timing->Enabled.store(useTiming);
+}
+
+MultiDimInt::CubatureParallelAlgorithm::TimingStatistics MultiDimInt::CubatureParallelAlgorithm::timing_statistics() const
+{
+	std::lock_guard<std::mutex> lock(Timing->Mutex);
+
+	return Timing->Statistics;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // protected
 
 MultiDimInt::CubatureParallelAlgorithm::CubatureParallelAlgorithm(const double absErr, const double relErr, const std::size_t maxEval)
-	: CubatureAlgorithm(absErr, relErr, maxEval)
+	: CubatureAlgorithm(absErr, relErr, maxEval),
+	  SchedulePolicy(Schedule::Static),
+	  ChunkSize(0),
+	  MinBatchSize(1),
+	  NumThreads(0),
+	  Timing(std::make_shared<TimingState>())
 {
+	Timing->Enabled.store(false);
+	Timing->Statistics = TimingStatistics{0, 0, 0.0, 0.0, 0.0};
 }
 
 int MultiDimInt::CubatureParallelAlgorithm::cubature_integrand(const unsigned dimInt, const std::size_t numPoints, const double *argsInt, void *cubatureData, const unsigned dimFunc, double *result)
 {
 	CubatureData *data = (CubatureData *)cubatureData;
 
-#pragma omp parallel for schedule(static) // call the integrand for all points in parallel
-	for (std::size_t i_point = 0; i_point < numPoints; ++i_point)
+	const CubatureParallelAlgorithm *algorithm = static_cast<const CubatureParallelAlgorithm *>(data->ThisCubatureAlgorithm);
+
+	omp_sched_t previousSchedule; // the loop below uses the runtime schedule, so the one of the calling thread is replaced temporarily
+	int previousChunkSize;
+
+	omp_get_schedule(&previousSchedule, &previousChunkSize);
+
+	switch (algorithm->SchedulePolicy)
+	{
+	case Schedule::Dynamic:
+		omp_set_schedule(omp_sched_dynamic, algorithm->ChunkSize);
+		break;
+
+	case Schedule::Guided:
+		omp_set_schedule(omp_sched_guided, algorithm->ChunkSize);
+		break;
+
+	default:
+		omp_set_schedule(omp_sched_static, algorithm->ChunkSize);
+	}
+
+	const int numThreads = (algorithm->NumThreads > 0) ? algorithm->NumThreads : omp_get_max_threads();
+
+	std::vector<double> busyTimes(numThreads, 0.0); // time each thread spends evaluating the integrand
+	int numThreadsUsed = 1;
+
+	MULTIDIMINT_TRACEPOINT1(cubature__batch__start, numPoints);
+
+	const double startTime = omp_get_wtime();
+
+#pragma omp parallel num_threads(numThreads) if (numPoints >= algorithm->MinBatchSize) // call the integrand for all points in parallel
+	{
+		const double threadStartTime = omp_get_wtime();
+
+#pragma omp for schedule(runtime) nowait
+		for (std::size_t i_point = 0; i_point < numPoints; ++i_point)
+		{
+			result[i_point] = data->Func(data->ArgsFix, &argsInt[i_point * dimInt]); // evaluate integrand
+		}
+
+		busyTimes[omp_get_thread_num()] = omp_get_wtime() - threadStartTime;
+
+#pragma omp master
+		numThreadsUsed = omp_get_num_threads();
+	}
+
+	const double wallTime = omp_get_wtime() - startTime;
+
+	omp_set_schedule(previousSchedule, previousChunkSize);
+
+	MULTIDIMINT_TRACEPOINT1(cubature__batch__done, numPoints);
+
+	if (algorithm->Timing->Enabled.load(std::memory_order_relaxed))
 	{
-		result[i_point] = data->Func(data->ArgsFix, &argsInt[i_point * dimInt]); // evaluate integrand
+		algorithm->record_batch(numPoints, wallTime, busyTimes, numThreadsUsed);
 	}
 
 	return 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-// private
\ No newline at end of file
+// private
+
+void MultiDimInt::CubatureParallelAlgorithm::record_batch(const std::size_t numPoints, const double wallTime, const std::vector<double> &busyTimes, const int numThreads) const
+{
+	double maxBusyTime = 0.0;
+	double meanBusyTime = 0.0;
+
+	for (int i_thread = 0; i_thread < numThreads; ++i_thread)
+	{
+		maxBusyTime = std::max(maxBusyTime, busyTimes[i_thread]);
+		meanBusyTime += busyTimes[i_thread] / numThreads;
+	}
+
+	const double loadImbalance = (meanBusyTime > 0.0) ? maxBusyTime / meanBusyTime : 1.0;
+
+	std::lock_guard<std::mutex> lock(Timing->Mutex); // the same Algorithm and its copies may be used by several threads at once
+
+	TimingStatistics &statistics = Timing->Statistics;
+
+	++statistics.NumBatches;
+	statistics.NumPoints += numPoints;
+	statistics.WallTime += wallTime;
+	statistics.MeanLoadImbalance += (loadImbalance - statistics.MeanLoadImbalance) / statistics.NumBatches;
+	statistics.MaxLoadImbalance = std::max(statistics.MaxLoadImbalance, loadImbalance);
+}
\ No newline at end of file
@@ -3,7 +3,11 @@
 
 #include "CubatureAlgorithm.hpp"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace MultiDimInt
 {
@@ -19,10 +23,70 @@ namespace MultiDimInt
 	class CubatureParallelAlgorithm : public CubatureAlgorithm
 	{
 	public:
+		/**
+		 * OpenMP scheduling policies that can be used to distribute the points of a batch among the threads.
+		 */
+		enum class Schedule
+		{
+			Static,
+			Dynamic,
+			Guided
+		};
+
+		/**
+		 * Structure containing timing statistics of the evaluated batches. \a NumBatches is the number of batches, \a NumPoints
+		 * the total number of points in them and \a WallTime the total wall time spent evaluating them. The load imbalance
+		 * of a batch is the ratio of the longest time a thread spent evaluating the integrand to the mean time over all
+		 * threads, which is 1 for a perfectly balanced batch. \a MeanLoadImbalance and \a MaxLoadImbalance are its mean
+		 * and its maximum over all batches.
+		 */
+		struct TimingStatistics
+		{
+			std::size_t NumBatches;
+			std::size_t NumPoints;
+			double WallTime;
+			double MeanLoadImbalance;
+			double MaxLoadImbalance;
+		};
+
 		bool is_parallelized() const;
 
 		virtual CubatureParallelAlgorithm *clone() const = 0;
 
+		/**
+		 * Sets the OpenMP scheduling policy \a schedule and chunk size \a chunkSize used to distribute the points of a
+		 * batch among the threads. If \a chunkSize is 0, the OpenMP default of the respective policy is used. Dynamic or
+		 * guided scheduling balances the load if the cost of the integrand varies strongly across the integration region.
+		 * The default is static scheduling with the default chunk size.
+		 */
+		void set_schedule(Schedule schedule, int chunkSize = 0);
+
+		/**
+		 * Sets the minimal number of points \a minBatchSize a batch needs to have to be evaluated in parallel. Smaller
+		 * batches are evaluated by the calling thread alone, avoiding the overhead of starting a parallel region. The
+		 * default is 1.
+		 */
+		void set_min_batch_size(std::size_t minBatchSize);
+
+		/**
+		 * Sets the number of threads \a numThreads used to evaluate a batch. If \a numThreads is 0, the OpenMP default
+		 * is used, which is also the default.
+		 */
+		void set_number_of_threads(int numThreads);
+
+		/**
+		 * Switches the timing of the batches on or off, depending on \a useTiming. Switching it on resets the statistics
+		 * returned by CubatureParallelAlgorithm::timing_statistics. The switch and the statistics are shared by all copies
+		 * of this Algorithm, such that they also apply to the copy used by an Integrator it has been passed to.
+		 */
+		void set_timing(bool useTiming);
+
+		/**
+		 * Returns the timing statistics of all batches evaluated by this Algorithm and its copies since the timing was
+		 * switched on.
+		 */
+		TimingStatistics timing_statistics() const;
+
 	protected:
 		/**
 		 * Constructor instantiating a parallel integration scheme using some vectorised algorithm of the Cubature
@@ -43,6 +107,49 @@ namespace MultiDimInt
 		 * parallel, and the value of the integral is written into \a value.
 		 */
 		static int cubature_integrand(unsigned dimInt, std::size_t numPoints, const double *argsInt, void *cubatureData, unsigned dimFunc, double *value);
+
+		/**
+		 * OpenMP scheduling policy used to distribute the points of a batch among the threads.
+		 */
+		Schedule SchedulePolicy;
+
+		/**
+		 * Chunk size of the OpenMP scheduling policy, where 0 denotes the default of the policy.
+		 */
+		int ChunkSize;
+
+		/**
+		 * Minimal number of points of a batch to be evaluated in parallel.
+		 */
+		std::size_t MinBatchSize;
+
+		/**
+		 * Number of threads used to evaluate a batch, where 0 denotes the OpenMP default.
+		 */
+		int NumThreads;
+
+	private:
+		/**
+		 * Structure containing the switch \a Enabled of the timing, the \a Statistics of the timed batches and the \a Mutex
+		 * guarding them.
+		 */
+		struct TimingState
+		{
+			std::atomic<bool> Enabled;
+			TimingStatistics Statistics;
+			std::mutex Mutex;
+		};
+
+		/**
+		 * Timing switch and statistics shared by all copies of this Algorithm, which may be used by several threads at once.
+		 */
+		std::shared_ptr<TimingState> Timing;
+
+		/**
+		 * Adds a batch of \a numPoints points evaluated in the wall time \a wallTime to the statistics in CubatureParallelAlgorithm::Timing,
+		 * where the first \a numThreads entries of \a busyTimes are the times the threads spent evaluating the integrand.
+		 */
+		void record_batch(std::size_t numPoints, double wallTime, const std::vector<double> &busyTimes, int numThreads) const;
 	};
 }
 
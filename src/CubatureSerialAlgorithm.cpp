@@ -1,5 +1,7 @@
 #include "CubatureSerialAlgorithm.hpp"
 
+#include "Tracepoints.hpp"
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // public
 
@@ -25,5 +27,18 @@ int MultiDimInt::CubatureSerialAlgorithm::cubature_integrand(const unsigned dimI
 	return 0;
 }
 
+int MultiDimInt::CubatureSerialAlgorithm::cubature_batch_integrand(const unsigned dimInt, const std::size_t numPoints, const double *argsInt, void *cubatureData, const unsigned dimFunc, double *result)
+{
+	CubatureData *data = (CubatureData *)cubatureData;
+
+	MULTIDIMINT_TRACEPOINT1(cubature__batch__start, numPoints);
+
+	(*data->BatchFunc)(data->ArgsFix, numPoints, argsInt, result); // evaluate integrand for the whole batch at once
+
+	MULTIDIMINT_TRACEPOINT1(cubature__batch__done, numPoints);
+
+	return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // private
\ No newline at end of file
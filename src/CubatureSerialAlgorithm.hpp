@@ -26,7 +26,8 @@ namespace MultiDimInt
 		/**
 		 * Constructor instantiating a serial integration scheme using some non-vectorised algorithm of the Cubature
 		 * library with absolute error limit \a absErr, relative error limit \a absRel and maximal number of integrand
-		 * evaluations \a maxEval.
+		 * evaluations \a maxEval. If it is started by CubatureAlgorithm::run_batch, the vectorised variant of the
+		 * algorithm is used instead, still on a single thread, with CubatureSerialAlgorithm::cubature_batch_integrand.
 		 */
 		CubatureSerialAlgorithm(double absErr, double relErr, std::size_t maxEval);
 
@@ -41,6 +42,15 @@ namespace MultiDimInt
 		 * integrand (always 1 in MultiDimInt::Function), and the value of the integral is written into \a value.
 		 */
 		static int cubature_integrand(unsigned dimInt, const double *argsInt, void *cubatureData, unsigned dimFunc, double *value);
+
+		/**
+		 * Wrapper for the Algorithm::InternalBatchIntegrand pointed to by CubatureAlgorithm::CubatureData::BatchFunc that
+		 * provides the form of the integrand expected by vectorized Cubature integration routines. In contrast to
+		 * CubatureParallelAlgorithm::cubature_integrand, it hands the whole batch of \a numPoints points gathered in
+		 * \a argsInt to the batch integrand in a single call on the calling thread, such that the integrand can exploit
+		 * SIMD instructions without spawning further threads, e.g. inside an already parallelized outer loop.
+		 */
+		static int cubature_batch_integrand(unsigned dimInt, std::size_t numPoints, const double *argsInt, void *cubatureData, unsigned dimFunc, double *value);
 	};
 }
 
@@ -27,11 +27,24 @@ bool MultiDimInt::CubatureSerialPAdaptiveAlgorithm::cubature_integration(const u
 	std::vector<double> lowerBound(dimInt, 0.0); // this must not be const, as pcubature expects the integration boundaries as arrays of non-const double values
 	std::vector<double> upperBound(dimInt, 1.0);
 
-	int fail = pcubature(dimFunc, &cubature_integrand, &cubatureData,
+	int fail;
+
+	if (cubatureData.BatchFunc != NULL) // hand the batches of the vectorised routine to the batch integrand on this thread
+	{
+		fail = pcubature_v(dimFunc, &cubature_batch_integrand, &cubatureData,
+						   dimInt, lowerBound.data(), upperBound.data(),
+						   MaxEval, AbsErr, RelErr,
+						   ERROR_INDIVIDUAL, // placeholder value, since the error norm argument is ignored for integrands with only 1 component
+						   &value, &error);
+	}
+	else
+	{
+		fail = pcubature(dimFunc, &cubature_integrand, &cubatureData,
 						 dimInt, lowerBound.data(), upperBound.data(),
 						 MaxEval, AbsErr, RelErr,
 						 ERROR_INDIVIDUAL, // placeholder value, since the error norm argument is ignored for integrands with only 1 component
 						 &value, &error);
+	}
 
 	if (fail == 0) // if integration succeeded, return 'true'
 	{
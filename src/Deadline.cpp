@@ -0,0 +1,43 @@
+#include "Deadline.hpp"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::Deadline::Deadline () :
+	Timed(false),
+	EndTime(),
+	Token(),
+	Outer()
+{}
+
+MultiDimInt::Deadline::Deadline (const CancellationToken& token) :
+	Timed(false),
+	EndTime(),
+	Token(token),
+	Outer()
+{}
+
+MultiDimInt::Deadline::Deadline (const double timeLimit, const CancellationToken& token) :
+	Timed(true),
+	EndTime(std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeLimit))),
+	Token(token),
+	Outer()
+{}
+
+MultiDimInt::Deadline::Deadline (const Deadline& deadline, const CancellationToken& token) :
+	Timed(false),
+	EndTime(),
+	Token(token),
+	Outer(std::make_shared<const Deadline>(deadline))
+{}
+
+bool MultiDimInt::Deadline::is_reached () const
+{
+	return Token.is_cancelled() || (Timed && (std::chrono::steady_clock::now() >= EndTime)) || (Outer && Outer->is_reached());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
@@ -0,0 +1,73 @@
+#ifndef MULTIDIMINT_DEADLINE_H
+#define MULTIDIMINT_DEADLINE_H
+
+#include "CancellationToken.hpp"
+
+#include <chrono>
+#include <memory>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class describing the point at which a running integration has to stop.
+	 *
+	 * A Deadline is reached once a given wall-clock time has passed or its CancellationToken has been cancelled. It is
+	 * passed to the integration algorithms as part of their Algorithm::Context, and all algorithms that iterate
+	 * themselves check it between their iterations. Once it is reached, they stop and return their estimate so far with
+	 * Algorithm::Result::DeadlineReached set, instead of failing. Algorithms that leave the iterations to an external
+	 * library, i.e. the Cuba, Cubature and GSL nested algorithms, finish their run regardless.
+	 */
+	class Deadline
+	{
+	public:
+		/**
+		 * Constructor instantiating a deadline that is never reached.
+		 */
+		Deadline ();
+
+		/**
+		 * Constructor instantiating a deadline that is reached as soon as \a token is cancelled.
+		 */
+		explicit Deadline (const CancellationToken& token);
+
+		/**
+		 * Constructor instantiating a deadline that is reached \a timeLimit seconds from now, or as soon as \a token is
+		 * cancelled, whatever happens first.
+		 */
+		Deadline (double timeLimit, const CancellationToken& token);
+
+		/**
+		 * Constructor instantiating a deadline that is reached as soon as \a deadline is reached or \a token is
+		 * cancelled, whatever happens first. This lets a part of an integration be stopped on its own.
+		 */
+		Deadline (const Deadline& deadline, const CancellationToken& token);
+
+		/**
+		 * Returns \c true if the deadline has been reached.
+		 */
+		bool is_reached () const;
+
+	private:
+		/**
+		 * Whether the deadline has a time limit at all.
+		 */
+		bool Timed;
+
+		/**
+		 * Point in time at which the deadline is reached, if it has a time limit.
+		 */
+		std::chrono::steady_clock::time_point EndTime;
+
+		/**
+		 * Token that reaches the deadline when it is cancelled.
+		 */
+		CancellationToken Token;
+
+		/**
+		 * Deadline this one has been derived from, if any, which reaches this one as well.
+		 */
+		std::shared_ptr<const Deadline> Outer;
+	};
+}
+
+#endif
@@ -0,0 +1,398 @@
+#include "DecomposedAlgorithm.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include <omp.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::DecomposedAlgorithm::DecomposedAlgorithm (const Algorithm& alg, const double absErr, const double relErr, const std::size_t numSubBoxes, const std::size_t maxRounds, const std::size_t maxEvalPerBox) :
+	Algorithm(absErr, relErr),
+	Alg(alg.clone()),
+	SubBoxes(),
+	NumSubBoxes(numSubBoxes),
+	MaxRounds(maxRounds),
+	MaxEvalPerBox(maxEvalPerBox),
+	GivenPoints()
+{}
+
+MultiDimInt::DecomposedAlgorithm::DecomposedAlgorithm (const Algorithm& alg, const double absErr, const double relErr, const std::vector<SubBox>& subBoxes, const std::size_t maxRounds, const std::size_t maxEvalPerBox) :
+	Algorithm(absErr, relErr),
+	Alg(alg.clone()),
+	SubBoxes(subBoxes),
+	NumSubBoxes(subBoxes.size()),
+	MaxRounds(maxRounds),
+	MaxEvalPerBox(maxEvalPerBox),
+	GivenPoints()
+{
+	if ( SubBoxes.empty() )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::DecomposedAlgorithm Error: No sub-boxes given" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+
+	const std::size_t dimInt = SubBoxes[0].Lower.size();
+
+	double totalVolume = 0.0;
+
+	for ( const SubBox& box : SubBoxes )
+	{
+		bool validBox = (box.Lower.size() == dimInt) && (box.Upper.size() == dimInt);
+
+		for ( std::size_t i_dim = 0; validBox && (i_dim < dimInt); ++i_dim )
+		{
+			validBox = (box.Lower[i_dim] >= 0.0) && (box.Lower[i_dim] < box.Upper[i_dim]) && (box.Upper[i_dim] <= 1.0);
+		}
+
+		if ( not validBox )
+		{
+			std::cout << std::endl
+					  << " MultiDimInt::DecomposedAlgorithm Error: Sub-box is not a non-empty part of the unit hypercube with the same dimension as all others" << std::endl
+					  << std::endl;
+
+			exit(EXIT_FAILURE);
+		}
+
+		totalVolume += volume(box);
+	}
+
+	if ( std::abs(totalVolume - 1.0) > 1e-9 )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::DecomposedAlgorithm Error: Volumes of the sub-boxes do not add up to that of the unit hypercube" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+}
+
+MultiDimInt::DecomposedAlgorithm::DecomposedAlgorithm (const DecomposedAlgorithm& otherDecomposedAlgorithm) :
+	Algorithm(otherDecomposedAlgorithm),
+	Alg(otherDecomposedAlgorithm.Alg->clone()),
+	SubBoxes(otherDecomposedAlgorithm.SubBoxes),
+	NumSubBoxes(otherDecomposedAlgorithm.NumSubBoxes),
+	MaxRounds(otherDecomposedAlgorithm.MaxRounds),
+	MaxEvalPerBox(otherDecomposedAlgorithm.MaxEvalPerBox),
+	GivenPoints(otherDecomposedAlgorithm.GivenPoints)
+{}
+
+MultiDimInt::Algorithm::Result MultiDimInt::DecomposedAlgorithm::run (const InternalIntegrand& func, const std::size_t dimInt, const double* argsFix) const
+{
+	if ( (not SubBoxes.empty()) && (SubBoxes[0].Lower.size() != dimInt) )
+	{
+		return Algorithm::Result{true, 0.0, 0.0, "	-Decomposition error: Dimension of the sub-boxes differs from the number of integration variables"};
+	}
+
+	std::vector<Part> parts;
+
+	for ( const SubBox& box : initial_sub_boxes(dimInt) )
+	{
+		parts.push_back(Part{box, Algorithm::Result{true, 0.0, 0.0, ""}, false});
+	}
+
+	std::atomic<std::size_t> numEval (0);	// integrand evaluations in all sub-boxes, only counted if the progress is monitored
+
+	const InternalIntegrand countingFunc = [&func, &numEval] (const double* argsFix, const double* argsInt)
+	{
+		numEval.fetch_add(1, std::memory_order_relaxed);
+
+		return func(argsFix, argsInt);
+	};
+
+	const InternalIntegrand& boxFunc = progress_monitored() ? countingFunc : func;
+
+	for ( std::size_t round = 0; ; ++round )
+	{
+		std::vector<std::size_t> pendingParts;	// parts that have not been integrated yet
+
+		for ( std::size_t i_part = 0; i_part < parts.size(); ++i_part )
+		{
+			if ( not parts[i_part].Integrated )
+			{
+				pendingParts.push_back(i_part);
+			}
+		}
+
+		#pragma omp parallel for schedule(dynamic, 1)
+		for ( std::size_t i_pending = 0; i_pending < pendingParts.size(); ++i_pending )
+		{
+			Part& part = parts[pendingParts[i_pending]];
+
+			Context boxContext = IntegrationContext;	// distinguish the sub-boxes, e.g. for the checkpoint files of Cuba
+
+			if ( not boxContext.Identifier.empty() )
+			{
+				boxContext.Identifier += "_" + std::to_string(round) + "_" + std::to_string(pendingParts[i_pending]);
+			}
+
+			boxContext.Monitor = nullptr;	// only the combined estimate after each round is reported
+
+			part.Integral = integrate_sub_box(boxFunc, argsFix, part.Box, AbsErr * volume(part.Box), boxContext);
+			part.Integrated = true;
+		}
+
+		Algorithm::Result integral = {false, 0.0, 0.0, ""};
+
+		std::size_t i_failed = parts.size();	// first part that failed
+		std::size_t i_largestError = 0;
+
+		for ( std::size_t i_part = 0; i_part < parts.size(); ++i_part )
+		{
+			integral.Value += parts[i_part].Integral.Value;
+			integral.Error += parts[i_part].Integral.Error;
+
+			if ( parts[i_part].Integral.Failed && (i_failed == parts.size()) )
+			{
+				i_failed = i_part;
+			}
+
+			if ( parts[i_part].Integral.Error > parts[i_largestError].Integral.Error )
+			{
+				i_largestError = i_part;
+			}
+		}
+
+		report_progress(integral.Value, integral.Error, numEval.load());
+
+		if ( (not is_finite(integral.Value)) || (not is_finite(integral.Error)) )
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-Decomposition error: Integral value is not finite";
+
+			return integral;
+		}
+
+		const double errorLimit = std::max(AbsErr, RelErr * std::abs(integral.Value));
+
+		if ( (i_failed == parts.size()) && (integral.Error <= errorLimit) )
+		{
+			return integral;
+		}
+
+		if ( deadline_reached() )	// the sub-boxes have stopped at the same deadline, so their estimates so far are combined without re-splitting
+		{
+			integral.DeadlineReached = true;
+
+			integral.Comment = "	-Decomposition: Deadline reached before meeting the error limits";
+
+			return integral;
+		}
+
+		if ( round == MaxRounds )
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-Decomposition error: Error limits not reached after the maximal number of rounds of re-splitting sub-boxes";
+
+			if ( i_failed < parts.size() )
+			{
+				integral.Comment += std::string("\n") + parts[i_failed].Integral.Comment;
+			}
+
+			return integral;
+		}
+
+		std::vector<Part> nextParts;
+
+		for ( std::size_t i_part = 0; i_part < parts.size(); ++i_part )
+		{
+			const Part& part = parts[i_part];
+
+			if ( part.Integral.Failed || (part.Integral.Error > errorLimit * volume(part.Box)) || (i_part == i_largestError) )	// re-split the parts that failed or exceed their share of the error limit, and at least the one with the largest error
+			{
+				SubBox lowerHalf, upperHalf;
+
+				bisect(part.Box, lowerHalf, upperHalf);
+
+				nextParts.push_back(Part{lowerHalf, Algorithm::Result{true, 0.0, 0.0, ""}, false});
+				nextParts.push_back(Part{upperHalf, Algorithm::Result{true, 0.0, 0.0, ""}, false});
+			}
+			else
+			{
+				nextParts.push_back(part);
+			}
+		}
+
+		parts.swap(nextParts);
+	}
+}
+
+bool MultiDimInt::DecomposedAlgorithm::is_parallelized () const
+{
+	return true;	// the sub-boxes are integrated in parallel
+}
+
+MultiDimInt::DecomposedAlgorithm* MultiDimInt::DecomposedAlgorithm::clone () const
+{
+	return new DecomposedAlgorithm(*this);
+}
+
+void MultiDimInt::DecomposedAlgorithm::set_given_points (const std::vector<double>& givenPoints)
+{
+	GivenPoints = givenPoints;
+}
+
+MultiDimInt::DecomposedAlgorithm& MultiDimInt::DecomposedAlgorithm::operator= (const DecomposedAlgorithm& otherDecomposedAlgorithm)
+{
+	Algorithm::operator=(otherDecomposedAlgorithm);	// calling the assignment operator of the base class
+
+	Alg.reset(otherDecomposedAlgorithm.Alg->clone());
+	SubBoxes = otherDecomposedAlgorithm.SubBoxes;
+	NumSubBoxes = otherDecomposedAlgorithm.NumSubBoxes;
+	MaxRounds = otherDecomposedAlgorithm.MaxRounds;
+	MaxEvalPerBox = otherDecomposedAlgorithm.MaxEvalPerBox;
+	GivenPoints = otherDecomposedAlgorithm.GivenPoints;
+
+	return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
+
+std::vector<MultiDimInt::DecomposedAlgorithm::SubBox> MultiDimInt::DecomposedAlgorithm::initial_sub_boxes (const std::size_t dimInt) const
+{
+	if ( not SubBoxes.empty() )
+	{
+		return SubBoxes;
+	}
+
+	const std::size_t numSubBoxes = (NumSubBoxes > 0) ? NumSubBoxes : static_cast<std::size_t>(omp_get_max_threads());
+
+	std::vector<SubBox> boxes (1, SubBox{std::vector<double>(dimInt, 0.0), std::vector<double>(dimInt, 1.0)});
+
+	while ( boxes.size() < numSubBoxes )	// bisect the largest sub-box
+	{
+		const std::size_t i_largest = std::max_element(boxes.begin(), boxes.end(), [] (const SubBox& box1, const SubBox& box2) { return volume(box1) < volume(box2); }) - boxes.begin();
+
+		SubBox lowerHalf, upperHalf;
+
+		bisect(boxes[i_largest], lowerHalf, upperHalf);
+
+		boxes[i_largest] = lowerHalf;
+		boxes.push_back(upperHalf);
+	}
+
+	return boxes;
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::DecomposedAlgorithm::integrate_sub_box (const InternalIntegrand& func, const double* argsFix, const SubBox& box, const double absErr, const Context& context) const
+{
+	const std::size_t dimInt = box.Lower.size();
+	const double boxVolume = volume(box);
+
+	const InternalIntegrand boxFunc = [&func, &box, dimInt, boxVolume] (const double* argsFix, const double* argsInt)	// maps the unit hypercube onto the sub-box
+	{
+		double stackPoint[16];			// avoid allocating memory for each point in up to 16 dimensions
+		std::vector<double> heapPoint;
+
+		double* point = stackPoint;
+
+		if ( dimInt > 16 )
+		{
+			heapPoint.resize(dimInt);
+
+			point = heapPoint.data();
+		}
+
+		for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )
+		{
+			point[i_dim] = box.Lower[i_dim] + (box.Upper[i_dim] - box.Lower[i_dim]) * argsInt[i_dim];
+		}
+
+		return boxVolume * func(argsFix, point);
+	};
+
+	std::unique_ptr<Algorithm> boxAlg (Alg->clone());
+
+	boxAlg->set_context(context);
+
+	std::vector<double> boxGivenPoints;	// given points inside the sub-box, mapped onto its unit hypercube
+
+	for ( std::size_t i_point = 0; (i_point + 1) * dimInt <= GivenPoints.size(); ++i_point )
+	{
+		const double* givenPoint = &GivenPoints[i_point * dimInt];
+
+		bool inside = true;
+
+		for ( std::size_t i_dim = 0; inside && (i_dim < dimInt); ++i_dim )
+		{
+			inside = (givenPoint[i_dim] >= box.Lower[i_dim]) && (givenPoint[i_dim] <= box.Upper[i_dim]);
+		}
+
+		if ( inside )
+		{
+			for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )
+			{
+				boxGivenPoints.push_back((givenPoint[i_dim] - box.Lower[i_dim]) / (box.Upper[i_dim] - box.Lower[i_dim]));
+			}
+		}
+	}
+
+	if ( not boxGivenPoints.empty() )
+	{
+		boxAlg->set_given_points(boxGivenPoints);
+	}
+
+	if ( not InfiniteBounds.empty() )
+	{
+		std::vector<bool> boxInfiniteBounds (2 * dimInt);	// only the bounds of the sub-box on the infinite bounds of the unit hypercube are infinite
+
+		for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )
+		{
+			boxInfiniteBounds[2 * i_dim] = (box.Lower[i_dim] == 0.0) && infinite_bound(i_dim, false);
+			boxInfiniteBounds[2 * i_dim + 1] = (box.Upper[i_dim] == 1.0) && infinite_bound(i_dim, true);
+		}
+
+		boxAlg->set_infinite_bounds(boxInfiniteBounds);
+	}
+
+	const std::size_t maxEval = (MaxEvalPerBox > 0) ? MaxEvalPerBox : boxAlg->evaluation_limit();	// without a limit per sub-box, each refinement may spend as much as one integration of the wrapped Algorithm
+
+	return boxAlg->refine(boxFunc, dimInt, argsFix, absErr, RelErr, (maxEval == 0) ? std::numeric_limits<std::size_t>::max() : maxEval);	// 0 means no limit here, but no further evaluations for Algorithm::refine
+}
+
+void MultiDimInt::DecomposedAlgorithm::bisect (const SubBox& box, SubBox& lowerHalf, SubBox& upperHalf)
+{
+	std::size_t i_longest = 0;
+
+	for ( std::size_t i_dim = 1; i_dim < box.Lower.size(); ++i_dim )
+	{
+		if ( box.Upper[i_dim] - box.Lower[i_dim] > box.Upper[i_longest] - box.Lower[i_longest] )
+		{
+			i_longest = i_dim;
+		}
+	}
+
+	const double middle = 0.5 * (box.Lower[i_longest] + box.Upper[i_longest]);
+
+	lowerHalf = box;
+	upperHalf = box;
+
+	lowerHalf.Upper[i_longest] = middle;
+	upperHalf.Lower[i_longest] = middle;
+}
+
+double MultiDimInt::DecomposedAlgorithm::volume (const SubBox& box)
+{
+	double boxVolume = 1.0;
+
+	for ( std::size_t i_dim = 0; i_dim < box.Lower.size(); ++i_dim )
+	{
+		boxVolume *= box.Upper[i_dim] - box.Lower[i_dim];
+	}
+
+	return boxVolume;
+}
@@ -0,0 +1,148 @@
+#ifndef MULTIDIMINT_DECOMPOSED_ALGORITHM_H
+#define MULTIDIMINT_DECOMPOSED_ALGORITHM_H
+
+#include "Algorithm.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class implementing a domain decomposition that parallelizes any integration algorithm.
+	 *
+	 * The unit hypercube is split into sub-boxes, either given by the user or obtained by repeatedly bisecting the
+	 * largest sub-box along its longest side until there are at least as many as threads. A copy of the wrapped
+	 * integration algorithm integrates each sub-box, and the sub-boxes are processed in parallel, such that even serial
+	 * algorithms like GSLNestedQAGAlgorithm, GSLMonteCarloVegasAlgorithm or CubatureSerialHAdaptiveAlgorithm use all
+	 * threads. The values and the errors of all sub-boxes are added up.
+	 *
+	 * Each sub-box gets the share of the absolute error limit corresponding to its volume, while the relative error
+	 * limit applies to each of them as it is. The copies are given these limits via Algorithm::refine, which for most
+	 * algorithms amounts to a copy with the new limits and otherwise unchanged parameters. As long as the combined error
+	 * exceeds the error limits, the sub-boxes that failed or whose errors exceed their share are bisected once more and
+	 * only the resulting halves are integrated again, for at most a given number of rounds. If the progress is
+	 * monitored, the combined estimate is reported after each round instead of the progress of the single sub-boxes.
+	 */
+	class DecomposedAlgorithm : public Algorithm
+	{
+	public:
+		/**
+		 * Structure describing a sub-box of the unit hypercube by its lower and upper boundaries \a Lower and \a Upper in
+		 * each dimension.
+		 */
+		struct SubBox
+		{
+			std::vector<double> Lower;
+			std::vector<double> Upper;
+		};
+
+		/**
+		 * Constructor instantiating a domain decomposition of the unit hypercube into at least \a numSubBoxes sub-boxes,
+		 * or at least as many as there are threads if it is 0, each of which is integrated with a copy of the integration
+		 * algorithm \a alg, with absolute error limit \a absErr and relative error limit \a absRel. The sub-boxes are
+		 * re-split in at most \a maxRounds further rounds, and the copies use at most \a maxEvalPerBox integrand
+		 * evaluations per sub-box if \a alg takes them into account in Algorithm::refine, where 0 means as many as one
+		 * integration of \a alg may use (see Algorithm::evaluation_limit).
+		 */
+		DecomposedAlgorithm (const Algorithm& alg, double absErr, double relErr, std::size_t numSubBoxes = 0, std::size_t maxRounds = 8, std::size_t maxEvalPerBox = 0);
+
+		/**
+		 * Constructor instantiating a domain decomposition of the unit hypercube into the sub-boxes \a subBoxes, which have
+		 * to cover it without overlap, with all other parameters as described above.
+		 */
+		DecomposedAlgorithm (const Algorithm& alg, double absErr, double relErr, const std::vector<SubBox>& subBoxes, std::size_t maxRounds = 8, std::size_t maxEvalPerBox = 0);
+
+		/**
+		 * Copy-constructor creating a copy of the wrapped integration algorithm of the DecomposedAlgorithm
+		 * \a otherDecomposedAlgorithm.
+		 */
+		DecomposedAlgorithm (const DecomposedAlgorithm& otherDecomposedAlgorithm);
+
+		Algorithm::Result run (const InternalIntegrand& func, std::size_t dimInt, const double* argsFix) const;
+
+		bool is_parallelized () const;
+
+		DecomposedAlgorithm* clone () const;
+
+		/**
+		 * Stores the points \a givenPoints, which are passed on to the copies of the wrapped integration algorithm of the
+		 * sub-boxes containing them, mapped onto the unit hypercube of the respective sub-box. The flags passed via
+		 * Algorithm::set_infinite_bounds are passed on to the copies of the sub-boxes touching the infinite bounds.
+		 */
+		void set_given_points (const std::vector<double>& givenPoints);
+
+		/**
+		 * Assignment operator creating a copy of the wrapped integration algorithm of the DecomposedAlgorithm
+		 * \a otherDecomposedAlgorithm.
+		 */
+		DecomposedAlgorithm& operator= (const DecomposedAlgorithm& otherDecomposedAlgorithm);
+
+	private:
+		/**
+		 * Structure describing one part of the decomposition, consisting of the SubBox \a Box, the Algorithm::Result
+		 * \a Integral over it, and whether it has already been integrated, \a Integrated.
+		 */
+		struct Part
+		{
+			SubBox Box;
+			Algorithm::Result Integral;
+			bool Integrated;
+		};
+
+		/**
+		 * Returns the sub-boxes the unit hypercube with \a dimInt dimensions is initially split into.
+		 */
+		std::vector<SubBox> initial_sub_boxes (std::size_t dimInt) const;
+
+		/**
+		 * Integrates the Algorithm::InternalIntegrand \a func with fixed arguments \a argsFix over the SubBox \a box with
+		 * a copy of the wrapped integration algorithm, given the absolute error limit \a absErr and the Algorithm::Context
+		 * \a context, and returns the resulting Algorithm::Result.
+		 */
+		Algorithm::Result integrate_sub_box (const InternalIntegrand& func, const double* argsFix, const SubBox& box, double absErr, const Context& context) const;
+
+		/**
+		 * Splits the SubBox \a box into two halves along its longest side, which are written to \a lowerHalf and \a upperHalf.
+		 */
+		static void bisect (const SubBox& box, SubBox& lowerHalf, SubBox& upperHalf);
+
+		/**
+		 * Returns the volume of the SubBox \a box.
+		 */
+		static double volume (const SubBox& box);
+
+		/**
+		 * Wrapped integration algorithm, which is copied for each sub-box.
+		 */
+		std::unique_ptr<Algorithm> Alg;
+
+		/**
+		 * Sub-boxes given by the user, which are empty if the unit hypercube is split automatically.
+		 */
+		std::vector<SubBox> SubBoxes;
+
+		/**
+		 * Minimal number of sub-boxes of the automatic splitting, which is the number of threads if this is 0.
+		 */
+		std::size_t NumSubBoxes;
+
+		/**
+		 * Maximal number of rounds of re-splitting sub-boxes.
+		 */
+		std::size_t MaxRounds;
+
+		/**
+		 * Maximal number of integrand evaluations per sub-box passed to Algorithm::refine, where 0 means the limit of the
+		 * wrapped integration algorithm.
+		 */
+		std::size_t MaxEvalPerBox;
+
+		/**
+		 * Points passed to the DecomposedAlgorithm via Algorithm::set_given_points.
+		 */
+		std::vector<double> GivenPoints;
+	};
+}
+
+#endif
@@ -0,0 +1,135 @@
+#include "EvaluationCache.hpp"
+
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::EvaluationCache::EvaluationCache (const std::size_t dimInt) :
+	DimInt(dimInt),
+	Capacity(0),
+	Tags(),
+	Published(),
+	Keys(),
+	Values()
+{}
+
+void MultiDimInt::EvaluationCache::reserve (const std::size_t numEntries)
+{
+	std::size_t capacity = 16;
+
+	while ( capacity < 2 * numEntries )	// keep the load factor below 1/2, such that the linear probing stays short
+	{
+		capacity *= 2;
+	}
+
+	if ( capacity <= Capacity )
+	{
+		return;
+	}
+
+	std::unique_ptr<std::atomic<std::uint64_t>[]> tags (new std::atomic<std::uint64_t>[capacity]);
+	std::unique_ptr<std::atomic<bool>[]> published (new std::atomic<bool>[capacity]);
+	std::vector<std::uint32_t> keys (capacity * DimInt);
+	std::vector<double> values (capacity);
+
+	for ( std::size_t i_slot = 0; i_slot < capacity; ++i_slot )
+	{
+		tags[i_slot].store(0, std::memory_order_relaxed);
+		published[i_slot].store(false, std::memory_order_relaxed);
+	}
+
+	for ( std::size_t i_oldSlot = 0; i_oldSlot < Capacity; ++i_oldSlot )	// move all entries into the larger table
+	{
+		const std::uint64_t tag = Tags[i_oldSlot].load(std::memory_order_relaxed);
+
+		if ( tag == 0 )
+		{
+			continue;
+		}
+
+		std::size_t i_slot = (tag >> 1) & (capacity - 1);
+
+		while ( tags[i_slot].load(std::memory_order_relaxed) != 0 )
+		{
+			i_slot = (i_slot + 1) & (capacity - 1);
+		}
+
+		tags[i_slot].store(tag, std::memory_order_relaxed);
+		published[i_slot].store(true, std::memory_order_relaxed);
+
+		std::copy_n(&Keys[i_oldSlot * DimInt], DimInt, &keys[i_slot * DimInt]);
+
+		values[i_slot] = Values[i_oldSlot];
+	}
+
+	Capacity = capacity;
+	Tags = std::move(tags);
+	Published = std::move(published);
+	Keys = std::move(keys);
+	Values = std::move(values);
+}
+
+bool MultiDimInt::EvaluationCache::find_or_claim (const std::uint32_t* key, std::size_t& i_slot)
+{
+	const std::uint64_t tag = hash(key);
+
+	i_slot = (tag >> 1) & (Capacity - 1);
+
+	while ( true )
+	{
+		std::uint64_t slotTag = Tags[i_slot].load(std::memory_order_acquire);
+
+		if ( slotTag == 0 )
+		{
+			if ( Tags[i_slot].compare_exchange_strong(slotTag, tag, std::memory_order_acq_rel) )	// claim the empty slot, unless another thread was faster, in which case 'slotTag' now holds its tag
+			{
+				std::copy_n(key, DimInt, &Keys[i_slot * DimInt]);
+
+				Published[i_slot].store(true, std::memory_order_release);
+
+				return true;
+			}
+		}
+
+		if ( slotTag == tag )	// only compare the keys if the hashes agree
+		{
+			while ( not Published[i_slot].load(std::memory_order_acquire) )	// the key is written right after the slot has been claimed
+			{}
+
+			if ( std::equal(key, key + DimInt, &Keys[i_slot * DimInt]) )
+			{
+				return false;
+			}
+		}
+
+		i_slot = (i_slot + 1) & (Capacity - 1);
+	}
+}
+
+double& MultiDimInt::EvaluationCache::value (const std::size_t i_slot)
+{
+	return Values[i_slot];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
+
+std::uint64_t MultiDimInt::EvaluationCache::hash (const std::uint32_t* key) const
+{
+	std::uint64_t hash = 14695981039346656037ULL;	// FNV-1a hash of the key, followed by the finalizer of SplitMix64
+
+	for ( std::size_t i_dim = 0; i_dim < DimInt; ++i_dim )
+	{
+		hash = (hash ^ key[i_dim]) * 1099511628211ULL;
+	}
+
+	hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+	hash = hash ^ (hash >> 31);
+
+	return hash | 1;	// 0 marks empty slots
+}
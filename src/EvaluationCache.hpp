@@ -0,0 +1,88 @@
+#ifndef MULTIDIMINT_EVALUATION_CACHE_H
+#define MULTIDIMINT_EVALUATION_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Lock-free hash table holding the integrand values at the points of grids built from nested one-dimensional
+	 * rules.
+	 *
+	 * The points are identified by integer keys, e.g. their indices on the finest grid of the ClenshawCurtisTable in each
+	 * dimension, such that integration algorithms refining such grids never evaluate the integrand twice at the same point.
+	 * A slot is claimed by atomically writing the hash of its key, after which the key is written and published by an
+	 * atomic flag, so that any number of threads can look up and insert points concurrently without ever taking a lock.
+	 * Only EvaluationCache::reserve, which has to provide room for all points before they are inserted, must not be called
+	 * concurrently with the other methods.
+	 *
+	 * It is used by ParallelPAdaptiveCubatureAlgorithm and SparseGridAlgorithm.
+	 */
+	class EvaluationCache
+	{
+	public:
+		/**
+		 * Constructor instantiating an empty cache for points in \a dimInt dimensions, i.e. with keys of \a dimInt entries.
+		 */
+		explicit EvaluationCache (std::size_t dimInt);
+
+		/**
+		 * Makes room for up to \a numEntries entries, which must not be called concurrently with any other method.
+		 */
+		void reserve (std::size_t numEntries);
+
+		/**
+		 * Looks up the point with the key \a key and writes the index of its slot into \a i_slot. If the
+		 * point is not in the cache yet, the slot is claimed for it and \c true is returned, in which case the caller has
+		 * to write its integrand value into EvaluationCache::value. Otherwise, \c false is returned.
+		 */
+		bool find_or_claim (const std::uint32_t* key, std::size_t& i_slot);
+
+		/**
+		 * Returns a reference to the integrand value stored in the slot with index \a i_slot.
+		 */
+		double& value (std::size_t i_slot);
+
+	private:
+		/**
+		 * Returns the hash of the key \a key, which is never 0.
+		 */
+		std::uint64_t hash (const std::uint32_t* key) const;
+
+		/**
+		 * Number of dimensions of the points.
+		 */
+		std::size_t DimInt;
+
+		/**
+		 * Number of slots, which is always a power of 2.
+		 */
+		std::size_t Capacity;
+
+		/**
+		 * Hashes of the keys stored in the slots, which are 0 for empty slots.
+		 */
+		std::unique_ptr<std::atomic<std::uint64_t>[]> Tags;
+
+		/**
+		 * Flags that are set as soon as the keys of the slots have been written.
+		 */
+		std::unique_ptr<std::atomic<bool>[]> Published;
+
+		/**
+		 * Keys of the slots, with EvaluationCache::DimInt entries each.
+		 */
+		std::vector<std::uint32_t> Keys;
+
+		/**
+		 * Integrand values of the slots.
+		 */
+		std::vector<double> Values;
+	};
+}
+
+#endif
@@ -0,0 +1,354 @@
+#include "FallbackAlgorithm.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::FallbackAlgorithm::Stage::Stage (const Algorithm& alg, const std::size_t refineEval) :
+	Alg(alg.clone()),
+	RefineEval(refineEval)
+{}
+
+MultiDimInt::FallbackAlgorithm::Stage::Stage (const Stage& otherStage) :
+	Alg(otherStage.Alg->clone()),
+	RefineEval(otherStage.RefineEval)
+{}
+
+MultiDimInt::FallbackAlgorithm::Stage& MultiDimInt::FallbackAlgorithm::Stage::operator= (const Stage& otherStage)
+{
+	Alg.reset(otherStage.Alg->clone());
+	RefineEval = otherStage.RefineEval;
+
+	return *this;
+}
+
+MultiDimInt::FallbackAlgorithm::FallbackAlgorithm (const double absErr, const double relErr, const std::vector<Stage>& stages, const bool reuseEvaluations) :
+	Algorithm(absErr, relErr),
+	Stages(stages),
+	ReuseEvaluations(reuseEvaluations),
+	LastStages(),
+	LastStagesMutex()
+{
+	if ( Stages.empty() )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::FallbackAlgorithm Error: No stages given" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+}
+
+MultiDimInt::FallbackAlgorithm::FallbackAlgorithm (const FallbackAlgorithm& otherFallbackAlgorithm) :
+	Algorithm(otherFallbackAlgorithm),
+	Stages(otherFallbackAlgorithm.Stages),
+	ReuseEvaluations(otherFallbackAlgorithm.ReuseEvaluations),
+	LastStages(),
+	LastStagesMutex()
+{
+	std::lock_guard<std::mutex> lock (otherFallbackAlgorithm.LastStagesMutex);
+
+	LastStages = otherFallbackAlgorithm.LastStages;
+}
+
+MultiDimInt::FallbackAlgorithm& MultiDimInt::FallbackAlgorithm::operator= (const FallbackAlgorithm& otherFallbackAlgorithm)
+{
+	Algorithm::operator=(otherFallbackAlgorithm);	// calling the assignment operator of the base class
+
+	Stages = otherFallbackAlgorithm.Stages;
+	ReuseEvaluations = otherFallbackAlgorithm.ReuseEvaluations;
+
+	std::vector<Stage> lastStages;
+
+	{
+		std::lock_guard<std::mutex> lock (otherFallbackAlgorithm.LastStagesMutex);	// copied before locking this Algorithm's mutex, such that a self-assignment does not deadlock
+
+		lastStages = otherFallbackAlgorithm.LastStages;
+	}
+
+	keep_stages(lastStages);
+
+	return *this;
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::FallbackAlgorithm::run (const InternalIntegrand& func, const std::size_t dimInt, const double* argsFix) const
+{
+	return integrate(&func, NULL, dimInt, argsFix, NULL);
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::FallbackAlgorithm::run_batch (const InternalBatchIntegrand& func, const std::size_t dimInt, const double* argsFix) const
+{
+	return integrate(NULL, &func, dimInt, argsFix, NULL);
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::FallbackAlgorithm::refine (const InternalIntegrand& func, const std::size_t dimInt, const double* argsFix, const double absErr, const double relErr, const std::size_t extraEval) const
+{
+	const RefineLimits limits = {absErr, relErr, extraEval};
+
+	return integrate(&func, NULL, dimInt, argsFix, &limits);
+}
+
+bool MultiDimInt::FallbackAlgorithm::is_parallelized () const
+{
+	for ( const Stage& stage : Stages )
+	{
+		if ( stage.Alg->is_parallelized() )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+MultiDimInt::FallbackAlgorithm* MultiDimInt::FallbackAlgorithm::clone () const
+{
+	return new FallbackAlgorithm(*this);
+}
+
+void MultiDimInt::FallbackAlgorithm::set_given_points (const std::vector<double>& givenPoints)
+{
+	for ( Stage& stage : Stages )
+	{
+		stage.Alg->set_given_points(givenPoints);
+	}
+
+	std::lock_guard<std::mutex> lock (LastStagesMutex);
+
+	for ( Stage& stage : LastStages )	// refine continues from these
+	{
+		stage.Alg->set_given_points(givenPoints);
+	}
+}
+
+void MultiDimInt::FallbackAlgorithm::set_infinite_bounds (const std::vector<bool>& infiniteBounds)
+{
+	for ( Stage& stage : Stages )
+	{
+		stage.Alg->set_infinite_bounds(infiniteBounds);
+	}
+
+	std::lock_guard<std::mutex> lock (LastStagesMutex);
+
+	for ( Stage& stage : LastStages )	// refine continues from these
+	{
+		stage.Alg->set_infinite_bounds(infiniteBounds);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
+
+MultiDimInt::Algorithm::Result MultiDimInt::FallbackAlgorithm::integrate (const InternalIntegrand* func, const InternalBatchIntegrand* batchFunc, const std::size_t dimInt, const double* argsFix, const RefineLimits* limits) const
+{
+	std::unordered_map<std::string, double> knownValues;	// integrand values of all stages that have been run, which are only read while a stage runs
+	std::unordered_map<std::string, double> newValues;		// integrand values of the running stage
+	std::mutex newValuesMutex;
+	bool storeValues = false;	// whether the values of the running stage can still be reused by a later run
+
+	auto point_key = [dimInt] (const double* argsInt)	// the bit pattern of a point, such that only identical points are matched
+	{
+		return std::string(reinterpret_cast<const char*>(argsInt), dimInt * sizeof(double));
+	};
+
+	const InternalIntegrand pointwiseFunc = [&] (const double* argsFix, const double* argsInt)
+	{
+		std::string key;
+
+		if ( not knownValues.empty() )
+		{
+			key = point_key(argsInt);
+
+			const auto knownValue = knownValues.find(key);
+
+			if ( knownValue != knownValues.end() )
+			{
+				return knownValue->second;
+			}
+		}
+
+		double value;
+
+		if ( func != NULL )
+		{
+			value = (*func)(argsFix, argsInt);
+		}
+		else
+		{
+			(*batchFunc)(argsFix, 1, argsInt, &value);
+		}
+
+		if ( storeValues )
+		{
+			std::lock_guard<std::mutex> lock (newValuesMutex);
+
+			newValues.emplace(key.empty() ? point_key(argsInt) : std::move(key), value);
+		}
+
+		return value;
+	};
+
+	const InternalBatchIntegrand storingBatchFunc = [&] (const double* argsFix, const std::size_t numPoints, const double* argsInt, double* values)	// only used if batchFunc is given
+	{
+		if ( knownValues.empty() && (not storeValues) )
+		{
+			(*batchFunc)(argsFix, numPoints, argsInt, values);
+
+			return;
+		}
+
+		std::vector<std::size_t> missingIndices;	// points whose values are not known yet, which are evaluated as one smaller batch
+		std::vector<double> missingPoints;
+
+		for ( std::size_t i_point = 0; i_point < numPoints; ++i_point )
+		{
+			const double* point = &argsInt[i_point * dimInt];
+
+			const auto knownValue = knownValues.find(point_key(point));
+
+			if ( knownValue != knownValues.end() )
+			{
+				values[i_point] = knownValue->second;
+			}
+			else
+			{
+				missingIndices.push_back(i_point);
+				missingPoints.insert(missingPoints.end(), point, point + dimInt);
+			}
+		}
+
+		if ( missingIndices.empty() )
+		{
+			return;
+		}
+
+		std::vector<double> missingValues (missingIndices.size());
+
+		(*batchFunc)(argsFix, missingIndices.size(), missingPoints.data(), missingValues.data());
+
+		for ( std::size_t i_missing = 0; i_missing < missingIndices.size(); ++i_missing )
+		{
+			values[missingIndices[i_missing]] = missingValues[i_missing];
+		}
+
+		if ( not storeValues )
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock (newValuesMutex);
+
+		for ( std::size_t i_missing = 0; i_missing < missingIndices.size(); ++i_missing )
+		{
+			newValues.emplace(point_key(&missingPoints[i_missing * dimInt]), missingValues[i_missing]);
+		}
+	};
+
+	auto store_new_values = [&] ()
+	{
+		knownValues.insert(newValues.begin(), newValues.end());
+
+		newValues.clear();
+	};
+
+	Algorithm::Result bestIntegral = {true, 0.0, std::numeric_limits<double>::infinity(), ""};	// failed result with the smallest error estimate
+
+	std::string comments ("");
+
+	std::vector<Stage> stages = (limits != NULL) ? kept_stages() : Stages;	// copies, such that concurrent integrations do not modify the same algorithms
+
+	for ( std::size_t i_stage = 0; i_stage < stages.size(); ++i_stage )
+	{
+		const Stage& stage = stages[i_stage];
+
+		stage.Alg->set_context(IntegrationContext);
+
+		const bool refineStage = (limits == NULL) && (stage.RefineEval > 0);
+
+		storeValues = ReuseEvaluations && ((i_stage + 1 < stages.size()) || refineStage);	// the values of the last stage are only read again by its refinement
+
+		Algorithm::Result integral;
+
+		if ( limits != NULL )
+		{
+			integral = stage.Alg->refine(pointwiseFunc, dimInt, argsFix, limits->AbsErr, limits->RelErr, limits->ExtraEval);
+		}
+		else if ( func != NULL )
+		{
+			integral = stage.Alg->run(pointwiseFunc, dimInt, argsFix);
+		}
+		else
+		{
+			integral = stage.Alg->run_batch(storingBatchFunc, dimInt, argsFix);
+		}
+
+		store_new_values();
+
+		if ( integral.Failed && refineStage )	// let the stage continue from its state before moving on
+		{
+			storeValues = ReuseEvaluations && (i_stage + 1 < stages.size());
+
+			integral = stage.Alg->refine(pointwiseFunc, dimInt, argsFix, AbsErr, RelErr, stage.RefineEval);
+
+			store_new_values();
+		}
+
+		if ( not integral.Failed )
+		{
+			keep_stages(stages);
+
+			return integral;
+		}
+
+		comments += std::string("	-Fallback stage ") + std::to_string(i_stage + 1) + std::string(" failed:") + std::string("\n")
+				  + integral.Comment + std::string("\n");
+
+		if ( is_finite(integral.Value) && (integral.Error < bestIntegral.Error) )
+		{
+			bestIntegral = integral;
+		}
+
+		if ( deadline_reached() && (i_stage + 1 < stages.size()) && is_finite(bestIntegral.Error) )	// do not start the remaining stages
+		{
+			bestIntegral.Failed = false;
+			bestIntegral.DeadlineReached = true;
+
+			bestIntegral.Comment = comments + std::string("	-Fallback: Deadline reached before meeting the error limits, returning the result with the smallest error estimate");
+
+			keep_stages(stages);
+
+			return bestIntegral;
+		}
+	}
+
+	bestIntegral.Failed = true;
+
+	bestIntegral.Comment = comments + std::string("	-Fallback error: All stages failed, returning the result with the smallest error estimate");
+
+	keep_stages(stages);
+
+	return bestIntegral;
+}
+
+std::vector<MultiDimInt::FallbackAlgorithm::Stage> MultiDimInt::FallbackAlgorithm::kept_stages () const
+{
+	std::lock_guard<std::mutex> lock (LastStagesMutex);
+
+	return LastStages.empty() ? Stages : LastStages;
+}
+
+void MultiDimInt::FallbackAlgorithm::keep_stages (std::vector<Stage>& stages) const
+{
+	std::lock_guard<std::mutex> lock (LastStagesMutex);
+
+	LastStages.swap(stages);
+}
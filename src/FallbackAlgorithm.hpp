@@ -0,0 +1,162 @@
+#ifndef MULTIDIMINT_FALLBACK_ALGORITHM_H
+#define MULTIDIMINT_FALLBACK_ALGORITHM_H
+
+#include "Algorithm.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class implementing a chain of integration algorithms that are tried one after the other.
+	 *
+	 * The FallbackAlgorithm is built from an ordered list of stages (see FallbackAlgorithm::Stage), typically starting
+	 * with a cheap integration algorithm and escalating to more robust or more expensive ones. The stages are run in
+	 * this order until one of them succeeds, whose result is returned. If a stage fails and has a refinement budget, it
+	 * is first refined to the error limits of the FallbackAlgorithm via Algorithm::refine, which lets algorithms that
+	 * keep their state, e.g. HAdaptiveCubatureAlgorithm, continue from where they stopped instead of starting over.
+	 *
+	 * Optionally, all integrand values obtained by the stages that have been run are kept, and a later stage sampling
+	 * the integrand at exactly the same point reuses the stored value instead of evaluating it again. This only pays off
+	 * if the stages share points, e.g. several h-adaptive or Clenshaw-Curtis based algorithms with different limits,
+	 * and the integrand is expensive, as each evaluation is then looked up and stored under a lock. It is therefore
+	 * switched off by default.
+	 *
+	 * If all stages fail, the FallbackAlgorithm returns the result with the smallest error estimate among them, together
+	 * with the comments of all stages.
+	 *
+	 * Each integration works on copies of the stages, such that concurrent integrations, e.g. the inner ones of a nested
+	 * integral, do not interfere. The copies of the last integration that has finished are kept, such that
+	 * FallbackAlgorithm::refine continues from their state. The price is that every integration copies all stages,
+	 * including the states they keep, e.g. the partition of a HAdaptiveCubatureAlgorithm.
+	 */
+	class FallbackAlgorithm : public Algorithm
+	{
+	public:
+		/**
+		 * Structure describing one stage of the FallbackAlgorithm, consisting of a copy \a Alg of the integration
+		 * algorithm and the maximal number of integrand evaluations \a RefineEval it may spend to refine its result if
+		 * it fails, where 0 disables the refinement.
+		 */
+		struct Stage
+		{
+			/**
+			 * Constructor instantiating a stage with a copy of the integration algorithm \a alg and refinement budget
+			 * \a refineEval. It is implicit, such that a list of stages can be given as a list of algorithms.
+			 */
+			Stage (const Algorithm& alg, std::size_t refineEval = 0);
+
+			/**
+			 * Copy-constructor creating a copy of the integration algorithm of the Stage \a otherStage.
+			 */
+			Stage (const Stage& otherStage);
+
+			/**
+			 * Assignment operator creating a copy of the integration algorithm of the Stage \a otherStage.
+			 */
+			Stage& operator= (const Stage& otherStage);
+
+			std::unique_ptr<Algorithm> Alg;
+			std::size_t RefineEval;
+		};
+
+		/**
+		 * Constructor instantiating a chain of the integration algorithms in \a stages with absolute error limit \a absErr
+		 * and relative error limit \a absRel, which are used to refine failed stages. If \a reuseEvaluations is \c true,
+		 * the integrand values of earlier stages are reused by later ones.
+		 */
+		FallbackAlgorithm (double absErr, double relErr, const std::vector<Stage>& stages, bool reuseEvaluations = false);
+
+		/**
+		 * Copy-constructor taking care of properly copying the kept stages FallbackAlgorithm::LastStages from the
+		 * Algorithm \a otherFallbackAlgorithm, which may be in use by another thread.
+		 */
+		FallbackAlgorithm (const FallbackAlgorithm& otherFallbackAlgorithm);
+
+		/**
+		 * Assignment operator taking care of properly copying the kept stages FallbackAlgorithm::LastStages from the
+		 * Algorithm \a otherFallbackAlgorithm, which may be in use by another thread.
+		 */
+		FallbackAlgorithm& operator= (const FallbackAlgorithm& otherFallbackAlgorithm);
+
+		Algorithm::Result run (const InternalIntegrand& func, std::size_t dimInt, const double* argsFix) const;
+
+		Algorithm::Result run_batch (const InternalBatchIntegrand& func, std::size_t dimInt, const double* argsFix) const;
+
+		/**
+		 * Refines the integration by refining the kept stages of the last integration in the given order with the error limits \a absErr and \a relErr
+		 * and at most \a extraEval further integrand evaluations each, until one of them succeeds.
+		 */
+		Algorithm::Result refine (const InternalIntegrand& func, std::size_t dimInt, const double* argsFix, double absErr, double relErr, std::size_t extraEval) const;
+
+		bool is_parallelized () const;
+
+		FallbackAlgorithm* clone () const;
+
+		/**
+		 * Passes the points \a givenPoints on to the integration algorithms of all stages.
+		 */
+		void set_given_points (const std::vector<double>& givenPoints);
+
+		/**
+		 * Passes the flags \a infiniteBounds on to the integration algorithms of all stages.
+		 */
+		void set_infinite_bounds (const std::vector<bool>& infiniteBounds);
+
+	private:
+		/**
+		 * Structure containing the error limits \a AbsErr and \a RelErr and the maximal number of further integrand
+		 * evaluations \a ExtraEval for refining all stages.
+		 */
+		struct RefineLimits
+		{
+			double AbsErr;
+			double RelErr;
+			std::size_t ExtraEval;
+		};
+
+		/**
+		 * Runs the stages for the Algorithm::InternalIntegrand \a func, or the Algorithm::InternalBatchIntegrand \a batchFunc
+		 * if \a func is \c NULL, with fixed arguments \a argsFix and \a dimInt integration variables until one of them
+		 * succeeds. If \a limits is not \c NULL, the stages are refined with these limits instead of being run, which
+		 * requires \a func.
+		 */
+		Algorithm::Result integrate (const InternalIntegrand* func, const InternalBatchIntegrand* batchFunc, std::size_t dimInt, const double* argsFix, const RefineLimits* limits) const;
+
+		/**
+		 * Returns a copy of the kept stages FallbackAlgorithm::LastStages, or of FallbackAlgorithm::Stages if no
+		 * integration has finished yet.
+		 */
+		std::vector<Stage> kept_stages () const;
+
+		/**
+		 * Replaces the kept stages FallbackAlgorithm::LastStages by \a stages, which are moved from.
+		 */
+		void keep_stages (std::vector<Stage>& stages) const;
+
+		/**
+		 * Stages of the FallbackAlgorithm in the order they are tried.
+		 */
+		std::vector<Stage> Stages;
+
+		/**
+		 * If this is \c true, the integrand values of earlier stages are reused by later ones.
+		 */
+		bool ReuseEvaluations;
+
+		/**
+		 * Copies of the stages left by the last integration that has finished. Each integration works on copies of its
+		 * own and only replaces these at its end. They have to be \c mutable, as they are replaced by FallbackAlgorithm::run.
+		 */
+		mutable std::vector<Stage> LastStages;
+
+		/**
+		 * Mutex guarding FallbackAlgorithm::LastStages.
+		 */
+		mutable std::mutex LastStagesMutex;
+	};
+}
+
+#endif
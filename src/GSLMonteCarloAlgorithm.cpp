@@ -1,7 +1,11 @@
 #include "GSLMonteCarloAlgorithm.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_monte.h>
@@ -16,14 +20,44 @@ MultiDimInt::Algorithm::Result MultiDimInt::GSLMonteCarloAlgorithm::run (const I
 	
 	GSLMonteCarloData gslMonteCarloData(func, argsFix);
 	
+	gslMonteCarloData.AntitheticSampling = AntitheticSampling;
+	
 	int fail;						// if the integration succeeds, this is set to 0, otherwise it contains a GSL error code
 	std::string furtherComment("");	// if the integration fails, an additional comment may be written to this string
 	
 	gsl_monte_function gslMonteIntegrand = {&gsl_mc_integrand, dimInt, &gslMonteCarloData};
 	
+	if ( ControlVariate )	// estimate the control variate coefficient from a uniformly sampled pilot run, during which the coefficient is 0
+	{
+		gslMonteCarloData.ControlVariate = &ControlVariate;
+		gslMonteCarloData.ControlVariateIntegral = ControlVariateIntegral(argsFix);
+		
+		std::vector<double> argsInt (dimInt);
+		
+		const std::size_t numPilotCalls = std::max(num_calls(NumEval / 10), static_cast<std::size_t>(2));
+		
+		for ( std::size_t i_call = 0; i_call < numPilotCalls; ++i_call )
+		{
+			for ( std::size_t i = 0; i < dimInt; ++i )
+			{
+				argsInt[i] = gsl_rng_uniform(RandomNumberGenerator);
+			}
+			
+			gsl_mc_integrand(argsInt.data(), dimInt, &gslMonteCarloData);
+		}
+		
+		update_control_variate_coefficient(gslMonteCarloData);
+	}
+	
 	fail = gsl_mc_integration(dimInt, gslMonteIntegrand, integral.Value, integral.Error, furtherComment);
 	
-	if ( fail != 0 )	// if integration failed, write the GSL error message and 'furtherComment' into 'integral.Comment'
+	if ( (fail == GSL_ETOL) && deadline_reached() )	// the tolerance was not reached because no further round was started after the deadline
+	{
+		integral.DeadlineReached = true;
+		
+		integral.Comment = "	-GSL Monte Carlo: Deadline reached before meeting the error limits";
+	}
+	else if ( fail != 0 )	// if integration failed, write the GSL error message and 'furtherComment' into 'integral.Comment'
 	{
 		integral.Failed = true;
 		
@@ -39,11 +73,51 @@ bool MultiDimInt::GSLMonteCarloAlgorithm::is_parallelized () const
   return false;	// all GSL Monte Carlo integration algorithms use only a single core
 }
 
+void MultiDimInt::GSLMonteCarloAlgorithm::set_antithetic_sampling (const bool antitheticSampling)
+{
+	AntitheticSampling = antitheticSampling;
+}
+
+void MultiDimInt::GSLMonteCarloAlgorithm::set_control_variate (const InternalIntegrand& controlVariate, const std::function<double(const double* argsFix)>& controlVariateIntegral)
+{
+	if ( controlVariate && not controlVariateIntegral )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::GSLMonteCarloAlgorithm Error: Integral of the control variate is not specified" << std::endl
+				  << std::endl;
+		
+		exit(EXIT_FAILURE);
+	}
+	
+	ControlVariate = controlVariate;
+	ControlVariateIntegral = controlVariateIntegral;
+}
+
+void MultiDimInt::GSLMonteCarloAlgorithm::set_adaptive_sampling (const std::size_t maxNumEval, const double growthFactor)
+{
+	if ( growthFactor <= 1.0 )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::GSLMonteCarloAlgorithm Error: Growth factor of the adaptive sampling mode is not larger than 1" << std::endl
+				  << std::endl;
+		
+		exit(EXIT_FAILURE);
+	}
+	
+	MaxNumEval = maxNumEval;
+	GrowthFactor = growthFactor;
+}
+
 MultiDimInt::GSLMonteCarloAlgorithm& MultiDimInt::GSLMonteCarloAlgorithm::operator= (const GSLMonteCarloAlgorithm& otherGSLMonteCarloAlgorithm)
 {
 	Algorithm::operator=(otherGSLMonteCarloAlgorithm);	// calling the assignment operator of the base class
 	
 	NumEval = otherGSLMonteCarloAlgorithm.NumEval;
+	MaxNumEval = otherGSLMonteCarloAlgorithm.MaxNumEval;
+	GrowthFactor = otherGSLMonteCarloAlgorithm.GrowthFactor;
+	AntitheticSampling = otherGSLMonteCarloAlgorithm.AntitheticSampling;
+	ControlVariate = otherGSLMonteCarloAlgorithm.ControlVariate;
+	ControlVariateIntegral = otherGSLMonteCarloAlgorithm.ControlVariateIntegral;
 	RandomNumberGeneratorType = otherGSLMonteCarloAlgorithm.RandomNumberGeneratorType;
 	
 	gsl_rng_free (RandomNumberGenerator);								// free the old GSL random number generator...
@@ -65,6 +139,11 @@ MultiDimInt::GSLMonteCarloAlgorithm::~GSLMonteCarloAlgorithm ()
 MultiDimInt::GSLMonteCarloAlgorithm::GSLMonteCarloAlgorithm (const double absErr, const double relErr, const std::size_t numEval, const gsl_rng_type* randomNumberGeneratorType) :
 	Algorithm(absErr, relErr),
 	NumEval(numEval),
+	MaxNumEval(0),
+	GrowthFactor(2.0),
+	AntitheticSampling(false),
+	ControlVariate(),
+	ControlVariateIntegral(),
 	RandomNumberGeneratorType(randomNumberGeneratorType)
 {
 	if ( NumEval <= 0 )
@@ -84,6 +163,11 @@ MultiDimInt::GSLMonteCarloAlgorithm::GSLMonteCarloAlgorithm (const double absErr
 MultiDimInt::GSLMonteCarloAlgorithm::GSLMonteCarloAlgorithm (const GSLMonteCarloAlgorithm& otherGSLMonteCarloAlgorithm) :
 	Algorithm(otherGSLMonteCarloAlgorithm),
 	NumEval(otherGSLMonteCarloAlgorithm.NumEval),
+	MaxNumEval(otherGSLMonteCarloAlgorithm.MaxNumEval),
+	GrowthFactor(otherGSLMonteCarloAlgorithm.GrowthFactor),
+	AntitheticSampling(otherGSLMonteCarloAlgorithm.AntitheticSampling),
+	ControlVariate(otherGSLMonteCarloAlgorithm.ControlVariate),
+	ControlVariateIntegral(otherGSLMonteCarloAlgorithm.ControlVariateIntegral),
 	RandomNumberGeneratorType(otherGSLMonteCarloAlgorithm.RandomNumberGeneratorType)
 {
 	RandomNumberGenerator = gsl_rng_alloc(RandomNumberGeneratorType);
@@ -95,8 +179,127 @@ double MultiDimInt::GSLMonteCarloAlgorithm::gsl_mc_integrand (double* argsInt, c
 {
 	GSLMonteCarloData* data = (GSLMonteCarloData*) gslMonteCarloData;
 	
-	return data->Func(data->ArgsFix, argsInt);
+	double value = data->Func(data->ArgsFix, argsInt);
+	double controlValue = 0.0;
+	
+	if ( data->ControlVariate != nullptr )
+	{
+		controlValue = (*data->ControlVariate)(data->ArgsFix, argsInt);
+	}
+	
+	if ( data->AntitheticSampling )	// average the values at the sampling point and at its reflection
+	{
+		static thread_local std::vector<double> reflectedArgsInt;	// one scratch array per thread, as the integrand may be evaluated in parallel
+		
+		reflectedArgsInt.resize(dimInt);
+		
+		for ( std::size_t i = 0; i < dimInt; ++i )
+		{
+			reflectedArgsInt[i] = 1.0 - argsInt[i];
+		}
+		
+		value = 0.5 * (value + data->Func(data->ArgsFix, reflectedArgsInt.data()));
+		
+		if ( data->ControlVariate != nullptr )
+		{
+			controlValue = 0.5 * (controlValue + (*data->ControlVariate)(data->ArgsFix, reflectedArgsInt.data()));
+		}
+	}
+	
+	if ( data->ControlVariate != nullptr )	// gather the sample moments needed to update the control variate coefficient, and subtract the control variate
+	{
+		#pragma omp atomic
+		data->NumSamples += 1.0;
+		#pragma omp atomic
+		data->SumValues += value;
+		#pragma omp atomic
+		data->SumControlValues += controlValue;
+		#pragma omp atomic
+		data->SumValueControlProducts += value * controlValue;
+		#pragma omp atomic
+		data->SumSquaredControlValues += controlValue * controlValue;
+		
+		value -= data->ControlVariateCoefficient * (controlValue - data->ControlVariateIntegral);
+	}
+	
+	return value;
+}
+
+bool MultiDimInt::GSLMonteCarloAlgorithm::tolerance_reached (const double value, const double error) const
+{
+	return (error <= AbsErr) || (error <= RelErr * std::abs(value));
+}
+
+bool MultiDimInt::GSLMonteCarloAlgorithm::next_round (gsl_monte_function& gslMonteIntegrand, const std::size_t numEvalUsed, const double value, const double error, std::size_t& numEvalRound) const
+{
+	report_progress(value, error, numEvalUsed);	// this is called after each round
+	
+	if ( (MaxNumEval <= NumEval) || (numEvalUsed >= MaxNumEval) || tolerance_reached(value, error) || deadline_reached() )	// no further round if the adaptive sampling mode is switched off, the budget is used up, the error limits are met or the deadline is reached
+	{
+		return false;
+	}
+	
+	const double errorTarget = std::max(AbsErr, RelErr * std::abs(value));
+	
+	double growth = GrowthFactor;
+	
+	if ( errorTarget > 0.0 )	// the error is expected to decrease with the inverse square root of the number of evaluations, which estimates the total number of evaluations needed
+	{
+		growth = std::min(GrowthFactor, error*error / errorTarget / errorTarget);
+	}
+	
+	numEvalRound = std::max(NumEval, static_cast<std::size_t>(std::ceil((growth - 1.0) * numEvalUsed)));	// each round uses at least as many evaluations as the first one...
+	
+	if ( numEvalRound > MaxNumEval - numEvalUsed )	// ...but the total number of evaluations must not exceed 'MaxNumEval'
+	{
+		numEvalRound = MaxNumEval - numEvalUsed;
+	}
+	
+	GSLMonteCarloData* data = (GSLMonteCarloData*) gslMonteIntegrand.params;
+	
+	if ( data->ControlVariate != nullptr )	// each round uses the coefficient estimated from all previous samples, which keeps it statistically independent of the samples of this round
+	{
+		update_control_variate_coefficient(*data);
+	}
+	
+	return numEvalRound >= NumEval;
+}
+
+std::size_t MultiDimInt::GSLMonteCarloAlgorithm::num_calls (const std::size_t numEval) const
+{
+	if ( AntitheticSampling )	// each call evaluates the integrand twice
+	{
+		return std::max(numEval / 2, static_cast<std::size_t>(1));
+	}
+	
+	return numEval;
+}
+
+void MultiDimInt::GSLMonteCarloAlgorithm::combine_rounds (const std::size_t numEvalUsed, const std::size_t numEvalRound, const double roundValue, const double roundError, double& value, double& error)
+{
+	const double numEvalTotal = static_cast<double>(numEvalUsed + numEvalRound);
+	
+	const double weightUsed = numEvalUsed / numEvalTotal;
+	const double weightRound = numEvalRound / numEvalTotal;
+	
+	value = weightUsed * value + weightRound * roundValue;
+	error = std::sqrt(weightUsed*weightUsed * error*error + weightRound*weightRound * roundError*roundError);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-// private
\ No newline at end of file
+// private
+
+void MultiDimInt::GSLMonteCarloAlgorithm::update_control_variate_coefficient (GSLMonteCarloData& gslMonteCarloData)
+{
+	const double n = gslMonteCarloData.NumSamples;
+	
+	const double covariance = gslMonteCarloData.SumValueControlProducts - gslMonteCarloData.SumValues * gslMonteCarloData.SumControlValues / n;
+	const double variance = gslMonteCarloData.SumSquaredControlValues - gslMonteCarloData.SumControlValues * gslMonteCarloData.SumControlValues / n;
+	
+	const double coefficient = covariance / variance;
+	
+	if ( (n > 1.0) && (variance > 0.0) && is_finite(coefficient) )	// keep the previous coefficient if the estimate is undefined, e.g. for a constant control variate or non-finite integrand values
+	{
+		gslMonteCarloData.ControlVariateCoefficient = coefficient;
+	}
+}
\ No newline at end of file
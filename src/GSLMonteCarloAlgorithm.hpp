@@ -3,7 +3,9 @@
 
 #include "Algorithm.hpp"
 
+#include <functional>
 #include <string>
+#include <vector>
 
 #include <gsl/gsl_monte.h>
 #include <gsl/gsl_rng.h>
@@ -27,6 +29,41 @@ namespace MultiDimInt
 		
 		virtual GSLMonteCarloAlgorithm* clone () const = 0;
 		
+		/**
+		 * Switches on the adaptive sampling mode. Instead of spending exactly GSLMonteCarloAlgorithm::NumEval integrand
+		 * evaluations, the integration is then performed in several rounds, the first one using GSLMonteCarloAlgorithm::NumEval
+		 * evaluations. After each round the combined estimate of all rounds so far is checked against the error limits,
+		 * and the integration stops as soon as they are met or the total number of evaluations would exceed \a maxNumEval.
+		 * The size of each further round is chosen from the current error estimate, assuming the error to decrease with
+		 * the inverse square root of the number of evaluations, but the total number of evaluations grows at most by the
+		 * factor \a growthFactor per round.
+		 * 
+		 * Passing a \a maxNumEval not larger than GSLMonteCarloAlgorithm::NumEval switches the adaptive mode off again.
+		 */
+		void set_adaptive_sampling (std::size_t maxNumEval, double growthFactor = 2.0);
+		
+		/**
+		 * Switches antithetic sampling on or off, depending on \a antitheticSampling. If it is switched on, the integrand
+		 * is evaluated at each sampling point x as well as at its reflection 1 - x, and their mean is used as the sample
+		 * value. This cancels all contributions that are antisymmetric under the reflection, which strongly reduces the
+		 * variance of near-symmetric integrands. The number of sampling points is halved, such that the total number of
+		 * integrand evaluations stays the same.
+		 */
+		void set_antithetic_sampling (bool antitheticSampling);
+		
+		/**
+		 * Sets the control variate \a controlVariate, whose integral over the unit hypercube for the fixed arguments argsFix
+		 * is returned by \a controlVariateIntegral. Like the integrand seen by the algorithm, the control variate is a
+		 * function on the unit hypercube, i.e. it has to include the transformation of the integration domain performed
+		 * by the Integrator. It is evaluated at the same points as the integrand, and the sample values f are replaced by
+		 * f - beta (g - G), where g is the value of the control variate and G its integral. The coefficient beta minimizing
+		 * the variance is estimated from an additional uniformly sampled pilot run using a tenth of GSLMonteCarloAlgorithm::NumEval
+		 * integrand evaluations and, in the adaptive sampling mode, updated with the samples of each round.
+		 * 
+		 * Passing an empty \a controlVariate removes the control variate again.
+		 */
+		void set_control_variate (const InternalIntegrand& controlVariate, const std::function<double(const double* argsFix)>& controlVariateIntegral);
+		
 		/**
 		 * Assignment operator taking care of properly copying the GSL random number generator GSLMonteCarloAlgorithm::RandomNumberGeneratorType
 		 * from the Algorithm \a otherGSLMonteCarloAlgorithm.
@@ -69,11 +106,31 @@ namespace MultiDimInt
 		{
 			GSLMonteCarloData (const InternalIntegrand& func, const double* argsFix) :
 				Func(func),
-				ArgsFix(argsFix)
+				ArgsFix(argsFix),
+				AntitheticSampling(false),
+				ControlVariate(nullptr),
+				ControlVariateIntegral(0.0),
+				ControlVariateCoefficient(0.0),
+				NumSamples(0.0),
+				SumValues(0.0),
+				SumControlValues(0.0),
+				SumValueControlProducts(0.0),
+				SumSquaredControlValues(0.0)
 			{};
 			
 			const InternalIntegrand& Func;
 			const double* ArgsFix;
+			
+			bool AntitheticSampling;					// whether the integrand is averaged with its value at the reflected point
+			const InternalIntegrand* ControlVariate;	// control variate, or 'nullptr' if none is used
+			double ControlVariateIntegral;				// known integral of the control variate
+			double ControlVariateCoefficient;			// current estimate of the optimal control variate coefficient
+			
+			double NumSamples;				// sample moments of the integrand and control variate values needed to estimate the control variate coefficient
+			double SumValues;
+			double SumControlValues;
+			double SumValueControlProducts;
+			double SumSquaredControlValues;
 		};
 		
 		/**
@@ -91,14 +148,73 @@ namespace MultiDimInt
 		 * functions. Therefore, all information needed by the integrand has to be provided via the \c void pointer
 		 * \a gslMonteCarloData, since static methods cannot access the non-public members of their class. \a dimInt is the
 		 * number of integration variables gathered in \a argsInt. The value of the integral is returned.
+		 * 
+		 * It is thread-safe, such that it can also be evaluated in parallel by native implementations of the algorithms.
 		 */
 		static double gsl_mc_integrand (double* argsInt, std::size_t dimInt, void* gslMonteCarloData);
 		
 		/**
-		 * Fixed number of integrand evaluations.
+		 * Returns \c true if the estimated absolute error \a error of the integral value \a value satisfies either the
+		 * absolute or the relative error limit, and \c false otherwise.
+		 */
+		bool tolerance_reached (double value, double error) const;
+		
+		/**
+		 * Reports the combined integral value \a value and its estimated error \a error after the total number of integrand
+		 * evaluations \a numEvalUsed in all previous rounds as the progress and decides whether another sampling round shall
+		 * be performed in the adaptive sampling mode. If so, it writes the number of integrand evaluations of the next round into
+		 * \a numEvalRound and returns \c true. Otherwise, e.g. if the adaptive sampling mode is switched off, the error
+		 * limits are already met or the maximal number of integrand evaluations is reached, it returns \c false. Before
+		 * another round, the control variate coefficient stored in the GSLMonteCarloData of \a gslMonteIntegrand is updated.
+		 */
+		bool next_round (gsl_monte_function& gslMonteIntegrand, std::size_t numEvalUsed, double value, double error, std::size_t& numEvalRound) const;
+		
+		/**
+		 * Returns the number of calls of GSLMonteCarloAlgorithm::gsl_mc_integrand corresponding to \a numEval integrand
+		 * evaluations, which is halved if antithetic sampling is switched on.
+		 */
+		std::size_t num_calls (std::size_t numEval) const;
+		
+		/**
+		 * Combines the integral value \a value and estimated error \a error obtained from \a numEvalUsed integrand evaluations
+		 * in all previous rounds with the value \a roundValue and error \a roundError of a statistically independent round
+		 * using \a numEvalRound evaluations, weighting each of them by its number of evaluations. The combined value and
+		 * error are written back into \a value and \a error.
+		 */
+		static void combine_rounds (std::size_t numEvalUsed, std::size_t numEvalRound, double roundValue, double roundError, double& value, double& error);
+		
+		/**
+		 * Fixed number of integrand evaluations, or number of integrand evaluations in the first round if the adaptive
+		 * sampling mode is switched on.
 		 */
 		std::size_t NumEval;
 		
+		/**
+		 * Maximal total number of integrand evaluations in the adaptive sampling mode. The adaptive sampling mode is
+		 * switched off if this is not larger than GSLMonteCarloAlgorithm::NumEval.
+		 */
+		std::size_t MaxNumEval;
+		
+		/**
+		 * Maximal factor by which the total number of integrand evaluations grows per round in the adaptive sampling mode.
+		 */
+		double GrowthFactor;
+		
+		/**
+		 * Whether antithetic sampling is switched on.
+		 */
+		bool AntitheticSampling;
+		
+		/**
+		 * Control variate, which is empty if none is used.
+		 */
+		InternalIntegrand ControlVariate;
+		
+		/**
+		 * Function returning the integral of GSLMonteCarloAlgorithm::ControlVariate over the unit hypercube for given fixed arguments.
+		 */
+		std::function<double(const double* argsFix)> ControlVariateIntegral;
+		
 		/**
 		 * Type of the GSL random number generator used for the sampling.
 		 */
@@ -108,6 +224,13 @@ namespace MultiDimInt
 		 * GSL random number generator used for the sampling.
 		 */
 		gsl_rng* RandomNumberGenerator;
+		
+	private:
+		/**
+		 * Sets the control variate coefficient of \a gslMonteCarloData to the estimate minimizing the variance, computed
+		 * from the sample moments gathered so far.
+		 */
+		static void update_control_variate_coefficient (GSLMonteCarloData& gslMonteCarloData);
 	};
 }
 
@@ -102,11 +102,25 @@ int MultiDimInt::GSLMonteCarloMiserAlgorithm::gsl_mc_integration (const std::siz
 	
 	gsl_monte_miser_params_set(workspace, &params);
 	
-	int fail = gsl_monte_miser_integrate(&gslMonteIntegrand, lowerBound.data(), upperBound.data(), dimInt, NumEval, RandomNumberGenerator, workspace, &value, &error);
+	int fail = gsl_monte_miser_integrate(&gslMonteIntegrand, lowerBound.data(), upperBound.data(), dimInt, num_calls(NumEval), RandomNumberGenerator, workspace, &value, &error);
+	
+	std::size_t numEvalUsed = NumEval;
+	std::size_t numEvalRound;
+	
+	while ( (fail == 0) && next_round(gslMonteIntegrand, numEvalUsed, value, error, numEvalRound) )	// in the adaptive sampling mode, perform further independent rounds and combine them with the previous ones
+	{
+		double roundValue, roundError;
+		
+		fail = gsl_monte_miser_integrate(&gslMonteIntegrand, lowerBound.data(), upperBound.data(), dimInt, num_calls(numEvalRound), RandomNumberGenerator, workspace, &roundValue, &roundError);
+		
+		combine_rounds(numEvalUsed, numEvalRound, roundValue, roundError, value, error);
+		
+		numEvalUsed += numEvalRound;
+	}
 	
 	gsl_monte_miser_free(workspace);
 	
-	if ( (error / value > RelErr) && (error > AbsErr) && (fail == 0) )	// set fail to 14 (GSL_ETOL) if the required tolerance was not reached, but only if there has been no other error
+	if ( not tolerance_reached(value, error) && (fail == 0) )	// set fail to 14 (GSL_ETOL) if the required tolerance was not reached, but only if there has been no other error
 	{
 		fail = 14;
 	}
@@ -61,7 +61,6 @@ namespace MultiDimInt
 	protected:
 		int gsl_mc_integration (std::size_t dimInt, gsl_monte_function& gslMonteIntegrand, double& value, double& error, std::string& furtherComment) const;
 		
-	private:
 		// GSL Miser specific parameters
 		double Estimate_frac;
 		int Min_calls_per_dim;
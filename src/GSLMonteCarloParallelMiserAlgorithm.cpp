@@ -0,0 +1,305 @@
+#include "GSLMonteCarloParallelMiserAlgorithm.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_rng.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::GSLMonteCarloParallelMiserAlgorithm::GSLMonteCarloParallelMiserAlgorithm (const double absErr, const double relErr, const std::size_t numEval, const gsl_rng_type* randomNumberGeneratorType) :
+	GSLMonteCarloMiserAlgorithm(absErr, relErr, numEval, randomNumberGeneratorType)
+{}
+
+MultiDimInt::GSLMonteCarloParallelMiserAlgorithm::GSLMonteCarloParallelMiserAlgorithm (const double absErr, const double relErr, const std::size_t numEval, const gsl_rng_type* randomNumberGeneratorType,
+																					   const double estimate_frac, const std::size_t min_calls_per_dim, const std::size_t min_calls_per_dim_per_bisection, const double alpha, const double dither) :
+	GSLMonteCarloMiserAlgorithm(absErr, relErr, numEval, randomNumberGeneratorType, estimate_frac, min_calls_per_dim, min_calls_per_dim_per_bisection, alpha, dither)
+{}
+
+bool MultiDimInt::GSLMonteCarloParallelMiserAlgorithm::is_parallelized () const
+{
+	return true;
+}
+
+MultiDimInt::GSLMonteCarloParallelMiserAlgorithm* MultiDimInt::GSLMonteCarloParallelMiserAlgorithm::clone () const
+{
+	return new GSLMonteCarloParallelMiserAlgorithm(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+int MultiDimInt::GSLMonteCarloParallelMiserAlgorithm::gsl_mc_integration (const std::size_t dimInt, gsl_monte_function& gslMonteIntegrand, double& value, double& error, std::string& furtherComment) const
+{
+	const std::vector<double> lowerBound (dimInt, 0.0);
+	const std::vector<double> upperBound (dimInt, 1.0);
+
+	int fail;
+
+	#pragma omp parallel	// the recursion is started by a single thread, while the whole team works on the tasks it spawns
+	{
+		#pragma omp single
+		{
+			fail = miser_recursion(gslMonteIntegrand, lowerBound, upperBound, num_calls(NumEval), gsl_rng_get(RandomNumberGenerator), value, error);
+
+			std::size_t numEvalUsed = NumEval;
+			std::size_t numEvalRound;
+
+			while ( (fail == 0) && next_round(gslMonteIntegrand, numEvalUsed, value, error, numEvalRound) )	// in the adaptive sampling mode, perform further independent rounds and combine them with the previous ones
+			{
+				double roundValue, roundError;
+
+				fail = miser_recursion(gslMonteIntegrand, lowerBound, upperBound, num_calls(numEvalRound), gsl_rng_get(RandomNumberGenerator), roundValue, roundError);
+
+				combine_rounds(numEvalUsed, numEvalRound, roundValue, roundError, value, error);
+
+				numEvalUsed += numEvalRound;
+			}
+		}
+	}
+
+	if ( not tolerance_reached(value, error) && (fail == 0) )	// set fail to 14 (GSL_ETOL) if the required tolerance was not reached, but only if there has been no other error
+	{
+		fail = 14;
+	}
+
+	return fail;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
+
+int MultiDimInt::GSLMonteCarloParallelMiserAlgorithm::miser_recursion (gsl_monte_function& gslMonteIntegrand, const std::vector<double>& lowerBound, const std::vector<double>& upperBound, std::size_t numCalls,
+																	   const unsigned long seed, double& value, double& error) const
+{
+	const std::size_t dimInt = lowerBound.size();
+
+	const std::size_t minCalls = Min_calls_per_dim * dimInt;
+	const std::size_t minCallsPerBisection = Min_calls_per_dim_per_bisection * dimInt;
+
+	double volume = 1.0;
+
+	for ( std::size_t i = 0; i < dimInt; ++i )
+	{
+		volume *= upperBound[i] - lowerBound[i];
+	}
+
+	gsl_rng* randomNumberGenerator = gsl_rng_alloc(RandomNumberGeneratorType);	// random number generator of this subregion
+
+	gsl_rng_set(randomNumberGenerator, seed);
+
+	if ( numCalls < minCallsPerBisection )	// too few calls for a further bisection, so use plain Monte Carlo sampling
+	{
+		if ( numCalls < 2 )
+		{
+			gsl_rng_free(randomNumberGenerator);
+
+			return GSL_EFAILED;
+		}
+
+		std::vector<double> points (numCalls * dimInt);
+		std::vector<double> values (numCalls);
+
+		for ( std::size_t i_point = 0; i_point < numCalls; ++i_point )
+		{
+			for ( std::size_t i = 0; i < dimInt; ++i )
+			{
+				points[i_point * dimInt + i] = lowerBound[i] + gsl_rng_uniform_pos(randomNumberGenerator) * (upperBound[i] - lowerBound[i]);
+			}
+		}
+
+		gsl_rng_free(randomNumberGenerator);
+
+		evaluate_points(gslMonteIntegrand, points, numCalls, values);
+
+		double mean = 0.0;
+		double sumSquares = 0.0;
+
+		for ( std::size_t i_point = 0; i_point < numCalls; ++i_point )	// recurrence for mean and variance
+		{
+			const double delta = values[i_point] - mean;
+
+			mean += delta / (i_point + 1.0);
+			sumSquares += delta * delta * (i_point / (i_point + 1.0));
+		}
+
+		value = volume * mean;
+		error = volume * std::sqrt(sumSquares / (numCalls * (numCalls - 1.0)));
+
+		return 0;
+	}
+
+	const std::size_t numEstimateCalls = std::max(minCalls, static_cast<std::size_t>(numCalls * Estimate_frac));
+
+	if ( numEstimateCalls < 4 * dimInt )
+	{
+		gsl_rng_free(randomNumberGenerator);
+
+		return GSL_ESANITY;
+	}
+
+	std::vector<double> midpoint (dimInt);
+
+	for ( std::size_t i = 0; i < dimInt; ++i )	// bisect the subregion with some fuzz
+	{
+		const double s = (gsl_rng_uniform(randomNumberGenerator) - 0.5 >= 0.0) ? Dither : -Dither;
+
+		midpoint[i] = (0.5 + s) * lowerBound[i] + (0.5 - s) * upperBound[i];
+	}
+
+	std::vector<double> points (numEstimateCalls * dimInt);
+	std::vector<double> values (numEstimateCalls);
+
+	for ( std::size_t i_point = 0; i_point < numEstimateCalls; ++i_point )
+	{
+		for ( std::size_t i = 0; i < dimInt; ++i )
+		{
+			points[i_point * dimInt + i] = lowerBound[i] + gsl_rng_uniform_pos(randomNumberGenerator) * (upperBound[i] - lowerBound[i]);
+		}
+	}
+
+	evaluate_points(gslMonteIntegrand, points, numEstimateCalls, values);
+
+	numCalls -= numEstimateCalls;
+
+	std::vector<double> sumLeft (dimInt, 0.0), sumRight (dimInt, 0.0);	// sums of the values and squared values as well as numbers of points on both sides of each possible bisection
+	std::vector<double> sumSquaresLeft (dimInt, 0.0), sumSquaresRight (dimInt, 0.0);
+	std::vector<double> hitsLeft (dimInt, 0.0), hitsRight (dimInt, 0.0);
+
+	for ( std::size_t i_point = 0; i_point < numEstimateCalls; ++i_point )
+	{
+		const double fValue = values[i_point];
+
+		for ( std::size_t i = 0; i < dimInt; ++i )
+		{
+			if ( points[i_point * dimInt + i] <= midpoint[i] )
+			{
+				sumLeft[i] += fValue;
+				sumSquaresLeft[i] += fValue * fValue;
+				hitsLeft[i] += 1.0;
+			}
+			else
+			{
+				sumRight[i] += fValue;
+				sumSquaresRight[i] += fValue * fValue;
+				hitsRight[i] += 1.0;
+			}
+		}
+	}
+
+	const double beta = 2.0 / (1.0 + Alpha);
+
+	double bestVariance = std::numeric_limits<double>::max();
+	bool foundBest = false;
+	std::size_t iBisect = 0;
+	double weightLeft = 1.0;
+	double weightRight = 1.0;
+
+	for ( std::size_t i = 0; i < dimInt; ++i )	// find the direction of bisection with the smallest total variance
+	{
+		if ( (hitsLeft[i] == 0.0) || (hitsRight[i] == 0.0) )
+		{
+			gsl_rng_free(randomNumberGenerator);
+
+			return GSL_ESANITY;
+		}
+
+		const double fractionLeft = (midpoint[i] - lowerBound[i]) / (upperBound[i] - lowerBound[i]);
+
+		const double sigmaLeft = fractionLeft * volume * std::sqrt(std::max(0.0, sumSquaresLeft[i] / hitsLeft[i] - std::pow(sumLeft[i] / hitsLeft[i], 2)));
+		const double sigmaRight = (1.0 - fractionLeft) * volume * std::sqrt(std::max(0.0, sumSquaresRight[i] / hitsRight[i] - std::pow(sumRight[i] / hitsRight[i], 2)));
+
+		const double variance = std::pow(sigmaLeft, beta) + std::pow(sigmaRight, beta);
+
+		if ( variance <= bestVariance )
+		{
+			foundBest = true;
+			bestVariance = variance;
+			iBisect = i;
+			weightLeft = std::pow(sigmaLeft, beta);
+			weightRight = std::pow(sigmaRight, beta);
+
+			if ( (weightLeft == 0.0) && (weightRight == 0.0) )
+			{
+				weightLeft = 1.0;
+				weightRight = 1.0;
+			}
+		}
+	}
+
+	if ( not foundBest )	// all estimates were the same, so choose a direction at random
+	{
+		iBisect = gsl_rng_uniform_int(randomNumberGenerator, dimInt);
+	}
+
+	const double fractionLeft = std::abs((midpoint[iBisect] - lowerBound[iBisect]) / (upperBound[iBisect] - lowerBound[iBisect]));	// distribute the remaining calls among the two halves
+	const double fractionRight = 1.0 - fractionLeft;
+
+	const double a = fractionLeft * weightLeft;
+	const double b = fractionRight * weightRight;
+
+	const double numCallsDistributed = std::max(0.0, static_cast<double>(numCalls) - 2.0 * minCalls);
+
+	const std::size_t numCallsLeft = static_cast<std::size_t>(minCalls + numCallsDistributed * a / (a + b));
+	const std::size_t numCallsRight = static_cast<std::size_t>(minCalls + numCallsDistributed * b / (a + b));
+
+	const unsigned long seedLeft = gsl_rng_get(randomNumberGenerator);	// seeds of the random number generators of both halves
+	const unsigned long seedRight = gsl_rng_get(randomNumberGenerator);
+
+	gsl_rng_free(randomNumberGenerator);
+
+	std::vector<double> upperBoundLeft (upperBound);
+	std::vector<double> lowerBoundRight (lowerBound);
+
+	upperBoundLeft[iBisect] = midpoint[iBisect];
+	lowerBoundRight[iBisect] = midpoint[iBisect];
+
+	int failLeft, failRight;
+	double valueLeft, valueRight, errorLeft, errorRight;
+
+	#pragma omp task shared(gslMonteIntegrand, lowerBound, upperBoundLeft, failLeft, valueLeft, errorLeft)	// integrate the left half in a separate task...
+	failLeft = miser_recursion(gslMonteIntegrand, lowerBound, upperBoundLeft, numCallsLeft, seedLeft, valueLeft, errorLeft);
+
+	failRight = miser_recursion(gslMonteIntegrand, lowerBoundRight, upperBound, numCallsRight, seedRight, valueRight, errorRight);	// ...while this task continues with the right half
+
+	#pragma omp taskwait
+
+	if ( failLeft != 0 )
+	{
+		return failLeft;
+	}
+
+	if ( failRight != 0 )
+	{
+		return failRight;
+	}
+
+	value = valueLeft + valueRight;
+	error = std::sqrt(errorLeft * errorLeft + errorRight * errorRight);
+
+	return 0;
+}
+
+void MultiDimInt::GSLMonteCarloParallelMiserAlgorithm::evaluate_points (gsl_monte_function& gslMonteIntegrand, std::vector<double>& points, const std::size_t numPoints, std::vector<double>& values)
+{
+	const std::size_t dimInt = gslMonteIntegrand.dim;
+	const std::size_t chunkSize = 64;	// number of points evaluated per task
+
+	for ( std::size_t i_chunk = 0; i_chunk < numPoints; i_chunk += chunkSize )
+	{
+		const std::size_t i_end = std::min(i_chunk + chunkSize, numPoints);
+
+		#pragma omp task shared(gslMonteIntegrand, points, values) if (i_end < numPoints)	// the last chunk is evaluated by the current task itself
+		for ( std::size_t i_point = i_chunk; i_point < i_end; ++i_point )
+		{
+			values[i_point] = gslMonteIntegrand.f(&points[i_point * dimInt], dimInt, gslMonteIntegrand.params);
+		}
+	}
+
+	#pragma omp taskwait
+}
@@ -0,0 +1,70 @@
+#ifndef MULTIDIMINT_GSL_MONTE_CARLO_PARALLEL_MISER_ALGORITHM_H
+#define MULTIDIMINT_GSL_MONTE_CARLO_PARALLEL_MISER_ALGORITHM_H
+
+#include "GSLMonteCarloMiserAlgorithm.hpp"
+
+#include <string>
+#include <vector>
+
+#include <gsl/gsl_rng.h>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class implementing a parallelized Monte Carlo integration scheme using the Miser algorithm.
+	 *
+	 * This is a native reimplementation of the recursive stratified sampling of the GSL Miser algorithm used by
+	 * GSLMonteCarloMiserAlgorithm, accepting the same parameters. As the two halves of every bisection are independent of
+	 * each other, each of them is integrated in a separate OpenMP task, and the sampling used to choose the bisection is
+	 * evaluated in parallel as well. Each subregion samples from its own GSL random number generator, seeded from the
+	 * generator of its parent region, such that the result does not depend on the number of threads or their scheduling.
+	 *
+	 * The results are statistically equivalent to the ones of GSLMonteCarloMiserAlgorithm, though not identical, as the
+	 * random numbers are drawn from different streams.
+	 */
+	class GSLMonteCarloParallelMiserAlgorithm : public GSLMonteCarloMiserAlgorithm
+	{
+	public:
+		/**
+		 * Constructor instantiating a parallelized Monte Carlo integration scheme using the Miser algorithm with absolute
+		 * error limit \a absErr, relative error limit \a absRel, fixed number of integrand evaluations \a numEval, and
+		 * GSL random number generator of type \a randomNumberGeneratorType. All further Miser specific parameters are set
+		 * to the same standard values as for GSLMonteCarloMiserAlgorithm.
+		 */
+		GSLMonteCarloParallelMiserAlgorithm (double absErr, double relErr, std::size_t numEval, const gsl_rng_type* randomNumberGeneratorType = gsl_rng_ranlxs2);
+
+		/**
+		 * Constructor instantiating a parallelized Monte Carlo integration scheme using the Miser algorithm with absolute
+		 * error limit \a absErr, relative error limit \a absRel, fixed number of integrand evaluations \a numEval, and
+		 * GSL random number generator of type \a randomNumberGeneratorType. All further arguments are the Miser specific
+		 * parameters also accepted by GSLMonteCarloMiserAlgorithm.
+		 */
+		GSLMonteCarloParallelMiserAlgorithm (double absErr, double relErr, std::size_t numEval, const gsl_rng_type* randomNumberGeneratorType,
+											 double estimate_frac, std::size_t min_calls_per_dim, std::size_t min_calls_per_dim_per_bisection, double alpha, double dither);
+
+		bool is_parallelized () const;
+
+		GSLMonteCarloParallelMiserAlgorithm* clone () const;
+
+	protected:
+		int gsl_mc_integration (std::size_t dimInt, gsl_monte_function& gslMonteIntegrand, double& value, double& error, std::string& furtherComment) const;
+
+	private:
+		/**
+		 * Integrates \a gslMonteIntegrand over the box with lower bounds \a lowerBound and upper bounds \a upperBound using
+		 * \a numCalls calls of the integrand and a GSL random number generator seeded with \a seed. If enough calls are
+		 * available, the box is bisected and both halves are integrated recursively in separate OpenMP tasks. It writes the
+		 * integral value into \a value and its estimated error into \a error, and returns the GSL error code.
+		 */
+		int miser_recursion (gsl_monte_function& gslMonteIntegrand, const std::vector<double>& lowerBound, const std::vector<double>& upperBound, std::size_t numCalls,
+							 unsigned long seed, double& value, double& error) const;
+
+		/**
+		 * Evaluates \a gslMonteIntegrand at the \a numPoints points gathered in \a points, writing the results into \a values.
+		 * This is done in parallel with OpenMP tasks if there are sufficiently many points.
+		 */
+		static void evaluate_points (gsl_monte_function& gslMonteIntegrand, std::vector<double>& points, std::size_t numPoints, std::vector<double>& values);
+	};
+}
+
+#endif
@@ -1,6 +1,11 @@
 #include "GSLMonteCarloVegasAlgorithm.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -15,16 +20,26 @@ MultiDimInt::GSLMonteCarloVegasAlgorithm::GSLMonteCarloVegasAlgorithm (const dou
 	GSLMonteCarloAlgorithm(absErr, relErr, numEval, randomNumberGeneratorType),
 	Alpha(1.5),
 	Iterations(5),
-	Mode(1)
-{}
+	Mode(1),
+	Grid(std::make_shared<GridState>())
+{
+	Grid->Enabled = false;
+	Grid->DimInt = 0;
+	Grid->Bins = 0;
+}
 
 MultiDimInt::GSLMonteCarloVegasAlgorithm::GSLMonteCarloVegasAlgorithm (const double absErr, const double relErr, const std::size_t numEval, const gsl_rng_type* randomNumberGeneratorType,
 																	   const double alpha, const std::size_t iterations, const int mode) :
 	GSLMonteCarloAlgorithm(absErr, relErr, numEval, randomNumberGeneratorType),
 	Alpha(alpha),
 	Iterations(iterations),
-	Mode(mode)
+	Mode(mode),
+	Grid(std::make_shared<GridState>())
 {
+	Grid->Enabled = false;
+	Grid->DimInt = 0;
+	Grid->Bins = 0;
+	
 	if ( Alpha < 0 )
 	{
 		std::cout << std::endl
@@ -58,14 +73,74 @@ MultiDimInt::GSLMonteCarloVegasAlgorithm* MultiDimInt::GSLMonteCarloVegasAlgorit
 	return new GSLMonteCarloVegasAlgorithm(*this);
 }
 
+void MultiDimInt::GSLMonteCarloVegasAlgorithm::set_grid_cache (const bool useGridCache)
+{
+	std::lock_guard<std::mutex> lock (Grid->Mutex);
+	
+	Grid->Enabled = useGridCache;
+	
+	if ( not Grid->Enabled )	// discard the cached grid when switching the cache off
+	{
+		Grid->DimInt = 0;
+		Grid->Bins = 0;
+		Grid->Boundaries.clear();
+	}
+}
+
+std::vector<char> MultiDimInt::GSLMonteCarloVegasAlgorithm::export_grid () const
+{
+	std::vector<char> grid;
+	
+	std::lock_guard<std::mutex> lock (Grid->Mutex);
+	
+	if ( Grid->Boundaries.empty() )
+	{
+		return grid;
+	}
+	
+	const std::uint64_t header[2] = {Grid->DimInt, Grid->Bins};	// the blob consists of the number of integration variables and bins, followed by the bin boundaries
+	
+	grid.resize(sizeof(header) + Grid->Boundaries.size() * sizeof(double));
+	
+	std::memcpy(grid.data(), header, sizeof(header));
+	std::memcpy(grid.data() + sizeof(header), Grid->Boundaries.data(), Grid->Boundaries.size() * sizeof(double));
+	
+	return grid;
+}
+
+void MultiDimInt::GSLMonteCarloVegasAlgorithm::import_grid (const std::vector<char>& grid)
+{
+	std::uint64_t header[2] = {0, 0};
+	
+	if ( grid.size() >= sizeof(header) )
+	{
+		std::memcpy(header, grid.data(), sizeof(header));
+	}
+	
+	if ( (header[0] == 0) || (header[1] == 0) || (grid.size() != sizeof(header) + (header[1] + 1) * header[0] * sizeof(double)) )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::GSLMonteCarloVegasAlgorithm Error: Invalid grid blob" << std::endl
+				  << std::endl;
+		
+		exit(EXIT_FAILURE);
+	}
+	
+	std::lock_guard<std::mutex> lock (Grid->Mutex);
+	
+	Grid->Enabled = true;
+	Grid->DimInt = header[0];
+	Grid->Bins = header[1];
+	Grid->Boundaries.resize((Grid->Bins + 1) * Grid->DimInt);
+	
+	std::memcpy(Grid->Boundaries.data(), grid.data() + sizeof(header), Grid->Boundaries.size() * sizeof(double));
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // protected
 
 int MultiDimInt::GSLMonteCarloVegasAlgorithm::gsl_mc_integration (const std::size_t dimInt, gsl_monte_function& gslMonteIntegrand, double& value, double& error, std::string& furtherComment) const
 {
-	std::vector<double> lowerBound (dimInt, 0.0);	// this must not be const, as gsl_monte_vegas_integrate expects the integration boundaries as arrays of non-const double values
-	std::vector<double> upperBound (dimInt, 1.0);
-	
 	gsl_monte_vegas_state* workspace = gsl_monte_vegas_alloc(dimInt);
 	
 	gsl_monte_vegas_params params;	// set Vegas specific parameters
@@ -76,18 +151,71 @@ int MultiDimInt::GSLMonteCarloVegasAlgorithm::gsl_mc_integration (const std::siz
 	params.iterations = Iterations;
 	params.mode = Mode;
 	
+	bool useGridCache;
+	
+	{
+		std::lock_guard<std::mutex> lock (Grid->Mutex);	// the grid is only copied under the lock, such that concurrent and nested integrations can share it
+		
+		useGridCache = Grid->Enabled;
+		
+		if ( useGridCache && (Grid->DimInt == dimInt) && (Grid->Bins <= workspace->bins_max) )	// warm start from the cached grid: copy it into the workspace together with the unit hypercube geometry that is otherwise only set up in stage 0, and keep it in stage 1
+		{
+			workspace->bins = Grid->Bins;
+			workspace->vol = 1.0;
+			
+			for ( std::size_t i_argInt = 0; i_argInt < dimInt; ++i_argInt )
+			{
+				workspace->delx[i_argInt] = 1.0;
+			}
+			
+			std::copy(Grid->Boundaries.begin(), Grid->Boundaries.end(), workspace->xi);
+			
+			params.stage = 1;
+		}
+	}
+	
 	gsl_monte_vegas_params_set(workspace, &params);
 	
-	int fail = gsl_monte_vegas_integrate(&gslMonteIntegrand, lowerBound.data(), upperBound.data(), dimInt, NumEval, RandomNumberGenerator, workspace, &value, &error);
+	int fail = vegas_integration(dimInt, gslMonteIntegrand, workspace, NumEval, 0, value, error);
+	
+	std::size_t numEvalUsed = Iterations * NumEval;	// each iteration evaluates the integrand 'NumEval' times
+	std::size_t numEvalRound;
+	
+	while ( (fail == 0) && next_round(gslMonteIntegrand, numEvalUsed, value, error, numEvalRound) )	// in the adaptive sampling mode, perform further rounds that keep the adapted grid as well as the accumulated results of all previous iterations (stage 2), such that 'value' and 'error' are always the combined estimates
+	{
+		gsl_monte_vegas_params_get(workspace, &params);
+		
+		params.stage = 2;
+		
+		gsl_monte_vegas_params_set(workspace, &params);
+		
+		const std::size_t numEvalIteration = std::max(numEvalRound / Iterations, static_cast<std::size_t>(1));	// the evaluations of the round are split among its iterations
+		
+		fail = vegas_integration(dimInt, gslMonteIntegrand, workspace, numEvalIteration, numEvalUsed, value, error);
+		
+		numEvalUsed += Iterations * numEvalIteration;
+	}
+	
+	const double chisq = gsl_monte_vegas_chisq(workspace);	// chi-squared per degree of freedom
+	
+	if ( useGridCache && (fail == 0) )	// store the adapted grid for the next integration
+	{
+		std::lock_guard<std::mutex> lock (Grid->Mutex);
+		
+		if ( Grid->Enabled )	// unless the cache has been switched off in the meantime
+		{
+			Grid->DimInt = dimInt;
+			Grid->Bins = workspace->bins;
+			Grid->Boundaries.assign(workspace->xi, workspace->xi + (Grid->Bins + 1) * Grid->DimInt);
+		}
+	}
 	
 	gsl_monte_vegas_free(workspace);
 	
-	if ( (error / value > RelErr) && (error > AbsErr) && (fail == 0) )	// set fail to 14 (GSL_ETOL) if the required tolerance was not reached, but only if there has been no other error
+	if ( not tolerance_reached(value, error) && (fail == 0) )	// set fail to 14 (GSL_ETOL) if the required tolerance was not reached, but only if there has been no other error
 	{
 		fail = 14;
 		
-		const double chisq = gsl_monte_vegas_chisq(workspace);	// chi-squared per degree of freedom
-	
 		std::stringstream chisqComment;	// turn chisq into a string with 2-digit mantissa
 		chisqComment.precision(2);
 		chisqComment << std::fixed << chisq;
@@ -100,4 +228,38 @@ int MultiDimInt::GSLMonteCarloVegasAlgorithm::gsl_mc_integration (const std::siz
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-// private
\ No newline at end of file
+// private
+
+int MultiDimInt::GSLMonteCarloVegasAlgorithm::vegas_integration (const std::size_t dimInt, gsl_monte_function& gslMonteIntegrand, gsl_monte_vegas_state* workspace, const std::size_t numEval, const std::size_t numEvalUsed, double& value, double& error) const
+{
+	std::vector<double> lowerBound (dimInt, 0.0);	// this must not be const, as gsl_monte_vegas_integrate expects the integration boundaries as arrays of non-const double values
+	std::vector<double> upperBound (dimInt, 1.0);
+	
+	const int numIterations = progress_monitored() ? Iterations : 1;	// number of separate calls
+	
+	gsl_monte_vegas_params params;
+	
+	gsl_monte_vegas_params_get(workspace, &params);
+	
+	params.iterations = Iterations / numIterations;
+	
+	gsl_monte_vegas_params_set(workspace, &params);
+	
+	int fail = 0;
+	
+	for ( int i_iteration = 0; (i_iteration < numIterations) && (fail == 0); ++i_iteration )
+	{
+		if ( i_iteration > 0 )	// report the previous iteration and continue with the next one, keeping the grid and the accumulated results (stage 3)
+		{
+			report_progress(value, error, numEvalUsed + numEval * i_iteration);
+			
+			params.stage = 3;
+			
+			gsl_monte_vegas_params_set(workspace, &params);
+		}
+		
+		fail = gsl_monte_vegas_integrate(&gslMonteIntegrand, lowerBound.data(), upperBound.data(), dimInt, num_calls(numEval), RandomNumberGenerator, workspace, &value, &error);
+	}
+	
+	return fail;
+}
\ No newline at end of file
@@ -3,7 +3,10 @@
 
 #include "GSLMonteCarloAlgorithm.hpp"
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <gsl/gsl_monte_vegas.h>
 #include <gsl/gsl_rng.h>
@@ -34,6 +37,9 @@ namespace MultiDimInt
 		 *  - iterations = 5
 		 *  - mode = 1 (GSL_VEGAS_MODE_IMPORTANCE)
 		 * 
+		 * Each of the iterations evaluates the integrand \a numEval times, such that an integration uses iterations * numEval
+		 * evaluations in total. This total is also what counts against the limit of the adaptive sampling mode.
+		 * 
 		 * For further details on these parameters or possible random number generator algorithms see the GSL documentation:
 		 * <a href="https://www.gnu.org/software/gsl/manual/html_node/MISER.html#VEGAS">VEGAS</a>, <a href="https://www.gnu
 		 * .org/software/gsl/manual/html_node/Random-number-generator-algorithms.html#Random-number-generator-algorithms">
@@ -57,14 +63,67 @@ namespace MultiDimInt
 		
 		GSLMonteCarloVegasAlgorithm* clone () const;
 		
+		/**
+		 * Switches the grid cache on or off, depending on \a useGridCache. If it is switched on, the grid adapted during
+		 * an integration is stored and used as the starting grid of the next integration with the same number of integration
+		 * variables, instead of training a new grid from scratch. This is useful if many similar integrals are performed
+		 * one after another, e.g. when scanning over the fixed arguments of an Integrator. Only the grid is reused, the
+		 * results of previous integrations do not enter the next one.
+		 * 
+		 * The switch and the cached grid are shared by all copies of this Algorithm, such that they also apply to the copy
+		 * used by an Integrator it has been passed to.
+		 */
+		void set_grid_cache (bool useGridCache);
+		
+		/**
+		 * Returns the currently cached grid as a binary blob that can be stored and later be passed to
+		 * GSLMonteCarloVegasAlgorithm::import_grid. If no grid is cached, the returned blob is empty.
+		 */
+		std::vector<char> export_grid () const;
+		
+		/**
+		 * Replaces the cached grid by the one contained in the binary blob \a grid, which has to be created by
+		 * GSLMonteCarloVegasAlgorithm::export_grid, and switches the grid cache on.
+		 */
+		void import_grid (const std::vector<char>& grid);
+		
 	protected:
 		int gsl_mc_integration (std::size_t dimInt, gsl_monte_function& gslMonteIntegrand, double& value, double& error, std::string& furtherComment) const;
 		
 	private:
+		/**
+		 * Performs all iterations of one call of gsl_monte_vegas_integrate with \a numEval integrand evaluations per
+		 * iteration, using the stage set in the parameters of \a workspace, and writes the combined estimates into \a value
+		 * and \a error. If the progress is monitored, the iterations are performed one at a time, continuing in stage 3,
+		 * which gives the same results, and the estimate after each of them but the last is reported, given that
+		 * \a numEvalUsed integrand evaluations have been used before. Returns the GSL error code.
+		 */
+		int vegas_integration (std::size_t dimInt, gsl_monte_function& gslMonteIntegrand, gsl_monte_vegas_state* workspace, std::size_t numEval, std::size_t numEvalUsed, double& value, double& error) const;
+		
 		// GSL Vegas specific parameters
 		double Alpha;
 		int Iterations;
 		int Mode;
+		
+		/**
+		 * Structure containing the switch \a Enabled of the grid cache, the number of integration variables \a DimInt and
+		 * of bins per integration variable \a Bins of the cached grid, its bin \a Boundaries, and the \a Mutex guarding
+		 * them. The boundaries are stored in the layout used by the GSL, i.e. the \a i-th boundary of the \a j-th
+		 * integration variable is stored at position i * DimInt + j.
+		 */
+		struct GridState
+		{
+			bool Enabled;
+			std::size_t DimInt;
+			std::size_t Bins;
+			std::vector<double> Boundaries;
+			std::mutex Mutex;
+		};
+		
+		/**
+		 * Grid cache shared by all copies of this Algorithm, which may be used by several threads at once.
+		 */
+		std::shared_ptr<GridState> Grid;
 	};
 }
 
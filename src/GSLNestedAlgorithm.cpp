@@ -1,5 +1,7 @@
 #include "GSLNestedAlgorithm.hpp"
 
+#include "Tracepoints.hpp"
+
 #include <string>
 
 #include <gsl/gsl_errno.h>
@@ -66,7 +68,11 @@ double MultiDimInt::GSLNestedAlgorithm::internal_recursion (const double current
 		
 		double error;	// error estimated by the GSL routine for inner integrations gets discarded
 		
+		MULTIDIMINT_TRACEPOINT1(nested__level__start, data.NestingCounter);
+		
 		data.ThisGSLNestedAlgorithm->gsl_integration(recursiveIntegrand, result, error);
+		
+		MULTIDIMINT_TRACEPOINT1(nested__level__done, data.NestingCounter);
 	}
 	else
 	{
@@ -0,0 +1,284 @@
+#include "GSLQuasiMonteCarloAlgorithm.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_qrng.h>
+#include <gsl/gsl_rng.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::GSLQuasiMonteCarloAlgorithm::GSLQuasiMonteCarloAlgorithm (const double absErr, const double relErr, const std::size_t maxEval, const gsl_qrng_type* sequenceType) :
+	GSLQuasiMonteCarloAlgorithm(absErr, relErr, maxEval, sequenceType, 16, 4096, 1024, gsl_rng_ranlxs2)
+{}
+
+MultiDimInt::GSLQuasiMonteCarloAlgorithm::GSLQuasiMonteCarloAlgorithm (const double absErr, const double relErr, const std::size_t maxEval, const gsl_qrng_type* sequenceType,
+																	   const std::size_t numRandomizations, const std::size_t minEval, const std::size_t blockSize, const gsl_rng_type* randomNumberGeneratorType) :
+	Algorithm(absErr, relErr),
+	MaxEval(maxEval),
+	SequenceType(sequenceType),
+	NumRandomizations(numRandomizations),
+	MinEval(minEval),
+	BlockSize(blockSize),
+	RandomNumberGeneratorType(randomNumberGeneratorType)
+{
+	if ( NumRandomizations < 2 )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::GSLQuasiMonteCarloAlgorithm Error: Number of randomizations is smaller than 2" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+
+	if ( BlockSize <= 0 )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::GSLQuasiMonteCarloAlgorithm Error: Block size is not positive" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+
+	if ( (MaxEval > 0) && (MaxEval < std::max(MinEval, NumRandomizations)) )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::GSLQuasiMonteCarloAlgorithm Error: Maximal number of integrand evaluations is smaller than the number of evaluations in the first round" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+
+	RandomNumberGenerator = gsl_rng_alloc(RandomNumberGeneratorType);
+
+	gsl_rng_set(RandomNumberGenerator, 0);
+}
+
+MultiDimInt::GSLQuasiMonteCarloAlgorithm::GSLQuasiMonteCarloAlgorithm (const GSLQuasiMonteCarloAlgorithm& otherGSLQuasiMonteCarloAlgorithm) :
+	Algorithm(otherGSLQuasiMonteCarloAlgorithm),
+	MaxEval(otherGSLQuasiMonteCarloAlgorithm.MaxEval),
+	SequenceType(otherGSLQuasiMonteCarloAlgorithm.SequenceType),
+	NumRandomizations(otherGSLQuasiMonteCarloAlgorithm.NumRandomizations),
+	MinEval(otherGSLQuasiMonteCarloAlgorithm.MinEval),
+	BlockSize(otherGSLQuasiMonteCarloAlgorithm.BlockSize),
+	RandomNumberGeneratorType(otherGSLQuasiMonteCarloAlgorithm.RandomNumberGeneratorType)
+{
+	RandomNumberGenerator = gsl_rng_alloc(RandomNumberGeneratorType);
+
+	gsl_rng_set(RandomNumberGenerator, 0);
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::GSLQuasiMonteCarloAlgorithm::run (const InternalIntegrand& func, const std::size_t dimInt, const double* argsFix) const
+{
+	Algorithm::Result integral{false, 0.0, 0.0, ""};
+
+	if ( dimInt > SequenceType->max_dimension )	// GSL aborts when allocating a sequence of too high dimension, so this has to be caught beforehand
+	{
+		integral.Failed = true;
+
+		integral.Comment = std::string("	-GSL error: ") + std::string(gsl_strerror(GSL_EINVAL))
+						 + std::string("\n	 Number of integration variables exceeds the maximal dimension of the ") + std::string(SequenceType->name) + std::string(" sequence");
+
+		return integral;
+	}
+
+	const bool digitalShift = (SequenceType == gsl_qrng_sobol) || (SequenceType == gsl_qrng_niederreiter_2);	// digital shifts preserve the net structure of the base-2 sequences, the others are shifted modulo 1
+
+	const double twoToThe32 = 4294967296.0;
+
+	std::vector<double> shifts (NumRandomizations * dimInt);
+	std::vector<std::uint32_t> digitalShifts (NumRandomizations * dimInt);
+
+	for ( std::size_t i = 0; i < NumRandomizations * dimInt; ++i )
+	{
+		shifts[i] = gsl_rng_uniform(RandomNumberGenerator);
+		digitalShifts[i] = static_cast<std::uint32_t>(shifts[i] * twoToThe32);
+	}
+
+	gsl_qrng* sequence = gsl_qrng_alloc(SequenceType, dimInt);
+
+	std::vector<double> sums (NumRandomizations, 0.0);	// sum of the integrand values of each randomization
+
+	std::vector<double> points (BlockSize * dimInt);
+	std::vector<double> values (NumRandomizations * BlockSize);
+
+	std::size_t numPointsUsed = 0;	// number of points of the sequence sampled so far with each randomization
+	std::size_t numPointsRound = 1;	// total number of points per randomization after the current round
+
+	while ( NumRandomizations * numPointsRound < MinEval )	// start with a power of two, which gives the best uniformity for the base-2 sequences
+	{
+		numPointsRound *= 2;
+	}
+
+	if ( (MaxEval > 0) && (NumRandomizations * numPointsRound > MaxEval) )
+	{
+		numPointsRound /= 2;
+	}
+
+	while ( true )
+	{
+		while ( numPointsUsed < numPointsRound )	// sample the new points of this round in blocks
+		{
+			const std::size_t numBlockPoints = std::min(BlockSize, numPointsRound - numPointsUsed);
+			const std::size_t numBlockEval = NumRandomizations * numBlockPoints;
+
+			for ( std::size_t i_point = 0; i_point < numBlockPoints; ++i_point )
+			{
+				gsl_qrng_get(sequence, &points[i_point * dimInt]);
+			}
+
+			#pragma omp parallel	// evaluate all randomizations of all points of the block in parallel
+			{
+				std::vector<double> argsInt (dimInt);
+
+				#pragma omp for schedule(static)
+				for ( std::size_t i_eval = 0; i_eval < numBlockEval; ++i_eval )
+				{
+					const std::size_t i_rand = i_eval / numBlockPoints;
+					const std::size_t i_point = i_eval % numBlockPoints;
+
+					const double* point = &points[i_point * dimInt];
+
+					for ( std::size_t i = 0; i < dimInt; ++i )
+					{
+						if ( digitalShift )	// XOR the binary digits of the point with those of the shift, placing the result at the center of the finest binary interval to keep it away from the boundaries
+						{
+							const std::uint32_t digits = static_cast<std::uint32_t>(point[i] * twoToThe32) ^ digitalShifts[i_rand * dimInt + i];
+
+							argsInt[i] = (static_cast<double>(digits) + 0.5) / twoToThe32;
+						}
+						else
+						{
+							argsInt[i] = point[i] + shifts[i_rand * dimInt + i];
+
+							if ( argsInt[i] >= 1.0 )
+							{
+								argsInt[i] -= 1.0;
+							}
+						}
+					}
+
+					values[i_eval] = func(argsFix, argsInt.data());
+				}
+			}
+
+			for ( std::size_t i_rand = 0; i_rand < NumRandomizations; ++i_rand )	// summation is done serially to keep the result independent of the number of threads
+			{
+				for ( std::size_t i_point = 0; i_point < numBlockPoints; ++i_point )
+				{
+					sums[i_rand] += values[i_rand * numBlockPoints + i_point];
+				}
+			}
+
+			numPointsUsed += numBlockPoints;
+		}
+
+		double mean = 0.0;
+
+		for ( std::size_t i_rand = 0; i_rand < NumRandomizations; ++i_rand )
+		{
+			mean += sums[i_rand] / numPointsUsed;
+		}
+
+		mean /= NumRandomizations;
+
+		double variance = 0.0;
+
+		for ( std::size_t i_rand = 0; i_rand < NumRandomizations; ++i_rand )
+		{
+			variance += std::pow(sums[i_rand] / numPointsUsed - mean, 2);
+		}
+
+		variance /= NumRandomizations - 1;
+
+		integral.Value = mean;
+		integral.Error = std::sqrt(variance / NumRandomizations);	// standard error of the mean of the independent randomizations
+
+		report_progress(integral.Value, integral.Error, NumRandomizations * numPointsUsed);
+
+		if ( not is_finite(integral.Value) )
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-Quasi-Monte Carlo error: Integral value is not finite";
+
+			break;
+		}
+
+		if ( (integral.Error <= AbsErr) || (integral.Error <= RelErr * std::abs(integral.Value)) )
+		{
+			break;
+		}
+
+		if ( (MaxEval > 0) && (2 * NumRandomizations * numPointsRound > MaxEval) )	// doubling the number of points would exceed the maximal number of integrand evaluations
+		{
+			integral.Failed = true;
+
+			integral.Comment = std::string("	-GSL error: ") + std::string(gsl_strerror(GSL_ETOL))
+							 + std::string("\n	 Maximal number of integrand evaluations reached");
+
+			break;
+		}
+
+		if ( deadline_reached() )
+		{
+			integral.DeadlineReached = true;
+
+			integral.Comment = "	-Quasi-Monte Carlo: Deadline reached before meeting the error limits";
+
+			break;
+		}
+
+		numPointsRound *= 2;
+	}
+
+	gsl_qrng_free(sequence);
+
+	return integral;
+}
+
+bool MultiDimInt::GSLQuasiMonteCarloAlgorithm::is_parallelized () const
+{
+	return true;
+}
+
+MultiDimInt::GSLQuasiMonteCarloAlgorithm* MultiDimInt::GSLQuasiMonteCarloAlgorithm::clone () const
+{
+	return new GSLQuasiMonteCarloAlgorithm(*this);
+}
+
+MultiDimInt::GSLQuasiMonteCarloAlgorithm& MultiDimInt::GSLQuasiMonteCarloAlgorithm::operator= (const GSLQuasiMonteCarloAlgorithm& otherGSLQuasiMonteCarloAlgorithm)
+{
+	Algorithm::operator=(otherGSLQuasiMonteCarloAlgorithm);	// calling the assignment operator of the base class
+
+	MaxEval = otherGSLQuasiMonteCarloAlgorithm.MaxEval;
+	SequenceType = otherGSLQuasiMonteCarloAlgorithm.SequenceType;
+	NumRandomizations = otherGSLQuasiMonteCarloAlgorithm.NumRandomizations;
+	MinEval = otherGSLQuasiMonteCarloAlgorithm.MinEval;
+	BlockSize = otherGSLQuasiMonteCarloAlgorithm.BlockSize;
+	RandomNumberGeneratorType = otherGSLQuasiMonteCarloAlgorithm.RandomNumberGeneratorType;
+
+	gsl_rng_free (RandomNumberGenerator);								// free the old GSL random number generator...
+	RandomNumberGenerator = gsl_rng_alloc(RandomNumberGeneratorType);	// ...and allocate it with the new type
+
+	gsl_rng_set(RandomNumberGenerator, 0);
+
+	return *this;
+}
+
+MultiDimInt::GSLQuasiMonteCarloAlgorithm::~GSLQuasiMonteCarloAlgorithm ()
+{
+	gsl_rng_free (RandomNumberGenerator);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
@@ -0,0 +1,116 @@
+#ifndef MULTIDIMINT_GSL_QUASI_MONTE_CARLO_ALGORITHM_H
+#define MULTIDIMINT_GSL_QUASI_MONTE_CARLO_ALGORITHM_H
+
+#include "Algorithm.hpp"
+
+#include <gsl/gsl_qrng.h>
+#include <gsl/gsl_rng.h>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class implementing a randomized quasi-Monte Carlo integration scheme using the quasi-random sequences of
+	 * the GSL.
+	 *
+	 * The integrand is sampled at the points of a low-discrepancy sequence (Sobol, Niederreiter or Halton), which for
+	 * smooth integrands leads to a much faster convergence than the pseudo-random sampling of the Monte Carlo algorithms.
+	 * To obtain an unbiased estimate of the integration error, the same points are randomized several times independently,
+	 * using a random digital shift for the base-2 sequences (Sobol, Niederreiter) and a random shift modulo 1 otherwise.
+	 * The integral value is the mean of the estimates of all randomizations, and its error is estimated from their
+	 * scatter.
+	 *
+	 * The number of points per randomization is doubled until the error limits are met or the maximal number of integrand
+	 * evaluations would be exceeded, reusing all previously sampled points. The points are generated in blocks, and all
+	 * randomizations of a block are evaluated in parallel.
+	 *
+	 * For further details on the available sequences see the GSL documentation: <a href="https://www.gnu.org/software/gsl
+	 * /doc/html/qrng.html">Quasi-Random Sequences</a>.
+	 */
+	class GSLQuasiMonteCarloAlgorithm : public Algorithm
+	{
+	public:
+		/**
+		 * Constructor instantiating a randomized quasi-Monte Carlo integration scheme with absolute error limit \a absErr,
+		 * relative error limit \a absRel, maximal number of integrand evaluations \a maxEval, which is unlimited if it is 0,
+		 * and GSL quasi-random sequence of type \a sequenceType. All further parameters are set to the following standard
+		 * values:
+		 *
+		 *  - numRandomizations = 16
+		 *  - minEval = 4096
+		 *  - blockSize = 1024
+		 *  - randomNumberGeneratorType = gsl_rng_ranlxs2
+		 */
+		GSLQuasiMonteCarloAlgorithm (double absErr, double relErr, std::size_t maxEval, const gsl_qrng_type* sequenceType = gsl_qrng_sobol);
+
+		/**
+		 * Constructor instantiating a randomized quasi-Monte Carlo integration scheme with absolute error limit \a absErr,
+		 * relative error limit \a absRel, maximal number of integrand evaluations \a maxEval, which is unlimited if it is 0,
+		 * and GSL quasi-random sequence of type \a sequenceType. The sequence is randomized \a numRandomizations times, using random numbers from a GSL
+		 * random number generator of type \a randomNumberGeneratorType. The first round uses (at least) \a minEval integrand
+		 * evaluations, and the points are generated in blocks of \a blockSize points.
+		 */
+		GSLQuasiMonteCarloAlgorithm (double absErr, double relErr, std::size_t maxEval, const gsl_qrng_type* sequenceType,
+									 std::size_t numRandomizations, std::size_t minEval, std::size_t blockSize, const gsl_rng_type* randomNumberGeneratorType);
+
+		/**
+		 * Copy-constructor taking care of properly copying the GSL random number generator GSLQuasiMonteCarloAlgorithm::RandomNumberGenerator
+		 * from the Algorithm \a otherGSLQuasiMonteCarloAlgorithm.
+		 */
+		GSLQuasiMonteCarloAlgorithm (const GSLQuasiMonteCarloAlgorithm& otherGSLQuasiMonteCarloAlgorithm);
+
+		Algorithm::Result run (const InternalIntegrand& func, std::size_t dimInt, const double* argsFix) const;
+
+		bool is_parallelized () const;
+
+		GSLQuasiMonteCarloAlgorithm* clone () const;
+
+		/**
+		 * Assignment operator taking care of properly copying the GSL random number generator GSLQuasiMonteCarloAlgorithm::RandomNumberGenerator
+		 * from the Algorithm \a otherGSLQuasiMonteCarloAlgorithm.
+		 */
+		GSLQuasiMonteCarloAlgorithm& operator= (const GSLQuasiMonteCarloAlgorithm& otherGSLQuasiMonteCarloAlgorithm);
+
+		/**
+		 * Destructor freeing the GSL random number generator GSLQuasiMonteCarloAlgorithm::RandomNumberGenerator.
+		 */
+		~GSLQuasiMonteCarloAlgorithm ();
+
+	private:
+		/**
+		 * Maximal number of integrand evaluations, which is unlimited if this is 0.
+		 */
+		std::size_t MaxEval;
+
+		/**
+		 * Type of the GSL quasi-random sequence.
+		 */
+		const gsl_qrng_type* SequenceType;
+
+		/**
+		 * Number of independent randomizations of the quasi-random sequence.
+		 */
+		std::size_t NumRandomizations;
+
+		/**
+		 * Minimal number of integrand evaluations in the first round.
+		 */
+		std::size_t MinEval;
+
+		/**
+		 * Number of points of the quasi-random sequence generated and evaluated at once.
+		 */
+		std::size_t BlockSize;
+
+		/**
+		 * Type of the GSL random number generator used for the randomizations.
+		 */
+		const gsl_rng_type* RandomNumberGeneratorType;
+
+		/**
+		 * GSL random number generator used for the randomizations.
+		 */
+		gsl_rng* RandomNumberGenerator;
+	};
+}
+
+#endif
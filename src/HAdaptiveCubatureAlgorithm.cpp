@@ -0,0 +1,493 @@
+#include "HAdaptiveCubatureAlgorithm.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::HAdaptiveCubatureAlgorithm::HAdaptiveCubatureAlgorithm (const double absErr, const double relErr, const std::size_t maxEval) :
+	HAdaptiveCubatureAlgorithm(absErr, relErr, maxEval, 1)
+{}
+
+MultiDimInt::HAdaptiveCubatureAlgorithm::HAdaptiveCubatureAlgorithm (const HAdaptiveCubatureAlgorithm& otherHAdaptiveCubatureAlgorithm) :
+	Algorithm(otherHAdaptiveCubatureAlgorithm),
+	MaxRegionsPerStep(otherHAdaptiveCubatureAlgorithm.MaxRegionsPerStep),
+	MaxEval(otherHAdaptiveCubatureAlgorithm.MaxEval),
+	ReusePartition(otherHAdaptiveCubatureAlgorithm.ReusePartition),
+	Partition(otherHAdaptiveCubatureAlgorithm.kept_partition()),
+	PartitionMutex()
+{}
+
+MultiDimInt::Algorithm::Result MultiDimInt::HAdaptiveCubatureAlgorithm::run (const InternalIntegrand& func, const std::size_t dimInt, const double* argsFix) const
+{
+	if ( dimInt > 30 )	// the Genz-Malik rule samples all 2^dimInt corners of a subregion
+	{
+		return Algorithm::Result{true, 0.0, 0.0, "	-H-adaptive cubature error: Too many integration variables for the Genz-Malik rule"};
+	}
+
+	const Rule rule = integration_rule(dimInt);
+
+	RegionPool pool = ReusePartition ? kept_partition() : RegionPool{0, {}, {}, {}, {}, {}, {}, {}};
+
+	const std::size_t numEval = prepare_partition(func, argsFix, rule, pool, ReusePartition, true);
+
+	const Algorithm::Result integral = adapt(func, argsFix, rule, pool, AbsErr, RelErr, (MaxEval == 0) ? std::numeric_limits<std::size_t>::max() : MaxEval, numEval);
+
+	keep_partition(pool);
+
+	return integral;
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::HAdaptiveCubatureAlgorithm::refine (const InternalIntegrand& func, const std::size_t dimInt, const double* argsFix, const double absErr, const double relErr, const std::size_t extraEval) const
+{
+	if ( dimInt > 30 )
+	{
+		return Algorithm::Result{true, 0.0, 0.0, "	-H-adaptive cubature error: Too many integration variables for the Genz-Malik rule"};
+	}
+
+	const Rule rule = integration_rule(dimInt);
+
+	RegionPool pool = kept_partition();
+
+	const bool keepPartition = same_fixed_arguments(pool, argsFix) || (pool.Heap.size() * rule.NumPoints <= extraEval);	// re-evaluating the partition for changed fixed arguments counts towards extraEval, so it is only kept if that fits
+
+	const std::size_t numEval = prepare_partition(func, argsFix, rule, pool, keepPartition, false);
+
+	const Algorithm::Result integral = adapt(func, argsFix, rule, pool, absErr, relErr, extraEval, numEval);
+
+	keep_partition(pool);
+
+	return integral;
+}
+
+bool MultiDimInt::HAdaptiveCubatureAlgorithm::is_parallelized () const
+{
+	return false;
+}
+
+std::size_t MultiDimInt::HAdaptiveCubatureAlgorithm::evaluation_limit () const
+{
+	return MaxEval;
+}
+
+MultiDimInt::HAdaptiveCubatureAlgorithm* MultiDimInt::HAdaptiveCubatureAlgorithm::clone () const
+{
+	return new HAdaptiveCubatureAlgorithm(*this);
+}
+
+MultiDimInt::HAdaptiveCubatureAlgorithm& MultiDimInt::HAdaptiveCubatureAlgorithm::operator= (const HAdaptiveCubatureAlgorithm& otherHAdaptiveCubatureAlgorithm)
+{
+	Algorithm::operator=(otherHAdaptiveCubatureAlgorithm);	// calling the assignment operator of the base class
+
+	MaxRegionsPerStep = otherHAdaptiveCubatureAlgorithm.MaxRegionsPerStep;
+	MaxEval = otherHAdaptiveCubatureAlgorithm.MaxEval;
+	ReusePartition = otherHAdaptiveCubatureAlgorithm.ReusePartition;
+
+	RegionPool pool = otherHAdaptiveCubatureAlgorithm.kept_partition();	// copied before locking this Algorithm's mutex, such that a self-assignment does not deadlock
+
+	keep_partition(pool);
+
+	return *this;
+}
+
+void MultiDimInt::HAdaptiveCubatureAlgorithm::set_partition_reuse (const bool reusePartition)
+{
+	ReusePartition = reusePartition;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+MultiDimInt::HAdaptiveCubatureAlgorithm::HAdaptiveCubatureAlgorithm (const double absErr, const double relErr, const std::size_t maxEval, const std::size_t maxRegionsPerStep) :
+	Algorithm(absErr, relErr),
+	MaxRegionsPerStep(maxRegionsPerStep),
+	MaxEval(maxEval),
+	ReusePartition(false),
+	Partition{0, {}, {}, {}, {}, {}, {}, {}},
+	PartitionMutex()
+{
+	if ( MaxRegionsPerStep == 0 )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::HAdaptiveCubatureAlgorithm Error: Maximal number of subregions bisected at once is 0" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
+
+MultiDimInt::HAdaptiveCubatureAlgorithm::Rule MultiDimInt::HAdaptiveCubatureAlgorithm::integration_rule (const std::size_t dimInt)
+{
+	Rule rule{dimInt, 0, {}, {}, {}};
+
+	if ( dimInt == 1 )	// 15-point Gauss-Kronrod rule with embedded 7-point Gauss rule, normalized to the interval (-1, 1) of length 2
+	{
+		const double xgk[8] = {0.991455371120812639206854697526329, 0.949107912342758524526189684047851, 0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+							   0.586087235467691130294144845693013, 0.405845151377397166906606412076961, 0.207784955007898467600689403773245, 0.000000000000000000000000000000000};
+		const double wgk[8] = {0.022935322010529224963732008058970, 0.063092092629978553290700663189204, 0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+							   0.169004726639267902826583426598550, 0.190350578064785409913256402421014, 0.204432940075298892414161999234649, 0.209482141084727828012999174891714};
+		const double wg[8] = {0.0, 0.129484966168869693270611432679082, 0.0, 0.279705391489276667901467771423780,
+							  0.0, 0.381830050505118944950369775488975, 0.0, 0.417959183673469387755102040816327};	// the Gauss nodes are every second Kronrod node
+
+		for ( std::size_t j = 0; j < 15; ++j )
+		{
+			const std::size_t i_node = (j < 8) ? j : 14 - j;
+
+			rule.Offsets.push_back((j < 7) ? -xgk[i_node] : xgk[i_node]);
+			rule.Weights.push_back(0.5 * wgk[i_node]);
+			rule.ErrorWeights.push_back(0.5 * (wgk[i_node] - wg[i_node]));
+		}
+
+		rule.NumPoints = 15;
+
+		return rule;
+	}
+
+	const double lambda2 = std::sqrt(9.0 / 70.0);	// degree-7 Genz-Malik rule with embedded degree-5 rule, as used by the Cubature library
+	const double lambda4 = std::sqrt(9.0 / 10.0);
+	const double lambda5 = std::sqrt(9.0 / 19.0);
+
+	const double dim = dimInt;
+
+	const double weight1 = (12824.0 - 9120.0 * dim + 400.0 * dim * dim) / 19683.0;
+	const double weight2 = 980.0 / 6561.0;
+	const double weight3 = (1820.0 - 400.0 * dim) / 19683.0;
+	const double weight4 = 200.0 / 19683.0;
+	const double weight5 = 6859.0 / 19683.0 / std::ldexp(1.0, dimInt);
+
+	const double weightE1 = (729.0 - 950.0 * dim + 50.0 * dim * dim) / 729.0;
+	const double weightE2 = 245.0 / 486.0;
+	const double weightE3 = (265.0 - 100.0 * dim) / 1458.0;
+	const double weightE4 = 25.0 / 729.0;
+
+	std::vector<double> offset (dimInt, 0.0);
+
+	auto add_point = [&rule, &offset] (const double weight, const double weightE)
+	{
+		rule.Offsets.insert(rule.Offsets.end(), offset.begin(), offset.end());
+		rule.Weights.push_back(weight);
+		rule.ErrorWeights.push_back(weight - weightE);
+	};
+
+	add_point(weight1, weightE1);	// center
+
+	for ( std::size_t i = 0; i < dimInt; ++i )	// points on the axes through the center, in the order expected by HAdaptiveCubatureAlgorithm::evaluate_region
+	{
+		offset[i] = -lambda2;
+		add_point(weight2, weightE2);
+
+		offset[i] = lambda2;
+		add_point(weight2, weightE2);
+
+		offset[i] = -lambda4;
+		add_point(weight3, weightE3);
+
+		offset[i] = lambda4;
+		add_point(weight3, weightE3);
+
+		offset[i] = 0.0;
+	}
+
+	for ( std::size_t i = 0; i < dimInt; ++i )	// points on the diagonals of all planes spanned by two axes
+	{
+		for ( std::size_t j = i + 1; j < dimInt; ++j )
+		{
+			for ( int i_sign = 0; i_sign < 4; ++i_sign )
+			{
+				offset[i] = (i_sign & 1) ? lambda4 : -lambda4;
+				offset[j] = (i_sign & 2) ? lambda4 : -lambda4;
+
+				add_point(weight4, weightE4);
+			}
+
+			offset[i] = 0.0;
+			offset[j] = 0.0;
+		}
+	}
+
+	const std::size_t numCorners = std::size_t(1) << dimInt;
+
+	for ( std::size_t i_corner = 0; i_corner < numCorners; ++i_corner )	// points near the corners, which do not contribute to the degree-5 rule
+	{
+		for ( std::size_t i = 0; i < dimInt; ++i )
+		{
+			offset[i] = ((i_corner >> i) & 1) ? lambda5 : -lambda5;
+		}
+
+		add_point(weight5, 0.0);
+	}
+
+	rule.NumPoints = rule.Weights.size();
+
+	return rule;
+}
+
+void MultiDimInt::HAdaptiveCubatureAlgorithm::evaluate_region (const InternalIntegrand& func, const double* argsFix, const Rule& rule, RegionPool& pool, const std::size_t i_region, std::vector<double>& points, std::vector<double>& values) const
+{
+	const std::size_t dimInt = rule.DimInt;
+
+	const double* center = &pool.Centers[i_region * dimInt];
+	const double* halfWidth = &pool.HalfWidths[i_region * dimInt];
+
+	const double* offsets = rule.Offsets.data();
+	double* coordinates = points.data();
+
+	for ( std::size_t i_point = 0; i_point < rule.NumPoints; ++i_point )	// map the points of the rule onto the subregion
+	{
+		#pragma omp simd
+		for ( std::size_t i = 0; i < dimInt; ++i )
+		{
+			coordinates[i_point * dimInt + i] = center[i] + offsets[i_point * dimInt + i] * halfWidth[i];
+		}
+	}
+
+	for ( std::size_t i_point = 0; i_point < rule.NumPoints; ++i_point )
+	{
+		values[i_point] = func(argsFix, &coordinates[i_point * dimInt]);
+	}
+
+	const double* weights = rule.Weights.data();
+	const double* errorWeights = rule.ErrorWeights.data();
+	const double* integrandValues = values.data();
+
+	double result = 0.0;
+	double resultDifference = 0.0;
+
+	#pragma omp simd reduction(+:result, resultDifference)
+	for ( std::size_t i_point = 0; i_point < rule.NumPoints; ++i_point )
+	{
+		result += weights[i_point] * integrandValues[i_point];
+		resultDifference += errorWeights[i_point] * integrandValues[i_point];
+	}
+
+	double volume = 1.0;
+
+	for ( std::size_t i = 0; i < dimInt; ++i )
+	{
+		volume *= 2.0 * halfWidth[i];
+	}
+
+	pool.Values[i_region] = volume * result;
+	pool.Errors[i_region] = volume * std::abs(resultDifference);
+
+	std::size_t splitDim = 0;
+
+	if ( dimInt > 1 )
+	{
+		const double ratio = 1.0 / 7.0;	// (lambda2 / lambda4)^2, used to eliminate the second derivative from the fourth difference
+
+		double maxDifference = 0.0;
+
+		for ( std::size_t i = 0; i < dimInt; ++i )
+		{
+			const double* axisValues = &integrandValues[1 + 4 * i];	// values at -lambda2, +lambda2, -lambda4 and +lambda4 along this axis
+
+			const double difference = std::abs(axisValues[0] + axisValues[1] - 2.0 * integrandValues[0] - ratio * (axisValues[2] + axisValues[3] - 2.0 * integrandValues[0]));	// fourth difference along this dimension
+
+			if ( difference > maxDifference * (1.0 + 1e-10) )	// bisect along the dimension with the largest fourth difference...
+			{
+				maxDifference = difference;
+				splitDim = i;
+			}
+			else if ( (difference >= maxDifference * (1.0 - 1e-10)) && (halfWidth[i] > halfWidth[splitDim]) )	// ...or the widest one among (nearly) equal ones
+			{
+				splitDim = i;
+			}
+		}
+	}
+
+	pool.SplitDims[i_region] = splitDim;
+}
+
+std::size_t MultiDimInt::HAdaptiveCubatureAlgorithm::evaluate_regions (const InternalIntegrand& func, const double* argsFix, const Rule& rule, RegionPool& pool, const std::vector<std::size_t>& regions) const
+{
+	const std::size_t numRegions = regions.size();
+
+	#pragma omp parallel if ( is_parallelized() && (numRegions > 1) )
+	{
+		std::vector<double> points (rule.NumPoints * rule.DimInt);
+		std::vector<double> values (rule.NumPoints);
+
+		#pragma omp for schedule(dynamic)
+		for ( std::size_t i_region = 0; i_region < numRegions; ++i_region )
+		{
+			evaluate_region(func, argsFix, rule, pool, regions[i_region], points, values);
+		}
+	}
+
+	return numRegions * rule.NumPoints;
+}
+
+std::size_t MultiDimInt::HAdaptiveCubatureAlgorithm::prepare_partition (const InternalIntegrand& func, const double* argsFix, const Rule& rule, RegionPool& pool, const bool keepPartition, const bool reevaluate) const
+{
+	if ( (not keepPartition) || pool.Heap.empty() || (pool.DimInt != rule.DimInt) )	// start from the whole unit hypercube
+	{
+		pool.DimInt = rule.DimInt;
+		pool.Centers.assign(rule.DimInt, 0.5);
+		pool.HalfWidths.assign(rule.DimInt, 0.5);
+		pool.Values.assign(1, 0.0);
+		pool.Errors.assign(1, 0.0);
+		pool.SplitDims.assign(1, 0);
+		pool.Heap.assign(1, 0);
+	}
+	else if ( (not reevaluate) && same_fixed_arguments(pool, argsFix) )
+	{
+		return 0;
+	}
+
+	const std::size_t numEval = evaluate_regions(func, argsFix, rule, pool, pool.Heap);
+
+	std::make_heap(pool.Heap.begin(), pool.Heap.end(), [&pool] (const std::size_t i_region1, const std::size_t i_region2) { return pool.Errors[i_region1] < pool.Errors[i_region2]; });	// the errors have changed, so the heap has to be rebuilt
+
+	pool.ArgsFix.assign(argsFix, argsFix + IntegrationContext.DimFix);
+
+	return numEval;
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::HAdaptiveCubatureAlgorithm::adapt (const InternalIntegrand& func, const double* argsFix, const Rule& rule, RegionPool& pool, const double absErr, const double relErr, const std::size_t maxEval, std::size_t numEval) const
+{
+	Algorithm::Result integral{false, 0.0, 0.0, ""};
+
+	const std::size_t dimInt = rule.DimInt;
+
+	auto smaller_error = [&pool] (const std::size_t i_region1, const std::size_t i_region2)	// orders the heap such that the subregion with the largest error is at its top
+	{
+		return pool.Errors[i_region1] < pool.Errors[i_region2];
+	};
+
+	for ( const std::size_t i_region : pool.Heap )
+	{
+		integral.Value += pool.Values[i_region];
+		integral.Error += pool.Errors[i_region];
+	}
+
+	report_progress(integral.Value, integral.Error, numEval);
+
+	std::vector<std::size_t> newRegions;
+
+	while ( (integral.Error > absErr) && (integral.Error > relErr * std::abs(integral.Value)) )
+	{
+		if ( not is_finite(integral.Value) )
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-H-adaptive cubature error: Integral value is not finite";
+
+			break;
+		}
+
+		if ( deadline_reached() )	// keep the partition, such that a later refinement continues from here
+		{
+			integral.DeadlineReached = true;
+
+			integral.Comment = "	-H-adaptive cubature: Deadline reached before meeting the error limits";
+
+			break;
+		}
+
+		const double tolerance = std::max(absErr, relErr * std::abs(integral.Value));
+
+		double remainingError = integral.Error;	// total error of the subregions that are not bisected in this step
+
+		newRegions.clear();
+
+		while ( (not pool.Heap.empty()) && (newRegions.size() < 2 * MaxRegionsPerStep) && ((newRegions.size() == 0) || (remainingError > tolerance))	// select the subregions with the largest errors until bisecting them could suffice to meet the error limits
+				&& (numEval + (newRegions.size() + 2) * rule.NumPoints <= maxEval) )
+		{
+			std::pop_heap(pool.Heap.begin(), pool.Heap.end(), smaller_error);
+
+			const std::size_t i_lower = pool.Heap.back();	// the lower half replaces the bisected subregion in the pool, the upper one is appended
+			const std::size_t i_upper = pool.Values.size();
+
+			pool.Heap.pop_back();
+
+			remainingError -= pool.Errors[i_lower];
+
+			integral.Value -= pool.Values[i_lower];
+			integral.Error -= pool.Errors[i_lower];
+
+			const std::size_t splitDim = pool.SplitDims[i_lower];
+
+			pool.Centers.resize((i_upper + 1) * dimInt);
+			pool.HalfWidths.resize((i_upper + 1) * dimInt);
+
+			std::copy_n(pool.Centers.begin() + i_lower * dimInt, dimInt, pool.Centers.begin() + i_upper * dimInt);
+			std::copy_n(pool.HalfWidths.begin() + i_lower * dimInt, dimInt, pool.HalfWidths.begin() + i_upper * dimInt);
+
+			pool.Values.push_back(0.0);
+			pool.Errors.push_back(0.0);
+			pool.SplitDims.push_back(0);
+
+			const double halfWidth = 0.5 * pool.HalfWidths[i_lower * dimInt + splitDim];
+
+			pool.HalfWidths[i_lower * dimInt + splitDim] = halfWidth;
+			pool.HalfWidths[i_upper * dimInt + splitDim] = halfWidth;
+
+			pool.Centers[i_lower * dimInt + splitDim] -= halfWidth;
+			pool.Centers[i_upper * dimInt + splitDim] += halfWidth;
+
+			newRegions.push_back(i_lower);
+			newRegions.push_back(i_upper);
+		}
+
+		if ( newRegions.empty() )	// bisecting another subregion would exceed the maximal number of integrand evaluations
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-H-adaptive cubature error: Maximal number of integrand evaluations reached";
+
+			break;
+		}
+
+		numEval += evaluate_regions(func, argsFix, rule, pool, newRegions);
+
+		for ( const std::size_t i_region : newRegions )	// the heap is updated serially to keep the result independent of the number of threads
+		{
+			integral.Value += pool.Values[i_region];
+			integral.Error += pool.Errors[i_region];
+
+			pool.Heap.push_back(i_region);
+			std::push_heap(pool.Heap.begin(), pool.Heap.end(), smaller_error);
+		}
+
+		report_progress(integral.Value, integral.Error, numEval);
+	}
+
+	integral.Value = 0.0;	// sum up the final partition anew to get rid of the round-off errors accumulated by the updates
+	integral.Error = 0.0;
+
+	for ( const std::size_t i_region : pool.Heap )
+	{
+		integral.Value += pool.Values[i_region];
+		integral.Error += pool.Errors[i_region];
+	}
+
+	return integral;
+}
+
+MultiDimInt::HAdaptiveCubatureAlgorithm::RegionPool MultiDimInt::HAdaptiveCubatureAlgorithm::kept_partition () const
+{
+	std::lock_guard<std::mutex> lock (PartitionMutex);
+
+	return Partition;
+}
+
+void MultiDimInt::HAdaptiveCubatureAlgorithm::keep_partition (RegionPool& pool) const
+{
+	std::lock_guard<std::mutex> lock (PartitionMutex);
+
+	Partition = std::move(pool);
+}
+
+bool MultiDimInt::HAdaptiveCubatureAlgorithm::same_fixed_arguments (const RegionPool& pool, const double* argsFix) const
+{
+	return std::equal(pool.ArgsFix.begin(), pool.ArgsFix.end(), argsFix);
+}
@@ -0,0 +1,194 @@
+#ifndef MULTIDIMINT_H_ADAPTIVE_CUBATURE_ALGORITHM_H
+#define MULTIDIMINT_H_ADAPTIVE_CUBATURE_ALGORITHM_H
+
+#include "Algorithm.hpp"
+
+#include <mutex>
+#include <vector>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class implementing a native h-adaptive cubature algorithm that keeps its final partition of the integration
+	 * region.
+	 *
+	 * The algorithm follows the h-adaptive scheme of the <a href="https://github.com/stevengj/cubature">Cubature libarary</a>
+	 * used by CubatureSerialHAdaptiveAlgorithm: Each subregion is integrated with the degree-7 Genz-Malik rule and an
+	 * embedded degree-5 rule for the error estimate (a 15-point Gauss-Kronrod rule in one dimension), and the subregion
+	 * with the largest error is repeatedly bisected along the dimension in which the integrand's fourth difference is
+	 * largest, until the total error meets the error limits or the maximal number of integrand evaluations is reached.
+	 *
+	 * In contrast to the Cubature library, the final partition is kept by the Algorithm. HAdaptiveCubatureAlgorithm::refine
+	 * then continues subdividing it with tighter error limits instead of starting over from the whole unit hypercube, and
+	 * if the partition reuse is switched on (see HAdaptiveCubatureAlgorithm::set_partition_reuse), each new integration,
+	 * e.g. for slightly different fixed arguments, starts from the partition of the previous one. A refinement for other
+	 * fixed arguments than those of the kept partition has to evaluate it anew, which counts towards its maximal number of
+	 * further integrand evaluations, and otherwise starts over. Concurrent integrations each work on a copy of the kept
+	 * partition, and the one finishing last replaces it.
+	 */
+	class HAdaptiveCubatureAlgorithm : public Algorithm
+	{
+	public:
+		/**
+		 * Constructor instantiating a native h-adaptive cubature scheme with absolute error limit \a absErr, relative
+		 * error limit \a absRel and maximal number of integrand evaluations \a maxEval, which is unlimited if it is 0.
+		 */
+		HAdaptiveCubatureAlgorithm (double absErr, double relErr, std::size_t maxEval);
+
+		/**
+		 * Copy-constructor taking care of properly copying the kept partition HAdaptiveCubatureAlgorithm::Partition from
+		 * the Algorithm \a otherHAdaptiveCubatureAlgorithm, which may be in use by another thread.
+		 */
+		HAdaptiveCubatureAlgorithm (const HAdaptiveCubatureAlgorithm& otherHAdaptiveCubatureAlgorithm);
+
+		Algorithm::Result run (const InternalIntegrand& func, std::size_t dimInt, const double* argsFix) const;
+
+		Algorithm::Result refine (const InternalIntegrand& func, std::size_t dimInt, const double* argsFix, double absErr, double relErr, std::size_t extraEval) const;
+
+		bool is_parallelized () const;
+
+		HAdaptiveCubatureAlgorithm* clone () const;
+
+		std::size_t evaluation_limit () const;
+
+		/**
+		 * Assignment operator taking care of properly copying the kept partition HAdaptiveCubatureAlgorithm::Partition
+		 * from the Algorithm \a otherHAdaptiveCubatureAlgorithm, which may be in use by another thread.
+		 */
+		HAdaptiveCubatureAlgorithm& operator= (const HAdaptiveCubatureAlgorithm& otherHAdaptiveCubatureAlgorithm);
+
+		/**
+		 * Switches the partition reuse on or off, depending on \a reusePartition. If it is switched on, each integration
+		 * with the same number of integration variables starts from the final partition of the previous one, whose
+		 * subregions are first evaluated anew for the current integrand and fixed arguments. This saves the initial
+		 * subdivision steps if many similar integrals are performed, e.g. for slowly varying fixed arguments.
+		 */
+		void set_partition_reuse (bool reusePartition);
+
+	protected:
+		/**
+		 * Constructor instantiating a native h-adaptive cubature scheme with absolute error limit \a absErr, relative
+		 * error limit \a absRel and maximal number of integrand evaluations \a maxEval, which is unlimited if it is 0,
+		 * that bisects up to \a maxRegionsPerStep subregions at once.
+		 */
+		HAdaptiveCubatureAlgorithm (double absErr, double relErr, std::size_t maxEval, std::size_t maxRegionsPerStep);
+
+		/**
+		 * Maximal number of subregions with the largest errors that are bisected at once. The subregions resulting from
+		 * one step are evaluated in parallel if HAdaptiveCubatureAlgorithm::is_parallelized returns \c true.
+		 */
+		std::size_t MaxRegionsPerStep;
+
+	private:
+		/**
+		 * Structure describing an integration rule for the subregions of a \a DimInt-dimensional hypercube. It consists
+		 * of \a NumPoints points whose \a Offsets from the center are given in units of the half widths of the subregion,
+		 * the \a Weights of the rule and the \a ErrorWeights, i.e. the differences between these and the weights of the
+		 * embedded lower degree rule. All weights are normalized to a subregion of unit volume.
+		 */
+		struct Rule
+		{
+			std::size_t DimInt;
+			std::size_t NumPoints;
+			std::vector<double> Offsets;
+			std::vector<double> Weights;
+			std::vector<double> ErrorWeights;
+		};
+
+		/**
+		 * Structure holding all subregions of a partition of the unit hypercube as a structure of arrays. The \a Centers
+		 * and \a HalfWidths of the subregions are stored consecutively, with \a DimInt entries each, followed by the integral
+		 * \a Values over them, their estimated \a Errors and the dimensions \a SplitDims along which they should be bisected.
+		 * \a Heap contains the indices of all subregions, ordered as a heap by their errors, and \a ArgsFix are the fixed
+		 * arguments the subregions were last evaluated with.
+		 */
+		struct RegionPool
+		{
+			std::size_t DimInt;
+			std::vector<double> Centers;
+			std::vector<double> HalfWidths;
+			std::vector<double> Values;
+			std::vector<double> Errors;
+			std::vector<std::size_t> SplitDims;
+			std::vector<std::size_t> Heap;
+			std::vector<double> ArgsFix;
+		};
+
+		/**
+		 * Returns the degree-7 Genz-Malik rule with embedded degree-5 rule for \a dimInt integration variables, or the
+		 * 15-point Gauss-Kronrod rule with embedded 7-point Gauss rule if \a dimInt is 1.
+		 */
+		static Rule integration_rule (std::size_t dimInt);
+
+		/**
+		 * Applies \a rule to the subregion with index \a i_region of the partition \a pool for the Algorithm::InternalIntegrand \a func with fixed arguments \a argsFix, setting its value, error and splitting
+		 * dimension. \a points and \a values are scratch arrays for the coordinates of all points of the rule and the
+		 * integrand values at them.
+		 */
+		void evaluate_region (const InternalIntegrand& func, const double* argsFix, const Rule& rule, RegionPool& pool, std::size_t i_region, std::vector<double>& points, std::vector<double>& values) const;
+
+		/**
+		 * Applies \a rule to all subregions of the partition \a pool whose indices are listed in \a regions,
+		 * in parallel if HAdaptiveCubatureAlgorithm::is_parallelized returns \c true, and returns the number of integrand
+		 * evaluations used.
+		 */
+		std::size_t evaluate_regions (const InternalIntegrand& func, const double* argsFix, const Rule& rule, RegionPool& pool, const std::vector<std::size_t>& regions) const;
+
+		/**
+		 * Prepares the partition \a pool for an integration of the Algorithm::InternalIntegrand \a func
+		 * with fixed arguments \a argsFix using \a rule and returns the number of integrand evaluations used. If
+		 * \a keepPartition is \c true and the partition has the right number of integration variables, it is kept and only
+		 * re-evaluated if it was evaluated for different fixed arguments or if \a reevaluate is \c true. Otherwise it is
+		 * replaced by the whole unit hypercube.
+		 */
+		std::size_t prepare_partition (const InternalIntegrand& func, const double* argsFix, const Rule& rule, RegionPool& pool, bool keepPartition, bool reevaluate) const;
+
+		/**
+		 * Bisects the subregions of the partition \a pool until its total error meets the absolute and relative error limits
+		 * \a absErr and \a relErr, or until no further bisection is possible without exceeding \a maxEval integrand
+		 * evaluations in total, given that \a numEval of them have already been used, and returns the resulting
+		 * Algorithm::Result.
+		 */
+		Algorithm::Result adapt (const InternalIntegrand& func, const double* argsFix, const Rule& rule, RegionPool& pool, double absErr, double relErr, std::size_t maxEval, std::size_t numEval) const;
+
+		/**
+		 * Returns a copy of the kept partition HAdaptiveCubatureAlgorithm::Partition.
+		 */
+		RegionPool kept_partition () const;
+
+		/**
+		 * Replaces the kept partition HAdaptiveCubatureAlgorithm::Partition by \a pool, which is moved from.
+		 */
+		void keep_partition (RegionPool& pool) const;
+
+		/**
+		 * Returns \c true if \a argsFix coincide with the fixed arguments the partition \a pool was last evaluated with.
+		 */
+		bool same_fixed_arguments (const RegionPool& pool, const double* argsFix) const;
+
+		/**
+		 * Maximal number of integrand evaluations, which is unlimited if this is 0.
+		 */
+		std::size_t MaxEval;
+
+		/**
+		 * Whether each integration starts from the partition of the previous one.
+		 */
+		bool ReusePartition;
+
+		/**
+		 * Partition of the unit hypercube left by the last integration that has finished. Each integration works on a
+		 * partition of its own and only copies this one at its start and replaces it at its end, such that concurrent
+		 * integrations, e.g. the inner ones of a nested integral, do not interfere. It has to be \c mutable, as it is
+		 * replaced by HAdaptiveCubatureAlgorithm::run.
+		 */
+		mutable RegionPool Partition;
+
+		/**
+		 * Mutex guarding HAdaptiveCubatureAlgorithm::Partition.
+		 */
+		mutable std::mutex PartitionMutex;
+	};
+}
+
+#endif
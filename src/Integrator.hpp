@@ -2,11 +2,16 @@
 #define MULTIDIMINT_INTEGRATOR_H
 
 #include "Algorithm.hpp"
+#include "Trace.hpp"
+#include "Tracepoints.hpp"
 
 #include <array>
 #include <functional>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace MultiDimInt
 {
@@ -73,6 +78,25 @@ namespace MultiDimInt
 	template <std::size_t DimInt, class Class>
 	using ConstMemberIntegrandWithoutFixedArgumentsPointer = double(Class::*)(const Arguments<DimInt>& argsInt) const;
 	
+	/**
+	 * Functions that only shall be integrated over some of their arguments and that can evaluate many points at once, e.g.
+	 * using SIMD instructions, can alternatively be of this form: They take a reference to some MultiDimInt::Arguments
+	 * \a argsFix containing the fixed arguments of the function, the number \a numPoints of points, a pointer \a argsInt
+	 * to an array of \a numPoints MultiDimInt::Arguments containing the integration variables at these points, and write
+	 * the \a numPoints values of the function into \a values.
+	 */
+	template <std::size_t DimFix, std::size_t DimInt>
+	using BatchIntegrand = std::function<void(const Arguments<DimFix>& argsFix, std::size_t numPoints, const Arguments<DimInt>* argsInt, double* values)>;
+	
+	/**
+	 * Functions that shall be integrated over all of their arguments and that can evaluate many points at once can
+	 * alternatively be of this form: They take the number \a numPoints of points, a pointer \a argsInt to an array of
+	 * \a numPoints MultiDimInt::Arguments containing all the variables at these points, and write the \a numPoints values
+	 * of the function into \a values.
+	 */
+	template <std::size_t DimInt>
+	using BatchIntegrandWithoutFixedArguments = std::function<void(std::size_t numPoints, const Arguments<DimInt>* argsInt, double* values)>;
+	
 	/**
 	 * Use this to specify a positive infinite integration boundary.
 	 */
@@ -127,6 +151,16 @@ namespace MultiDimInt
 		template <class Class>
 		Integrator (const ConstMemberIntegrandPointer<DimFix, DimInt, Class> constMemberFuncPointer, const Class& constObject, const Algorithm& alg, const std::string& identifier = "");
 		
+		/**
+		 * Constructor instantiating an integrator that integrates over the \a \DimInt integration variables of the
+		 * MultiDimInt::BatchIntegrand \a batchFunc while keeping its other \a DimFix arguments fixed, using the integration
+		 * Algorithm \a alg. Algorithms that sample the integrand in batches pass these batches on to \a batchFunc in one
+		 * call (see Algorithm::run_batch), while all others call it for one point at a time. Furthermore, one can provide an
+		 * optional \c string \a identifier that will be used by Integrator::error_handler and can be useful to distinguish
+		 * the warning messages of several Integrator objects used in parallel.
+		 */
+		Integrator (const BatchIntegrand<DimFix, DimInt>& batchFunc, const Algorithm& alg, const std::string& identifier = "");
+		
 		/**
 		 * Copy-constructor taking care of properly copying the integration Algorithm pointed to by Integrator::Alg
 		 * from the Integrator \a otherIntegrator.
@@ -173,6 +207,66 @@ namespace MultiDimInt
 		 */
 		void integrate_without_warning (const Arguments<DimFix>& argsFix, const Arguments<DimInt>& lowerBounds, const Arguments<DimInt>& uppperBounds, double& value, double& error) const;
 		
+		/**
+		 * Refines the last integral performed by this Integrator, i.e. integrates again over the same hypercube for fixed
+		 * arguments \a argsFix, but with the tighter absolute and relative error limits \a absErr and \a relErr and at most
+		 * \a extraEval further integrand evaluations, and writes the result into \a value and its estimated absolute error
+		 * into \a error. Algorithms that keep the state of their last integration, like HAdaptiveCubatureAlgorithm, continue
+		 * from that state instead of starting over, whereas all others simply repeat the integration with the new error
+		 * limits (see Algorithm::refine). If \a argsFix differ from the fixed arguments of the last integral, the state of
+		 * that integral is used as the starting point for the new ones. If the integration succeeds, it returns \c true.
+		 * Otherwise it returns \c false and also calls Integrator::error_handler.
+		 */
+		bool refine (const Arguments<DimFix>& argsFix, double absErr, double relErr, std::size_t extraEval, double& value, double& error) const;
+		
+		/**
+		 * Sets the known locations \a peaks of peaks of the integrand, given in the coordinates of the integration variables.
+		 * Before each integration they are mapped onto the unit hypercube by the same change of variables that implements the
+		 * integration boundaries and passed to the integration Algorithm via Algorithm::set_given_points, skipping all peaks
+		 * that lie outside of the integration region. Algorithms that can make use of such points, e.g. CubaDivonneAlgorithm,
+		 * sample the integrand there first, while all others ignore them. An empty vector removes all peaks. As the mapped
+		 * peaks are passed on to the Algorithm whenever they change, an Integrator with peaks must not be used by several
+		 * threads at once with different integration boundaries.
+		 */
+		void set_peaks (const std::vector<Arguments<DimInt>>& peaks);
+		
+		/**
+		 * Sets the time limit \a timeLimit in seconds of each following integration, where 0 means no time limit. Once it
+		 * has passed, the integration Algorithm stops at its next iteration and returns its estimate so far (see Deadline),
+		 * which does not count as a failure, but is marked by Algorithm::Result::DeadlineReached in Integrator::last_result.
+		 * As the Deadline is passed on to the Algorithm at the start of each integration, an Integrator with a time limit
+		 * must not be used by several threads at once.
+		 */
+		void set_time_limit (double timeLimit);
+		
+		/**
+		 * Sets the CancellationToken \a token, whose cancellation stops all running and following integrations of this
+		 * Integrator in the same way as its time limit.
+		 */
+		void set_cancellation_token (const CancellationToken& token);
+		
+		/**
+		 * Returns the Algorithm::Result of the last integration performed by this Integrator, e.g. to check whether it
+		 * has been stopped by its time limit.
+		 */
+		Algorithm::Result last_result () const;
+		
+		/**
+		 * Sets the function \a callback that is called with the current estimates of the integral and its error, the
+		 * number of integrand evaluations used so far and the elapsed time after each iteration, pass or round of the
+		 * integration Algorithm (see ProgressMonitor), e.g. to tune its parameters or to cancel an integration that
+		 * converges too slowly. Cuba algorithms report only their final result, as they have no hook between their
+		 * iterations, and those of Cubature and the nested GSL algorithms report nothing. An empty function removes the
+		 * callback. As for the time limit, an Integrator with a callback must not be used by several threads at once.
+		 */
+		void set_progress_callback (const ProgressMonitor::Callback& callback);
+		
+		/**
+		 * Switches the recording of the convergence history on or off, depending on \a recordHistory. If it is switched
+		 * on, the progress reported during each integration is stored in Algorithm::Result::History of Integrator::last_result.
+		 */
+		void set_history_recording (bool recordHistory);
+		
 		/**
 		 * Assignment operator taking care of properly copying the integration Algorithm pointed to by Integrator::Alg from
 		 * the Integrator \a otherIntegrator.
@@ -190,6 +284,11 @@ namespace MultiDimInt
 		 */
 		Integrand<DimFix, DimInt> Func;
 		
+		/**
+		 * Function that shall be integrated if it evaluates whole batches of points, which is empty otherwise.
+		 */
+		BatchIntegrand<DimFix, DimInt> BatchFunc;
+		
 		/**
 		 * Pointer to the integration Algorithm.
 		 */
@@ -219,6 +318,50 @@ namespace MultiDimInt
 		 */
 		std::string Identifier;
 		
+		/**
+		 * Known peak locations of the integrand, see Integrator::set_peaks.
+		 */
+		std::vector<Arguments<DimInt>> Peaks;
+		
+		/**
+		 * Peak locations on the unit hypercube last passed on to the integration Algorithm, see Integrator::pass_given_points,
+		 * and the mutex guarding them.
+		 */
+		mutable std::vector<double> GivenPoints;
+		mutable std::mutex GivenPointsMutex;
+		
+		/**
+		 * Whether the last integral was performed over the hypercube specified by \a LowerBounds and \a UpperBounds or
+		 * over the unit hypercube, and the sign flip due to swapped integration boundaries, which is 0 if the last integral
+		 * was exact 0. They are used by Integrator::refine and have to be \c mutable, as they are set by Integrator::integrate
+		 * together with Integrator::LastResult while guarded by Integrator::LastResultMutex.
+		 */
+		mutable bool LastCustomBounds;
+		mutable double LastSignFlip;
+		
+		/**
+		 * Time limit of each integration in seconds, where 0 means no time limit, see Integrator::set_time_limit.
+		 */
+		double TimeLimit;
+		
+		/**
+		 * Token whose cancellation stops the integrations, see Integrator::set_cancellation_token.
+		 */
+		CancellationToken Token;
+		
+		/**
+		 * Monitor receiving the progress of the integrations, which is empty unless there is a progress callback or the
+		 * convergence history is recorded, see Integrator::set_progress_callback.
+		 */
+		std::shared_ptr<ProgressMonitor> Monitor;
+		
+		/**
+		 * Result of the last integration, see Integrator::last_result, and the mutex guarding it, as the integrate methods
+		 * may be called by several threads at once, e.g. for the inner integrals of a nested integration.
+		 */
+		mutable Algorithm::Result LastResult;
+		mutable std::mutex LastResultMutex;
+		
 		/**
 		 * Is called when the integration run performed by Integrator::integrate(double& value, double& error) const or
 		 * Integrator::integrate(const Arguments<DimInt>& lowerBounds, const Arguments<DimInt>& uppperBounds, double& value, double& error) const
@@ -240,6 +383,100 @@ namespace MultiDimInt
 		 * and \a UpperBounds.
 		 */
 		double algorithm_internal_integrand_for_custom_hypercube (const double* dummyArgsFix, const double* argsInt) const;
+		
+		/**
+		 * Wrapper for Integrator::BatchFunc that provides the form of the integrand expected by an integration Algorithm,
+		 * i.e. an Algorithm::InternalBatchIntegrand, if the integral shall be performed over the unit hypercube.
+		 */
+		void algorithm_internal_batch_integrand_for_unit_hypercube (const double* dummyArgsFix, std::size_t numPoints, const double* argsInt, double* values) const;
+		
+		/**
+		 * Wrapper for Integrator::BatchFunc that provides the form of the integrand expected by an integration Algorithm,
+		 * i.e. an Algorithm::InternalBatchIntegrand, if the integral shall be performed over the hypercube specified by
+		 * \a LowerBounds and \a UpperBounds.
+		 */
+		void algorithm_internal_batch_integrand_for_custom_hypercube (const double* dummyArgsFix, std::size_t numPoints, const double* argsInt, double* values) const;
+		
+		/**
+		 * Maps the point \a argsInt on the unit hypercube onto the hypercube specified by \a LowerBounds and \a UpperBounds,
+		 * writes the result into \a argsIntStd and returns the Jacobian of this change of variables.
+		 */
+		double map_to_custom_hypercube (const double* argsInt, Arguments<DimInt>& argsIntStd) const;
+		
+		/**
+		 * Runs the integration Algorithm pointed to by Integrator::Alg for fixed arguments \a argsFix either over the unit
+		 * hypercube or, if \a customBounds is \c true, over the hypercube specified by \a LowerBounds and \a UpperBounds,
+		 * after passing the peaks Integrator::Peaks on to it. It
+		 * remembers the integration region and the sign flip \a signFlip due to swapped boundaries for Integrator::refine.
+		 */
+		Algorithm::Result run_algorithm (const Arguments<DimFix>& argsFix, bool customBounds, double signFlip) const;
+		
+		/**
+		 * Calls \a runAlgorithm, which runs the integration Algorithm pointed to by Integrator::Alg, with the algorithm
+		 * internal integrand \a func and batch integrand \a batchFunc, which is empty if there is no batch integrand, and
+		 * returns its Algorithm::Result. If tracing is switched on (see Trace), both integrands are wrapped to count the
+		 * integrand evaluations and to pass the nesting depth on to integrations performed by the integrand, and a
+		 * Trace::Record of the integration with error limits \a absErr and \a relErr is written. The call is surrounded by the
+		 * tracepoints integration__start and integration__done (see Tracepoints.hpp).
+		 */
+		Algorithm::Result traced_run (const std::function<Algorithm::Result(const Algorithm::InternalIntegrand& func, const Algorithm::InternalBatchIntegrand& batchFunc)>& runAlgorithm,
+									  const Algorithm::InternalIntegrand& func, const Algorithm::InternalBatchIntegrand& batchFunc, double absErr, double relErr) const;
+		
+		/**
+		 * Returns the Algorithm::Context of the integration Algorithm pointed to by Integrator::Alg with the Deadline
+		 * \a deadline.
+		 */
+		Algorithm::Context algorithm_context (const Deadline& deadline) const;
+		
+		/**
+		 * Passes a new Deadline, starting now, on to the integration Algorithm pointed to by Integrator::Alg if the
+		 * Integrator has a time limit, and restarts the clock of its ProgressMonitor.
+		 */
+		void start_integration () const;
+		
+		/**
+		 * Stores the Algorithm::Result \a integral, with its value corrected by the sign flip \a signFlip due to swapped
+		 * boundaries, together with the recorded convergence history, as the result of the last integration, and remembers
+		 * its integration region \a customBounds and \a signFlip for refine.
+		 */
+		void store_last_result (const Algorithm::Result& integral, bool customBounds, double signFlip) const;
+		
+		/**
+		 * Returns the result of the last integration and writes its integration region and sign flip into \a customBounds
+		 * and \a signFlip, all read at once.
+		 */
+		Algorithm::Result last_result (bool& customBounds, double& signFlip) const;
+		
+		/**
+		 * Returns the coordinate on the unit interval that the algorithm internal integrand maps onto the value \a arg of
+		 * the integration variable with index \a i_argInt, i.e. the inverse of the change of variables performed by
+		 * Integrator::algorithm_internal_integrand_for_custom_hypercube if \a customBounds is \c true, and \a arg itself otherwise.
+		 */
+		double unit_hypercube_coordinate (double arg, std::size_t i_argInt, bool customBounds) const;
+		
+		/**
+		 * Returns the peaks Integrator::Peaks that lie inside the integration region, mapped onto the unit hypercube and
+		 * concatenated into a single vector as expected by Algorithm::set_given_points.
+		 */
+		std::vector<double> given_points (bool customBounds) const;
+		
+		/**
+		 * Passes the peaks Integrator::Peaks, mapped onto the unit hypercube by Integrator::given_points, on to the integration
+		 * Algorithm pointed to by Integrator::Alg if they differ from Integrator::GivenPoints.
+		 */
+		void pass_given_points (bool customBounds) const;
+		
+		/**
+		 * Returns the peak locations Integrator::GivenPoints last passed on to the integration Algorithm.
+		 */
+		std::vector<double> passed_given_points () const;
+		
+		/**
+		 * Returns the flags telling for each integration variable whether its lower and upper bound on the unit hypercube
+		 * correspond to an infinite bound, as expected by Algorithm::set_infinite_bounds, which are empty if \a customBounds
+		 * is \c false.
+		 */
+		std::vector<bool> infinite_bounds (bool customBounds) const;
 	};
 	
 	/**
@@ -285,6 +522,16 @@ namespace MultiDimInt
 		template <class Class>
 		Integrator (const ConstMemberIntegrandWithoutFixedArgumentsPointer<DimInt, Class> constMemberFuncPointer, const Class& constObject, const Algorithm& alg, const std::string& identifier = "");
 		
+		/**
+		 * Constructor instantiating an integrator that integrates over all \a \DimInt variables of the
+		 * MultiDimInt::BatchIntegrandWithoutFixedArguments \a batchFunc, using the integration Algorithm \a alg. Algorithms
+		 * that sample the integrand in batches pass these batches on to \a batchFunc in one call (see Algorithm::run_batch),
+		 * while all others call it for one point at a time. Furthermore, one can provide an optional \c string \a identifier
+		 * that will be used by Integrator<0, DimInt>::error_handler and can be useful to distinguish the warning messages of
+		 * several Integrator<0, DimInt> objects used in parallel.
+		 */
+		Integrator (const BatchIntegrandWithoutFixedArguments<DimInt>& batchFunc, const Algorithm& alg, const std::string& identifier = "");
+		
 		/**
 		 * Copy-constructor taking care of properly copying the integration Algorithm pointed to by Integrator<0, DimInt>::Alg
 		 * from the Integrator<0, DimInt> \a otherIntegrator.
@@ -332,6 +579,65 @@ namespace MultiDimInt
 		 */
 		void integrate_without_warning (const Arguments<DimInt>& lowerBounds, const Arguments<DimInt>& uppperBounds, double& value, double& error) const;
 		
+		/**
+		 * Refines the last integral performed by this Integrator<0, DimInt>, i.e. integrates again over the same hypercube,
+		 * but with the tighter absolute and relative error limits \a absErr and \a relErr and at most \a extraEval further
+		 * integrand evaluations, and writes the result into \a value and its estimated absolute error into \a error.
+		 * Algorithms that keep the state of their last integration, like HAdaptiveCubatureAlgorithm, continue from that
+		 * state instead of starting over, whereas all others simply repeat the integration with the new error limits (see
+		 * Algorithm::refine). If the integration succeeds, it returns \c true. Otherwise it returns \c false and also calls
+		 * Integrator<0, DimInt>::error_handler.
+		 */
+		bool refine (double absErr, double relErr, std::size_t extraEval, double& value, double& error) const;
+		
+		/**
+		 * Sets the known locations \a peaks of peaks of the integrand, given in the coordinates of the integration variables.
+		 * Before each integration they are mapped onto the unit hypercube by the same change of variables that implements the
+		 * integration boundaries and passed to the integration Algorithm via Algorithm::set_given_points, skipping all peaks
+		 * that lie outside of the integration region. Algorithms that can make use of such points, e.g. CubaDivonneAlgorithm,
+		 * sample the integrand there first, while all others ignore them. An empty vector removes all peaks. As the mapped
+		 * peaks are passed on to the Algorithm whenever they change, an Integrator with peaks must not be used by several
+		 * threads at once with different integration boundaries.
+		 */
+		void set_peaks (const std::vector<Arguments<DimInt>>& peaks);
+		
+		/**
+		 * Sets the time limit \a timeLimit in seconds of each following integration, where 0 means no time limit. Once it
+		 * has passed, the integration Algorithm stops at its next iteration and returns its estimate so far (see Deadline),
+		 * which does not count as a failure, but is marked by Algorithm::Result::DeadlineReached in Integrator<0, DimInt>::last_result.
+		 * As the Deadline is passed on to the Algorithm at the start of each integration, an Integrator<0, DimInt> with a time limit
+		 * must not be used by several threads at once.
+		 */
+		void set_time_limit (double timeLimit);
+		
+		/**
+		 * Sets the CancellationToken \a token, whose cancellation stops all running and following integrations of this
+		 * Integrator<0, DimInt> in the same way as its time limit.
+		 */
+		void set_cancellation_token (const CancellationToken& token);
+		
+		/**
+		 * Returns the Algorithm::Result of the last integration performed by this Integrator<0, DimInt>, e.g. to check whether it
+		 * has been stopped by its time limit.
+		 */
+		Algorithm::Result last_result () const;
+		
+		/**
+		 * Sets the function \a callback that is called with the current estimates of the integral and its error, the
+		 * number of integrand evaluations used so far and the elapsed time after each iteration, pass or round of the
+		 * integration Algorithm (see ProgressMonitor), e.g. to tune its parameters or to cancel an integration that
+		 * converges too slowly. Cuba algorithms report only their final result, as they have no hook between their
+		 * iterations, and those of Cubature and the nested GSL algorithms report nothing. An empty function removes the
+		 * callback. As for the time limit, an Integrator with a callback must not be used by several threads at once.
+		 */
+		void set_progress_callback (const ProgressMonitor::Callback& callback);
+		
+		/**
+		 * Switches the recording of the convergence history on or off, depending on \a recordHistory. If it is switched
+		 * on, the progress reported during each integration is stored in Algorithm::Result::History of Integrator<0, DimInt>::last_result.
+		 */
+		void set_history_recording (bool recordHistory);
+		
 		/**
 		 * Assignment operator taking care of properly copying the integration Algorithm pointed to by Integrator<0, DimInt>::Alg
 		 * from the Integrator<0, DimInt> \a otherIntegrator.
@@ -349,6 +655,11 @@ namespace MultiDimInt
 		 */
 		IntegrandWithoutFixedArguments<DimInt> Func;
 		
+		/**
+		 * Function that shall be integrated if it evaluates whole batches of points, which is empty otherwise.
+		 */
+		BatchIntegrandWithoutFixedArguments<DimInt> BatchFunc;
+		
 		/**
 		 * Pointer to the integration Algorithm.
 		 */
@@ -378,6 +689,50 @@ namespace MultiDimInt
 		 */
 		std::string Identifier;
 		
+		/**
+		 * Known peak locations of the integrand, see Integrator<0, DimInt>::set_peaks.
+		 */
+		std::vector<Arguments<DimInt>> Peaks;
+		
+		/**
+		 * Peak locations on the unit hypercube last passed on to the integration Algorithm, see
+		 * Integrator<0, DimInt>::pass_given_points, and the mutex guarding them.
+		 */
+		mutable std::vector<double> GivenPoints;
+		mutable std::mutex GivenPointsMutex;
+		
+		/**
+		 * Whether the last integral was performed over the hypercube specified by \a LowerBounds and \a UpperBounds or
+		 * over the unit hypercube, and the sign flip due to swapped integration boundaries, which is 0 if the last integral
+		 * was exact 0. They are used by Integrator<0, DimInt>::refine and have to be \c mutable, as they are set by Integrator<0, DimInt>::integrate
+		 * together with Integrator<0, DimInt>::LastResult while guarded by Integrator<0, DimInt>::LastResultMutex.
+		 */
+		mutable bool LastCustomBounds;
+		mutable double LastSignFlip;
+		
+		/**
+		 * Time limit of each integration in seconds, where 0 means no time limit, see Integrator<0, DimInt>::set_time_limit.
+		 */
+		double TimeLimit;
+		
+		/**
+		 * Token whose cancellation stops the integrations, see Integrator<0, DimInt>::set_cancellation_token.
+		 */
+		CancellationToken Token;
+		
+		/**
+		 * Monitor receiving the progress of the integrations, which is empty unless there is a progress callback or the
+		 * convergence history is recorded, see Integrator<0, DimInt>::set_progress_callback.
+		 */
+		std::shared_ptr<ProgressMonitor> Monitor;
+		
+		/**
+		 * Result of the last integration, see Integrator<0, DimInt>::last_result, and the mutex guarding it, as the integrate methods
+		 * may be called by several threads at once, e.g. for the inner integrals of a nested integration.
+		 */
+		mutable Algorithm::Result LastResult;
+		mutable std::mutex LastResultMutex;
+		
 		/**
 		 * Is called when the integration run performed by Integrator<0, DimInt>::integrate(double& value, double& error) const or
 		 * Integrator<0, DimInt>::integrate(const Arguments<DimInt>& lowerBounds, const Arguments<DimInt>& uppperBounds, double& value, double& error) const
@@ -399,6 +754,101 @@ namespace MultiDimInt
 		 * and \a UpperBounds.
 		 */
 		double algorithm_internal_integrand_for_custom_hypercube (const double* dummyArgsFix, const double* argsInt) const;
+		
+		/**
+		 * Wrapper for Integrator<0, DimInt>::BatchFunc that provides the form of the integrand expected by an integration Algorithm,
+		 * i.e. an Algorithm::InternalBatchIntegrand, if the integral shall be performed over the unit hypercube.
+		 */
+		void algorithm_internal_batch_integrand_for_unit_hypercube (const double* dummyArgsFix, std::size_t numPoints, const double* argsInt, double* values) const;
+		
+		/**
+		 * Wrapper for Integrator<0, DimInt>::BatchFunc that provides the form of the integrand expected by an integration Algorithm,
+		 * i.e. an Algorithm::InternalBatchIntegrand, if the integral shall be performed over the hypercube specified by
+		 * \a LowerBounds and \a UpperBounds.
+		 */
+		void algorithm_internal_batch_integrand_for_custom_hypercube (const double* dummyArgsFix, std::size_t numPoints, const double* argsInt, double* values) const;
+		
+		/**
+		 * Maps the point \a argsInt on the unit hypercube onto the hypercube specified by \a LowerBounds and \a UpperBounds,
+		 * writes the result into \a argsIntStd and returns the Jacobian of this change of variables.
+		 */
+		double map_to_custom_hypercube (const double* argsInt, Arguments<DimInt>& argsIntStd) const;
+		
+		/**
+		 * Runs the integration Algorithm pointed to by Integrator<0, DimInt>::Alg either over the unit hypercube or, if
+		 * \a customBounds is \c true, over the hypercube specified by \a LowerBounds and \a UpperBounds, after passing the
+		 * peaks Integrator<0, DimInt>::Peaks on to it. It remembers the integration region and the sign flip \a signFlip
+		 * due to swapped boundaries for Integrator<0, DimInt>::refine.
+		 */
+		Algorithm::Result run_algorithm (bool customBounds, double signFlip) const;
+		
+		/**
+		 * Calls \a runAlgorithm, which runs the integration Algorithm pointed to by Integrator<0, DimInt>::Alg, with the algorithm
+		 * internal integrand \a func and batch integrand \a batchFunc, which is empty if there is no batch integrand, and
+		 * returns its Algorithm::Result. If tracing is switched on (see Trace), both integrands are wrapped to count the
+		 * integrand evaluations and to pass the nesting depth on to integrations performed by the integrand, and a
+		 * Trace::Record of the integration with error limits \a absErr and \a relErr is written. The call is surrounded by the
+		 * tracepoints integration__start and integration__done (see Tracepoints.hpp).
+		 */
+		Algorithm::Result traced_run (const std::function<Algorithm::Result(const Algorithm::InternalIntegrand& func, const Algorithm::InternalBatchIntegrand& batchFunc)>& runAlgorithm,
+									  const Algorithm::InternalIntegrand& func, const Algorithm::InternalBatchIntegrand& batchFunc, double absErr, double relErr) const;
+		
+		/**
+		 * Returns the Algorithm::Context of the integration Algorithm pointed to by Integrator<0, DimInt>::Alg with the Deadline
+		 * \a deadline.
+		 */
+		Algorithm::Context algorithm_context (const Deadline& deadline) const;
+		
+		/**
+		 * Passes a new Deadline, starting now, on to the integration Algorithm pointed to by Integrator<0, DimInt>::Alg if the
+		 * Integrator<0, DimInt> has a time limit, and restarts the clock of its ProgressMonitor.
+		 */
+		void start_integration () const;
+		
+		/**
+		 * Stores the Algorithm::Result \a integral, with its value corrected by the sign flip \a signFlip due to swapped
+		 * boundaries, together with the recorded convergence history, as the result of the last integration, and remembers
+		 * its integration region \a customBounds and \a signFlip for refine.
+		 */
+		void store_last_result (const Algorithm::Result& integral, bool customBounds, double signFlip) const;
+		
+		/**
+		 * Returns the result of the last integration and writes its integration region and sign flip into \a customBounds
+		 * and \a signFlip, all read at once.
+		 */
+		Algorithm::Result last_result (bool& customBounds, double& signFlip) const;
+		
+		/**
+		 * Returns the coordinate on the unit interval that the algorithm internal integrand maps onto the value \a arg of
+		 * the integration variable with index \a i_argInt, i.e. the inverse of the change of variables performed by
+		 * Integrator<0, DimInt>::algorithm_internal_integrand_for_custom_hypercube if \a customBounds is \c true, and \a arg itself otherwise.
+		 */
+		double unit_hypercube_coordinate (double arg, std::size_t i_argInt, bool customBounds) const;
+		
+		/**
+		 * Returns the peaks Integrator<0, DimInt>::Peaks that lie inside the integration region, mapped onto the unit hypercube and
+		 * concatenated into a single vector as expected by Algorithm::set_given_points.
+		 */
+		std::vector<double> given_points (bool customBounds) const;
+		
+		/**
+		 * Passes the peaks Integrator<0, DimInt>::Peaks, mapped onto the unit hypercube by Integrator<0, DimInt>::given_points,
+		 * on to the integration Algorithm pointed to by Integrator<0, DimInt>::Alg if they differ from
+		 * Integrator<0, DimInt>::GivenPoints.
+		 */
+		void pass_given_points (bool customBounds) const;
+		
+		/**
+		 * Returns the peak locations Integrator<0, DimInt>::GivenPoints last passed on to the integration Algorithm.
+		 */
+		std::vector<double> passed_given_points () const;
+		
+		/**
+		 * Returns the flags telling for each integration variable whether its lower and upper bound on the unit hypercube
+		 * correspond to an infinite bound, as expected by Algorithm::set_infinite_bounds, which are empty if \a customBounds
+		 * is \c false.
+		 */
+		std::vector<bool> infinite_bounds (bool customBounds) const;
 	};
 }
 
@@ -1,12 +1,15 @@
 #include "BindMemberFunction.hpp"
 
 #include <array>
+#include <chrono>
 #include <cmath>
 
 #include <cstring>
 
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // public
@@ -14,53 +17,138 @@
 template <std::size_t DimFix, std::size_t DimInt>
 MultiDimInt::Integrator<DimFix, DimInt>::Integrator (const Integrand<DimFix, DimInt>& func, const Algorithm& alg, const std::string& identifier) :
 	Func(func),
+	BatchFunc(),
 	Alg(alg.clone()),
 	LowerBounds(),
 	UpperBounds(),
-	Identifier(identifier)
+	Identifier(identifier),
+	Peaks(),
+	GivenPoints(),
+	GivenPointsMutex(),
+	LastCustomBounds(false),
+	LastSignFlip(1.0),
+	TimeLimit(0.0),
+	Token(),
+	Monitor(),
+	LastResult{false, 0.0, 0.0, ""},
+	LastResultMutex()
 {
 	static_assert(DimInt != 0, "MultiDimInt::Integrator Error: Number of integration variables is zero");
+	
+	Alg->set_context({Identifier, DimFix});
 }
 
 template <std::size_t DimFix, std::size_t DimInt>
 template <class Class>
 MultiDimInt::Integrator<DimFix, DimInt>::Integrator (const MemberIntegrandPointer<DimFix, DimInt, Class> memberFuncPointer, Class& object, const Algorithm& alg, const std::string& identifier) :
 	Func(bind_member_function_to_object(memberFuncPointer, object)),
+	BatchFunc(),
 	Alg(alg.clone()),
 	LowerBounds(),
 	UpperBounds(),
-	Identifier(identifier)
+	Identifier(identifier),
+	Peaks(),
+	GivenPoints(),
+	GivenPointsMutex(),
+	LastCustomBounds(false),
+	LastSignFlip(1.0),
+	TimeLimit(0.0),
+	Token(),
+	Monitor(),
+	LastResult{false, 0.0, 0.0, ""},
+	LastResultMutex()
 {
 	static_assert(DimInt != 0, "MultiDimInt::Integrator Error: Number of integration variables is zero");
+	
+	Alg->set_context({Identifier, DimFix});
 }
 
 template <std::size_t DimFix, std::size_t DimInt>
 template <class Class>
 MultiDimInt::Integrator<DimFix, DimInt>::Integrator (const ConstMemberIntegrandPointer<DimFix, DimInt, Class> constMemberFuncPointer, const Class& constObject, const Algorithm& alg, const std::string& identifier) :
 	Func(bind_member_function_to_object(constMemberFuncPointer, constObject)),
+	BatchFunc(),
+	Alg(alg.clone()),
+	LowerBounds(),
+	UpperBounds(),
+	Identifier(identifier),
+	Peaks(),
+	GivenPoints(),
+	GivenPointsMutex(),
+	LastCustomBounds(false),
+	LastSignFlip(1.0),
+	TimeLimit(0.0),
+	Token(),
+	Monitor(),
+	LastResult{false, 0.0, 0.0, ""},
+	LastResultMutex()
+{
+	static_assert(DimInt != 0, "MultiDimInt::Integrator Error: Number of integration variables is zero");
+	
+	Alg->set_context({Identifier, DimFix});
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+MultiDimInt::Integrator<DimFix, DimInt>::Integrator (const BatchIntegrand<DimFix, DimInt>& batchFunc, const Algorithm& alg, const std::string& identifier) :
+	Func([batchFunc] (const Arguments<DimFix>& argsFix, const Arguments<DimInt>& argsInt)	// evaluate the batch integrand for single points, which is needed by Algorithms that do not sample in batches
+		{
+			double value;
+			
+			batchFunc(argsFix, 1, &argsInt, &value);
+			
+			return value;
+		}),
+	BatchFunc(batchFunc),
 	Alg(alg.clone()),
 	LowerBounds(),
 	UpperBounds(),
-	Identifier(identifier)
+	Identifier(identifier),
+	Peaks(),
+	GivenPoints(),
+	GivenPointsMutex(),
+	LastCustomBounds(false),
+	LastSignFlip(1.0),
+	TimeLimit(0.0),
+	Token(),
+	Monitor(),
+	LastResult{false, 0.0, 0.0, ""},
+	LastResultMutex()
 {
 	static_assert(DimInt != 0, "MultiDimInt::Integrator Error: Number of integration variables is zero");
+	
+	Alg->set_context({Identifier, DimFix});
 }
 
 template <std::size_t DimFix, std::size_t DimInt>
 MultiDimInt::Integrator<DimFix, DimInt>::Integrator (const Integrator& otherIntegrator) :
 	Func(otherIntegrator.Func),
+	BatchFunc(otherIntegrator.BatchFunc),
 	Alg(otherIntegrator.Alg->clone()),
 	LowerBounds(otherIntegrator.LowerBounds),
 	UpperBounds(otherIntegrator.UpperBounds),
-	Identifier(otherIntegrator.Identifier)
+	Identifier(otherIntegrator.Identifier),
+	Peaks(otherIntegrator.Peaks),
+	GivenPoints(otherIntegrator.passed_given_points()),
+	GivenPointsMutex(),
+	LastCustomBounds(false),
+	LastSignFlip(1.0),
+	TimeLimit(otherIntegrator.TimeLimit),
+	Token(otherIntegrator.Token),
+	Monitor(otherIntegrator.Monitor ? std::make_shared<ProgressMonitor>(*otherIntegrator.Monitor) : nullptr),	// the copy records its own history
+	LastResult(),
+	LastResultMutex()
 {
 	static_assert(DimInt != 0, "MultiDimInt::Integrator Error: Number of integration variables is zero");
+	
+	LastResult = otherIntegrator.last_result(LastCustomBounds, LastSignFlip);	// read together with the integration region and sign flip of the last integration
+	
+	Alg->set_context(algorithm_context(Deadline(Token)));	// the cloned Algorithm would otherwise report to the ProgressMonitor of otherIntegrator
 }
 
 template <std::size_t DimFix, std::size_t DimInt>
 bool MultiDimInt::Integrator<DimFix, DimInt>::integrate (const std::array<double, DimFix>& argsFix, double& value, double& error) const
 {
-	Algorithm::Result integral = Alg->run(bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_unit_hypercube, *this), DimInt, argsFix.data());	// the 'bind_member_function_to_object' is needed to pass the member function Integrator< DimFix, DimInt >::algorithm_internal_integrand_for_unit_hypercube as a MultiDimInt::Algorithm::InternalIntegrand
+	Algorithm::Result integral = run_algorithm(argsFix, false, 1.0);
 	
 	value = integral.Value;
 	error = integral.Error;
@@ -92,6 +180,8 @@ bool MultiDimInt::Integrator<DimFix, DimInt>::integrate (const std::array<double
 			value = 0.0;
 			error = 0.0;
 			
+			store_last_result(Algorithm::Result{false, 0.0, 0.0, ""}, true, 0.0);
+			
 			return true;
 		}
 		
@@ -109,7 +199,7 @@ bool MultiDimInt::Integrator<DimFix, DimInt>::integrate (const std::array<double
 		}
 	}
 	
-	Algorithm::Result integral = Alg->run(bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_custom_hypercube, *this), DimInt, argsFix.data());	// the 'bind_member_function_to_object' is needed to pass the member function Integrator< DimFix, DimInt >::algorithm_internal_integrand_for_custom_hypercube as a MultiDimInt::Algorithm::InternalIntegrand
+	Algorithm::Result integral = run_algorithm(argsFix, true, signFlip);
 	
 	integral.Value *= signFlip;	// correct the value of the integral by the overall sign flip due to swapping lower and upper integration boundaries
 	
@@ -131,7 +221,7 @@ bool MultiDimInt::Integrator<DimFix, DimInt>::integrate (const std::array<double
 template <std::size_t DimFix, std::size_t DimInt>
 void MultiDimInt::Integrator<DimFix, DimInt>::integrate_without_warning (const std::array<double, DimFix>& argsFix, double& value, double& error) const
 {
-	Algorithm::Result integral = Alg->run(bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_unit_hypercube, *this), DimInt, argsFix.data());	// the 'bind_member_function_to_object' is needed to pass the member function Integrator< DimFix, DimInt >::algorithm_internal_integrand_for_unit_hypercube as a MultiDimInt::Algorithm::InternalIntegrand
+	Algorithm::Result integral = run_algorithm(argsFix, false, 1.0);
 	
 	value = integral.Value;
 	error = integral.Error;
@@ -167,20 +257,148 @@ void MultiDimInt::Integrator<DimFix, DimInt>::integrate_without_warning (const s
 		}
 	}
 	
-	Algorithm::Result integral = Alg->run(bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_custom_hypercube, *this), DimInt, argsFix.data());	// the 'bind_member_function_to_object' is needed to pass the member function Integrator< DimFix, DimInt >::algorithm_internal_integrand_for_custom_hypercube as a MultiDimInt::Algorithm::InternalIntegrand
+	Algorithm::Result integral = run_algorithm(argsFix, true, signFlip);
 	
 	value = integral.Value *= signFlip;	// correct the value of the integral by the overall sign flip due to swapping lower and upper integration boundaries
 	error = integral.Error;
 }
 
+template <std::size_t DimFix, std::size_t DimInt>
+bool MultiDimInt::Integrator<DimFix, DimInt>::refine (const std::array<double, DimFix>& argsFix, const double absErr, const double relErr, const std::size_t extraEval, double& value, double& error) const
+{
+	bool customBounds;
+	double signFlip;
+	
+	last_result(customBounds, signFlip);	// the integration region and sign flip of the last integration, which may have been performed by another thread
+	
+	Algorithm::Result integral{false, 0.0, 0.0, ""};	// if the last integral was exact 0 due to equal integration boundaries, so is its refinement
+	
+	if ( signFlip != 0.0 )
+	{
+		start_integration();
+		
+		const Algorithm::InternalIntegrand func = customBounds ? bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_custom_hypercube, *this)
+															   : bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_unit_hypercube, *this);
+		
+		auto refineAlgorithm = [&] (const Algorithm::InternalIntegrand& func, const Algorithm::InternalBatchIntegrand& batchFunc)
+		{
+			return Alg->refine(func, DimInt, argsFix.data(), absErr, relErr, extraEval);
+		};
+		
+		integral = traced_run(refineAlgorithm, func, Algorithm::InternalBatchIntegrand(), absErr, relErr);
+	}
+	
+	store_last_result(integral, customBounds, signFlip);
+	
+	integral.Value *= signFlip;	// correct the value of the integral by the sign flip of the last integration
+	
+	value = integral.Value;
+	error = integral.Error;
+	
+	if ( integral.Failed )	// if integration fails, call error handler and return 'false'
+	{
+		error_handler(argsFix, integral);
+		
+		return false;
+	}
+	else	// if integration succeeds, return 'true'
+	{
+		return true;
+	}
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+void MultiDimInt::Integrator<DimFix, DimInt>::set_peaks (const std::vector<Arguments<DimInt>>& peaks)
+{
+	Peaks = peaks;
+	GivenPoints = given_points(false);	// positions for integrations over the unit hypercube, which are passed on anew by run_algorithm if the integration boundaries differ
+	
+	Alg->set_given_points(GivenPoints);
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+void MultiDimInt::Integrator<DimFix, DimInt>::set_time_limit (const double timeLimit)
+{
+	if ( timeLimit < 0.0 )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::Integrator Error: Time limit is negative" << std::endl
+				  << std::endl;
+		
+		exit(EXIT_FAILURE);
+	}
+	
+	TimeLimit = timeLimit;
+	
+	if ( TimeLimit == 0.0 )	// remove the deadline of the last integration
+	{
+		Alg->set_context(algorithm_context(Deadline(Token)));
+	}
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+void MultiDimInt::Integrator<DimFix, DimInt>::set_cancellation_token (const CancellationToken& token)
+{
+	Token = token;
+	
+	Alg->set_context(algorithm_context(Deadline(Token)));
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+MultiDimInt::Algorithm::Result MultiDimInt::Integrator<DimFix, DimInt>::last_result () const
+{
+	std::lock_guard<std::mutex> lock (LastResultMutex);
+	
+	return LastResult;
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+void MultiDimInt::Integrator<DimFix, DimInt>::set_progress_callback (const ProgressMonitor::Callback& callback)
+{
+	const bool recordHistory = Monitor && Monitor->records_history();
+	
+	Monitor = (callback || recordHistory) ? std::make_shared<ProgressMonitor>(callback, recordHistory) : nullptr;
+	
+	Alg->set_context(algorithm_context(Deadline(Token)));
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+void MultiDimInt::Integrator<DimFix, DimInt>::set_history_recording (const bool recordHistory)
+{
+	const ProgressMonitor::Callback callback = Monitor ? Monitor->callback() : ProgressMonitor::Callback();
+	
+	Monitor = (callback || recordHistory) ? std::make_shared<ProgressMonitor>(callback, recordHistory) : nullptr;
+	
+	Alg->set_context(algorithm_context(Deadline(Token)));
+}
+
 template <std::size_t DimFix, std::size_t DimInt>
 MultiDimInt::Integrator<DimFix, DimInt>& MultiDimInt::Integrator<DimFix, DimInt>::operator= (const Integrator& otherIntegrator)
 {
 	Func = otherIntegrator.Func;
+	BatchFunc = otherIntegrator.BatchFunc;
 	*Alg = *(otherIntegrator.Alg);
 	UpperBounds = otherIntegrator.UpperBounds;
 	LowerBounds = otherIntegrator.LowerBounds;
 	Identifier = otherIntegrator.Identifier;
+	Peaks = otherIntegrator.Peaks;
+	GivenPoints = otherIntegrator.passed_given_points();
+	TimeLimit = otherIntegrator.TimeLimit;
+	Token = otherIntegrator.Token;
+	Monitor = otherIntegrator.Monitor ? std::make_shared<ProgressMonitor>(*otherIntegrator.Monitor) : nullptr;
+	
+	Alg->set_context(algorithm_context(Deadline(Token)));	// the copied Algorithm would otherwise report to the ProgressMonitor of otherIntegrator
+	
+	bool customBounds;
+	double signFlip;
+	
+	const Algorithm::Result lastResult = otherIntegrator.last_result(customBounds, signFlip);
+	
+	std::lock_guard<std::mutex> lock (LastResultMutex);
+	
+	LastResult = lastResult;
+	LastCustomBounds = customBounds;
+	LastSignFlip = signFlip;
 	
 	return *this;
 }
@@ -194,45 +412,128 @@ MultiDimInt::Integrator<DimFix, DimInt>::~Integrator ()
 template <std::size_t DimInt>
 MultiDimInt::Integrator<0, DimInt>::Integrator (const IntegrandWithoutFixedArguments<DimInt>& func, const Algorithm& alg, const std::string& identifier) :
 	Func(func),
+	BatchFunc(),
 	Alg(alg.clone()),
 	LowerBounds(),
 	UpperBounds(),
-	Identifier(identifier)
-{}
+	Identifier(identifier),
+	Peaks(),
+	GivenPoints(),
+	GivenPointsMutex(),
+	LastCustomBounds(false),
+	LastSignFlip(1.0),
+	TimeLimit(0.0),
+	Token(),
+	Monitor(),
+	LastResult{false, 0.0, 0.0, ""},
+	LastResultMutex()
+{
+	Alg->set_context({Identifier, 0});
+}
 
 template <std::size_t DimInt>
 template <class Class>
 MultiDimInt::Integrator<0, DimInt>::Integrator (const MemberIntegrandWithoutFixedArgumentsPointer<DimInt, Class> memberFuncPointer, Class& object, const Algorithm& alg, const std::string& identifier) :
 	Func(bind_member_function_to_object(memberFuncPointer, object)),
+	BatchFunc(),
 	Alg(alg.clone()),
 	LowerBounds(),
 	UpperBounds(),
-	Identifier(identifier)
-{}
+	Identifier(identifier),
+	Peaks(),
+	GivenPoints(),
+	GivenPointsMutex(),
+	LastCustomBounds(false),
+	LastSignFlip(1.0),
+	TimeLimit(0.0),
+	Token(),
+	Monitor(),
+	LastResult{false, 0.0, 0.0, ""},
+	LastResultMutex()
+{
+	Alg->set_context({Identifier, 0});
+}
 
 template <std::size_t DimInt>
 template <class Class>
 MultiDimInt::Integrator<0, DimInt>::Integrator (const ConstMemberIntegrandWithoutFixedArgumentsPointer<DimInt, Class> constMemberFuncPointer, const Class& constObject, const Algorithm& alg, const std::string& identifier) :
 	Func(bind_member_function_to_object(constMemberFuncPointer, constObject)),
+	BatchFunc(),
+	Alg(alg.clone()),
+	LowerBounds(),
+	UpperBounds(),
+	Identifier(identifier),
+	Peaks(),
+	GivenPoints(),
+	GivenPointsMutex(),
+	LastCustomBounds(false),
+	LastSignFlip(1.0),
+	TimeLimit(0.0),
+	Token(),
+	Monitor(),
+	LastResult{false, 0.0, 0.0, ""},
+	LastResultMutex()
+{
+	Alg->set_context({Identifier, 0});
+}
+
+template <std::size_t DimInt>
+MultiDimInt::Integrator<0, DimInt>::Integrator (const BatchIntegrandWithoutFixedArguments<DimInt>& batchFunc, const Algorithm& alg, const std::string& identifier) :
+	Func([batchFunc] (const Arguments<DimInt>& argsInt)	// evaluate the batch integrand for single points, which is needed by Algorithms that do not sample in batches
+		{
+			double value;
+			
+			batchFunc(1, &argsInt, &value);
+			
+			return value;
+		}),
+	BatchFunc(batchFunc),
 	Alg(alg.clone()),
 	LowerBounds(),
 	UpperBounds(),
-	Identifier(identifier)
-{}
+	Identifier(identifier),
+	Peaks(),
+	GivenPoints(),
+	GivenPointsMutex(),
+	LastCustomBounds(false),
+	LastSignFlip(1.0),
+	TimeLimit(0.0),
+	Token(),
+	Monitor(),
+	LastResult{false, 0.0, 0.0, ""},
+	LastResultMutex()
+{
+	Alg->set_context({Identifier, 0});
+}
 
 template <std::size_t DimInt>
 MultiDimInt::Integrator<0, DimInt>::Integrator (const Integrator& otherIntegrator) :
 	Func(otherIntegrator.Func),
+	BatchFunc(otherIntegrator.BatchFunc),
 	Alg(otherIntegrator.Alg->clone()),
 	LowerBounds(otherIntegrator.LowerBounds),
 	UpperBounds(otherIntegrator.UpperBounds),
-	Identifier(otherIntegrator.Identifier)
-{}
+	Identifier(otherIntegrator.Identifier),
+	Peaks(otherIntegrator.Peaks),
+	GivenPoints(otherIntegrator.passed_given_points()),
+	GivenPointsMutex(),
+	LastCustomBounds(false),
+	LastSignFlip(1.0),
+	TimeLimit(otherIntegrator.TimeLimit),
+	Token(otherIntegrator.Token),
+	Monitor(otherIntegrator.Monitor ? std::make_shared<ProgressMonitor>(*otherIntegrator.Monitor) : nullptr),	// the copy records its own history
+	LastResult(),
+	LastResultMutex()
+{
+	LastResult = otherIntegrator.last_result(LastCustomBounds, LastSignFlip);	// read together with the integration region and sign flip of the last integration
+	
+	Alg->set_context(algorithm_context(Deadline(Token)));	// the cloned Algorithm would otherwise report to the ProgressMonitor of otherIntegrator
+}
 
 template <std::size_t DimInt>
 bool MultiDimInt::Integrator<0, DimInt>::integrate (double& value, double& error) const
 {
-	Algorithm::Result integral = Alg->run(bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_unit_hypercube, *this), DimInt, NULL);	// the 'bind_member_function_to_object' is needed to pass the member function Integrator< 0, DimInt >::algorithm_internal_integrand_for_unit_hypercube as a MultiDimInt::Algorithm::InternalIntegrand
+	Algorithm::Result integral = run_algorithm(false, 1.0);
 	
 	value = integral.Value;
 	error = integral.Error;
@@ -264,6 +565,8 @@ bool MultiDimInt::Integrator<0, DimInt>::integrate (const Arguments<DimInt>& low
 			value = 0.0;
 			error = 0.0;
 			
+			store_last_result(Algorithm::Result{false, 0.0, 0.0, ""}, true, 0.0);
+			
 			return true;
 		}
 		
@@ -281,7 +584,7 @@ bool MultiDimInt::Integrator<0, DimInt>::integrate (const Arguments<DimInt>& low
 		}
 	}
 	
-	Algorithm::Result integral = Alg->run(bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_custom_hypercube, *this), DimInt, NULL);	// the 'bind_member_function_to_object' is needed to pass the member function Integrator< 0, DimInt >::algorithm_internal_integrand_for_custom_hypercube as a MultiDimInt::Algorithm::InternalIntegrand
+	Algorithm::Result integral = run_algorithm(true, signFlip);
 	
 	integral.Value *= signFlip;	// correct the value of the integral by the overall sign flip due to swapping lower and upper integration boundaries
 	
@@ -303,7 +606,7 @@ bool MultiDimInt::Integrator<0, DimInt>::integrate (const Arguments<DimInt>& low
 template <std::size_t DimInt>
 void MultiDimInt::Integrator<0, DimInt>::integrate_without_warning (double& value, double& error) const
 {
-	Algorithm::Result integral = Alg->run(bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_unit_hypercube, *this), DimInt, NULL);	// the 'bind_member_function_to_object' is needed to pass the member function Integrator< 0, DimInt >::algorithm_internal_integrand_for_unit_hypercube as a MultiDimInt::Algorithm::InternalIntegrand
+	Algorithm::Result integral = run_algorithm(false, 1.0);
 	
 	value = integral.Value;
 	error = integral.Error;
@@ -339,20 +642,148 @@ void MultiDimInt::Integrator<0, DimInt>::integrate_without_warning (const Argume
 		}
 	}
 	
-	Algorithm::Result integral = Alg->run(bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_custom_hypercube, *this), DimInt, NULL);	// the 'bind_member_function_to_object' is needed to pass the member function Integrator< 0, DimInt >::algorithm_internal_integrand_for_custom_hypercube as a MultiDimInt::Algorithm::InternalIntegrand
+	Algorithm::Result integral = run_algorithm(true, signFlip);
 	
 	value = integral.Value * signFlip;	// correct the value of the integral by the overall sign flip due to swapping lower and upper integration boundaries
 	error = integral.Error;
 }
 
+template <std::size_t DimInt>
+bool MultiDimInt::Integrator<0, DimInt>::refine (const double absErr, const double relErr, const std::size_t extraEval, double& value, double& error) const
+{
+	bool customBounds;
+	double signFlip;
+	
+	last_result(customBounds, signFlip);	// the integration region and sign flip of the last integration, which may have been performed by another thread
+	
+	Algorithm::Result integral{false, 0.0, 0.0, ""};	// if the last integral was exact 0 due to equal integration boundaries, so is its refinement
+	
+	if ( signFlip != 0.0 )
+	{
+		start_integration();
+		
+		const Algorithm::InternalIntegrand func = customBounds ? bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_custom_hypercube, *this)
+															   : bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_unit_hypercube, *this);
+		
+		auto refineAlgorithm = [&] (const Algorithm::InternalIntegrand& func, const Algorithm::InternalBatchIntegrand& batchFunc)
+		{
+			return Alg->refine(func, DimInt, NULL, absErr, relErr, extraEval);
+		};
+		
+		integral = traced_run(refineAlgorithm, func, Algorithm::InternalBatchIntegrand(), absErr, relErr);
+	}
+	
+	store_last_result(integral, customBounds, signFlip);
+	
+	integral.Value *= signFlip;	// correct the value of the integral by the sign flip of the last integration
+	
+	value = integral.Value;
+	error = integral.Error;
+	
+	if ( integral.Failed )	// if integration fails, call error handler and return 'false'
+	{
+		error_handler(integral);
+		
+		return false;
+	}
+	else	// if integration succeeds, return 'true'
+	{
+		return true;
+	}
+}
+
+template <std::size_t DimInt>
+void MultiDimInt::Integrator<0, DimInt>::set_peaks (const std::vector<Arguments<DimInt>>& peaks)
+{
+	Peaks = peaks;
+	GivenPoints = given_points(false);	// positions for integrations over the unit hypercube, which are passed on anew by run_algorithm if the integration boundaries differ
+	
+	Alg->set_given_points(GivenPoints);
+}
+
+template <std::size_t DimInt>
+void MultiDimInt::Integrator<0, DimInt>::set_time_limit (const double timeLimit)
+{
+	if ( timeLimit < 0.0 )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::Integrator Error: Time limit is negative" << std::endl
+				  << std::endl;
+		
+		exit(EXIT_FAILURE);
+	}
+	
+	TimeLimit = timeLimit;
+	
+	if ( TimeLimit == 0.0 )	// remove the deadline of the last integration
+	{
+		Alg->set_context(algorithm_context(Deadline(Token)));
+	}
+}
+
+template <std::size_t DimInt>
+void MultiDimInt::Integrator<0, DimInt>::set_cancellation_token (const CancellationToken& token)
+{
+	Token = token;
+	
+	Alg->set_context(algorithm_context(Deadline(Token)));
+}
+
+template <std::size_t DimInt>
+MultiDimInt::Algorithm::Result MultiDimInt::Integrator<0, DimInt>::last_result () const
+{
+	std::lock_guard<std::mutex> lock (LastResultMutex);
+	
+	return LastResult;
+}
+
+template <std::size_t DimInt>
+void MultiDimInt::Integrator<0, DimInt>::set_progress_callback (const ProgressMonitor::Callback& callback)
+{
+	const bool recordHistory = Monitor && Monitor->records_history();
+	
+	Monitor = (callback || recordHistory) ? std::make_shared<ProgressMonitor>(callback, recordHistory) : nullptr;
+	
+	Alg->set_context(algorithm_context(Deadline(Token)));
+}
+
+template <std::size_t DimInt>
+void MultiDimInt::Integrator<0, DimInt>::set_history_recording (const bool recordHistory)
+{
+	const ProgressMonitor::Callback callback = Monitor ? Monitor->callback() : ProgressMonitor::Callback();
+	
+	Monitor = (callback || recordHistory) ? std::make_shared<ProgressMonitor>(callback, recordHistory) : nullptr;
+	
+	Alg->set_context(algorithm_context(Deadline(Token)));
+}
+
 template <std::size_t DimInt>
 MultiDimInt::Integrator<0, DimInt>& MultiDimInt::Integrator<0, DimInt>::operator= (const Integrator& otherIntegrator)
 {
 	Func = otherIntegrator.Func;
+	BatchFunc = otherIntegrator.BatchFunc;
 	*Alg = *(otherIntegrator.Alg);
 	UpperBounds = otherIntegrator.UpperBounds;
 	LowerBounds = otherIntegrator.LowerBounds;
 	Identifier = otherIntegrator.Identifier;
+	Peaks = otherIntegrator.Peaks;
+	GivenPoints = otherIntegrator.passed_given_points();
+	TimeLimit = otherIntegrator.TimeLimit;
+	Token = otherIntegrator.Token;
+	Monitor = otherIntegrator.Monitor ? std::make_shared<ProgressMonitor>(*otherIntegrator.Monitor) : nullptr;
+	
+	Alg->set_context(algorithm_context(Deadline(Token)));	// the copied Algorithm would otherwise report to the ProgressMonitor of otherIntegrator
+	
+	bool customBounds;
+	double signFlip;
+	
+	const Algorithm::Result lastResult = otherIntegrator.last_result(customBounds, signFlip);
+	
+	std::lock_guard<std::mutex> lock (LastResultMutex);
+	
+	LastResult = lastResult;
+	LastCustomBounds = customBounds;
+	LastSignFlip = signFlip;
 	
 	return *this;
 }
@@ -420,9 +851,65 @@ double MultiDimInt::Integrator<DimFix, DimInt>::algorithm_internal_integrand_for
 		argsFixStd[i_argFix] = argsFix[i_argFix];
 	}
 	
+	const double jacobian = map_to_custom_hypercube(argsInt, argsIntStd);	// thereby, perform the changes of variables necessary to implement the integral boundaries 'LowerBounds' and 'UpperBounds'
+	
+	return Func(argsFixStd, argsIntStd) * jacobian;	// call the Integrand 'Func'
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+void MultiDimInt::Integrator<DimFix, DimInt>::algorithm_internal_batch_integrand_for_unit_hypercube (const double* argsFix, const std::size_t numPoints, const double* argsInt, double* values) const
+{
+	std::array<double, DimFix> argsFixStd;	// copy the contents of 'argsFix' and 'argsInt' into a std::array and a std::vector of std::arrays, such that they can be used as arguments of 'BatchFunc'
+	std::vector<Arguments<DimInt>> argsIntStd (numPoints);
+	
+	for ( std::size_t i_argFix = 0; i_argFix < DimFix; ++i_argFix )
+	{
+		argsFixStd[i_argFix] = argsFix[i_argFix];
+	}
+	
+	for ( std::size_t i_point = 0; i_point < numPoints; ++i_point )
+	{
+		for ( std::size_t i_argInt = 0; i_argInt < DimInt; ++i_argInt )
+		{
+			argsIntStd[i_point][i_argInt] = argsInt[i_point*DimInt + i_argInt];
+		}
+	}
+	
+	BatchFunc(argsFixStd, numPoints, argsIntStd.data(), values);	// call the BatchIntegrand 'BatchFunc'
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+void MultiDimInt::Integrator<DimFix, DimInt>::algorithm_internal_batch_integrand_for_custom_hypercube (const double* argsFix, const std::size_t numPoints, const double* argsInt, double* values) const
+{
+	std::array<double, DimFix> argsFixStd;	// copy the contents of 'argsFix' and 'argsInt' into a std::array and a std::vector of std::arrays, such that they can be used as arguments of 'BatchFunc'
+	std::vector<Arguments<DimInt>> argsIntStd (numPoints);
+	
+	for ( std::size_t i_argFix = 0; i_argFix < DimFix; ++i_argFix )
+	{
+		argsFixStd[i_argFix] = argsFix[i_argFix];
+	}
+	
+	std::vector<double> jacobians (numPoints);
+	
+	for ( std::size_t i_point = 0; i_point < numPoints; ++i_point )	// thereby, perform the changes of variables necessary to implement the integral boundaries 'LowerBounds' and 'UpperBounds'
+	{
+		jacobians[i_point] = map_to_custom_hypercube(&argsInt[i_point*DimInt], argsIntStd[i_point]);
+	}
+	
+	BatchFunc(argsFixStd, numPoints, argsIntStd.data(), values);	// call the BatchIntegrand 'BatchFunc'
+	
+	for ( std::size_t i_point = 0; i_point < numPoints; ++i_point )
+	{
+		values[i_point] *= jacobians[i_point];
+	}
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+double MultiDimInt::Integrator<DimFix, DimInt>::map_to_custom_hypercube (const double* argsInt, Arguments<DimInt>& argsIntStd) const
+{
 	double jacobian = 1.0;
 	
-	for ( std::size_t i_argInt = 0; i_argInt < DimInt; ++i_argInt )	// thereby, perform the changes of variables necessary to implement the integral boundaries 'LowerBounds' and 'UpperBounds'
+	for ( std::size_t i_argInt = 0; i_argInt < DimInt; ++i_argInt )
 	{
 		const double argInt = argsInt[i_argInt];
 		
@@ -461,48 +948,360 @@ double MultiDimInt::Integrator<DimFix, DimInt>::algorithm_internal_integrand_for
 		}
 	}
 	
-	return Func(argsFixStd, argsIntStd) * jacobian;	// call the Integrand 'Func'
-}
-
-template <std::size_t DimInt>
-void MultiDimInt::Integrator<0, DimInt>::error_handler (const Algorithm::Result& integral) const
-{
-	std::cout << 																		std::endl
-			  << " MultiDimInt::Integrator Warning: Integration failed"				 << std::endl
-			  << "	-Identifier:        " << Identifier								 << std::endl 	// cout the identifier, the integral value as well as the estimated absolute and relative error
-			  << "	-Value:             " << integral.Value 						 << std::endl
-			  << "	-Absolute error:    " << integral.Error 						 << std::endl
-			  << "	-Relative error:    " << std::abs(integral.Error/integral.Value) << std::endl
-			  << "	------------------- " << 											std::endl
-			  << integral.Comment		  << 											std::endl;	// cout the comment
+	return jacobian;
 }
 
-template <std::size_t DimInt>
-double MultiDimInt::Integrator<0, DimInt>::algorithm_internal_integrand_for_unit_hypercube (const double* dummyArgsFix, const double* argsInt) const
+template <std::size_t DimFix, std::size_t DimInt>
+MultiDimInt::Algorithm::Result MultiDimInt::Integrator<DimFix, DimInt>::run_algorithm (const Arguments<DimFix>& argsFix, const bool customBounds, const double signFlip) const
 {
-	std::array<double, DimInt> argsIntStd;	// copy the content of 'argsInt' into a std::array, such that it can be used as the argument of 'Func'
-	
-	for ( std::size_t i_argInt = 0; i_argInt < DimInt; ++i_argInt )
+	if ( not Peaks.empty() )
 	{
-		argsIntStd[i_argInt] = argsInt[i_argInt];
+		pass_given_points(customBounds);
 	}
 	
-	return Func(argsIntStd);	// call the IntegrandWithoutFixedArguments 'Func'
-}
-
-template <std::size_t DimInt>
-double MultiDimInt::Integrator<0, DimInt>::algorithm_internal_integrand_for_custom_hypercube (const double* dummyArgsFix, const double* argsInt) const
-{
-	std::array<double, DimInt> argsIntStd;	// copy the content of 'argsInt' into a std::array, such that it can be used as the argument of 'Func'
+	Alg->set_infinite_bounds(infinite_bounds(customBounds));
 	
-	double jacobian = 1.0;
+	start_integration();
+	
+	const Algorithm::InternalIntegrand func = customBounds ? bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_custom_hypercube, *this)	// the 'bind_member_function_to_object' is needed to pass the member functions Integrator< DimFix, DimInt >::algorithm_internal_integrand_for_custom_hypercube and Integrator< DimFix, DimInt >::algorithm_internal_integrand_for_unit_hypercube as a MultiDimInt::Algorithm::InternalIntegrand
+														   : bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_unit_hypercube, *this);
+	
+	Algorithm::InternalBatchIntegrand batchFunc;	// stays empty if there is no batch integrand
 	
-	for ( std::size_t i_argInt = 0; i_argInt < DimInt; ++i_argInt )	// thereby, perform the changes of variables necessary to implement the integral boundaries 'LowerBounds' and 'UpperBounds'
+	if ( BatchFunc )
 	{
-		const double argInt = argsInt[i_argInt];
-		
-		const double lowerBound = LowerBounds[i_argInt];
-		const double upperBound = UpperBounds[i_argInt];
+		batchFunc = customBounds ? bind_member_function_to_object(&Integrator::algorithm_internal_batch_integrand_for_custom_hypercube, *this)
+								 : bind_member_function_to_object(&Integrator::algorithm_internal_batch_integrand_for_unit_hypercube, *this);
+	}
+	
+	auto runAlgorithm = [&] (const Algorithm::InternalIntegrand& func, const Algorithm::InternalBatchIntegrand& batchFunc)
+	{
+		if ( batchFunc )	// hand whole batches of points to the batch integrand if the Algorithm samples in batches
+		{
+			return Alg->run_batch(batchFunc, DimInt, argsFix.data());
+		}
+		else
+		{
+			return Alg->run(func, DimInt, argsFix.data());
+		}
+	};
+	
+	const Algorithm::Result integral = traced_run(runAlgorithm, func, batchFunc, Alg->absolute_error_limit(), Alg->relative_error_limit());
+	
+	store_last_result(integral, customBounds, signFlip);	// also remembers the integration region and sign of the integral for Integrator::refine
+	
+	return integral;
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+MultiDimInt::Algorithm::Result MultiDimInt::Integrator<DimFix, DimInt>::traced_run (const std::function<Algorithm::Result(const Algorithm::InternalIntegrand& func, const Algorithm::InternalBatchIntegrand& batchFunc)>& runAlgorithm,
+															   const Algorithm::InternalIntegrand& func, const Algorithm::InternalBatchIntegrand& batchFunc, const double absErr, const double relErr) const
+{
+	MULTIDIMINT_TRACEPOINT3(integration__start, Identifier.c_str(), DimFix, DimInt);
+	
+	if ( not Trace::is_enabled() )
+	{
+		const Algorithm::Result integral = runAlgorithm(func, batchFunc);
+		
+		MULTIDIMINT_TRACEPOINT4(integration__done, Identifier.c_str(), DimFix, DimInt, integral.Failed ? 1 : (integral.DeadlineReached ? 2 : 0));
+		
+		return integral;
+	}
+	
+	const std::size_t depth = Trace::nesting_depth();
+	
+	Trace::EvaluationCounter numEval;	// counted per thread, as the threads of the Algorithm would otherwise compete for a single counter
+	
+	const Algorithm::InternalIntegrand tracedFunc = [&] (const double* argsFix, const double* argsInt)	// the integrand may be evaluated by other threads of the Algorithm, which do not know the nesting depth
+	{
+		numEval.add(1);
+		
+		const std::size_t threadDepth = Trace::nesting_depth();
+		
+		Trace::set_nesting_depth(depth + 1);
+		
+		const double value = func(argsFix, argsInt);
+		
+		Trace::set_nesting_depth(threadDepth);
+		
+		return value;
+	};
+	
+	const Algorithm::InternalBatchIntegrand tracedBatchFunc = [&] (const double* argsFix, const std::size_t numPoints, const double* argsInt, double* values)
+	{
+		numEval.add(numPoints);
+		
+		const std::size_t threadDepth = Trace::nesting_depth();
+		
+		Trace::set_nesting_depth(depth + 1);
+		
+		batchFunc(argsFix, numPoints, argsInt, values);
+		
+		Trace::set_nesting_depth(threadDepth);
+	};
+	
+	const auto startTime = std::chrono::steady_clock::now();
+	
+	const Algorithm::Result integral = runAlgorithm(tracedFunc, batchFunc ? tracedBatchFunc : Algorithm::InternalBatchIntegrand());
+	
+	const double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	
+	const std::string status = integral.Failed ? "failed" : (integral.DeadlineReached ? "deadline reached" : "succeeded");
+	
+	Trace::record(Trace::Record{Identifier, DimFix, DimInt, Trace::algorithm_name(*Alg), absErr, relErr, integral.Error, numEval.total(), wallTime, status, depth});
+	
+	MULTIDIMINT_TRACEPOINT4(integration__done, Identifier.c_str(), DimFix, DimInt, integral.Failed ? 1 : (integral.DeadlineReached ? 2 : 0));
+	
+	return integral;
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+MultiDimInt::Algorithm::Context MultiDimInt::Integrator<DimFix, DimInt>::algorithm_context (const Deadline& deadline) const
+{
+	return Algorithm::Context{Identifier, DimFix, deadline, Monitor};
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+void MultiDimInt::Integrator<DimFix, DimInt>::start_integration () const
+{
+	if ( TimeLimit > 0.0 )	// the time limit applies to each integration separately, while a cancellation token has already been passed on by set_cancellation_token
+	{
+		Alg->set_context(algorithm_context(Deadline(TimeLimit, Token)));
+	}
+	
+	if ( Monitor )
+	{
+		Monitor->start();
+	}
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+void MultiDimInt::Integrator<DimFix, DimInt>::store_last_result (const Algorithm::Result& integral, const bool customBounds, const double signFlip) const
+{
+	std::lock_guard<std::mutex> lock (LastResultMutex);
+	
+	LastResult = integral;
+	LastResult.Value *= signFlip;
+	LastCustomBounds = customBounds;
+	LastSignFlip = signFlip;
+	
+	if ( Monitor && Monitor->records_history() )
+	{
+		LastResult.History = Monitor->history();
+	}
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+MultiDimInt::Algorithm::Result MultiDimInt::Integrator<DimFix, DimInt>::last_result (bool& customBounds, double& signFlip) const
+{
+	std::lock_guard<std::mutex> lock (LastResultMutex);
+	
+	customBounds = LastCustomBounds;
+	signFlip = LastSignFlip;
+	
+	return LastResult;
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+double MultiDimInt::Integrator<DimFix, DimInt>::unit_hypercube_coordinate (const double arg, const std::size_t i_argInt, const bool customBounds) const
+{
+	if ( not customBounds )
+	{
+		return arg;
+	}
+	
+	const double lowerBound = LowerBounds[i_argInt];
+	const double upperBound = UpperBounds[i_argInt];
+	
+	if ( lowerBound > NegativeInfinity )
+	{
+		if ( upperBound < PositiveInfinity )	// finite integration region (lowerBound, upperBound)
+		{
+			return (arg - lowerBound) / (upperBound - lowerBound);
+		}
+		else	// semi-infinite integration region (lowerBound, +infinity)
+		{
+			return 1.0 / (arg - lowerBound + 1.0);
+		}
+	}
+	else
+	{
+		if ( upperBound < PositiveInfinity )	// semi-infinite integration region (-infinity, upperBound)
+		{
+			return 1.0 / (upperBound + 1.0 - arg);
+		}
+		else	// doubly-infinite integration region (-infinity, +infinity), using the numerically stable root of arg t (1 - t) = 2t - 1
+		{
+			return 2.0 / ((2.0 - arg) + std::sqrt(arg*arg + 4.0));
+		}
+	}
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+std::vector<double> MultiDimInt::Integrator<DimFix, DimInt>::given_points (const bool customBounds) const
+{
+	std::vector<double> givenPoints;
+	
+	givenPoints.reserve(Peaks.size() * DimInt);
+	
+	for ( const Arguments<DimInt>& peak : Peaks )
+	{
+		Arguments<DimInt> point;
+		
+		bool insideIntegrationRegion = true;
+		
+		for ( std::size_t i_argInt = 0; i_argInt < DimInt; ++i_argInt )
+		{
+			point[i_argInt] = unit_hypercube_coordinate(peak[i_argInt], i_argInt, customBounds);
+			
+			if ( not ((point[i_argInt] >= 0.0) && (point[i_argInt] <= 1.0)) )	// peaks outside of the integration region are skipped
+			{
+				insideIntegrationRegion = false;
+			}
+		}
+		
+		if ( insideIntegrationRegion )
+		{
+			givenPoints.insert(givenPoints.end(), point.begin(), point.end());
+		}
+	}
+	
+	return givenPoints;
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+void MultiDimInt::Integrator<DimFix, DimInt>::pass_given_points (const bool customBounds) const
+{
+	const std::vector<double> givenPoints = given_points(customBounds);
+	
+	std::lock_guard<std::mutex> lock (GivenPointsMutex);
+	
+	if ( givenPoints != GivenPoints )	// the positions are usually the same for all integrations, which may run concurrently, so that the Algorithm is only modified if they change
+	{
+		GivenPoints = givenPoints;
+		
+		Alg->set_given_points(GivenPoints);
+	}
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+std::vector<double> MultiDimInt::Integrator<DimFix, DimInt>::passed_given_points () const
+{
+	std::lock_guard<std::mutex> lock (GivenPointsMutex);
+	
+	return GivenPoints;
+}
+
+template <std::size_t DimFix, std::size_t DimInt>
+std::vector<bool> MultiDimInt::Integrator<DimFix, DimInt>::infinite_bounds (const bool customBounds) const
+{
+	std::vector<bool> infiniteBounds;
+	
+	if ( not customBounds )
+	{
+		return infiniteBounds;
+	}
+	
+	infiniteBounds.assign(2 * DimInt, false);	// non-empty flags tell that custom bounds are used, even if all of them are finite
+	
+	for ( std::size_t i_argInt = 0; i_argInt < DimInt; ++i_argInt )
+	{
+		const bool lowerInfinite = not (LowerBounds[i_argInt] > NegativeInfinity);
+		const bool upperInfinite = not (UpperBounds[i_argInt] < PositiveInfinity);
+		
+		if ( lowerInfinite || upperInfinite )	// a semi-infinite region is mapped such that its infinite bound lies at 0, see Integrator::map_to_custom_hypercube
+		{
+			infiniteBounds[2 * i_argInt] = true;
+			infiniteBounds[2 * i_argInt + 1] = lowerInfinite && upperInfinite;
+		}
+	}
+	
+	return infiniteBounds;
+}
+
+template <std::size_t DimInt>
+void MultiDimInt::Integrator<0, DimInt>::error_handler (const Algorithm::Result& integral) const
+{
+	std::cout << 																		std::endl
+			  << " MultiDimInt::Integrator Warning: Integration failed"				 << std::endl
+			  << "	-Identifier:        " << Identifier								 << std::endl 	// cout the identifier, the integral value as well as the estimated absolute and relative error
+			  << "	-Value:             " << integral.Value 						 << std::endl
+			  << "	-Absolute error:    " << integral.Error 						 << std::endl
+			  << "	-Relative error:    " << std::abs(integral.Error/integral.Value) << std::endl
+			  << "	------------------- " << 											std::endl
+			  << integral.Comment		  << 											std::endl;	// cout the comment
+}
+
+template <std::size_t DimInt>
+double MultiDimInt::Integrator<0, DimInt>::algorithm_internal_integrand_for_unit_hypercube (const double* dummyArgsFix, const double* argsInt) const
+{
+	std::array<double, DimInt> argsIntStd;	// copy the content of 'argsInt' into a std::array, such that it can be used as the argument of 'Func'
+	
+	for ( std::size_t i_argInt = 0; i_argInt < DimInt; ++i_argInt )
+	{
+		argsIntStd[i_argInt] = argsInt[i_argInt];
+	}
+	
+	return Func(argsIntStd);	// call the IntegrandWithoutFixedArguments 'Func'
+}
+
+template <std::size_t DimInt>
+double MultiDimInt::Integrator<0, DimInt>::algorithm_internal_integrand_for_custom_hypercube (const double* dummyArgsFix, const double* argsInt) const
+{
+	std::array<double, DimInt> argsIntStd;	// copy the content of 'argsInt' into a std::array, such that it can be used as the argument of 'Func'
+	
+	const double jacobian = map_to_custom_hypercube(argsInt, argsIntStd);	// thereby, perform the changes of variables necessary to implement the integral boundaries 'LowerBounds' and 'UpperBounds'
+	
+	return Func(argsIntStd) * jacobian;	// call the IntegrandWithoutFixedArguments 'Func'
+}
+
+template <std::size_t DimInt>
+void MultiDimInt::Integrator<0, DimInt>::algorithm_internal_batch_integrand_for_unit_hypercube (const double* dummyArgsFix, const std::size_t numPoints, const double* argsInt, double* values) const
+{
+	std::vector<Arguments<DimInt>> argsIntStd (numPoints);	// copy the content of 'argsInt' into a std::vector of std::arrays, such that it can be used as the argument of 'BatchFunc'
+	
+	for ( std::size_t i_point = 0; i_point < numPoints; ++i_point )
+	{
+		for ( std::size_t i_argInt = 0; i_argInt < DimInt; ++i_argInt )
+		{
+			argsIntStd[i_point][i_argInt] = argsInt[i_point*DimInt + i_argInt];
+		}
+	}
+	
+	BatchFunc(numPoints, argsIntStd.data(), values);	// call the BatchIntegrandWithoutFixedArguments 'BatchFunc'
+}
+
+template <std::size_t DimInt>
+void MultiDimInt::Integrator<0, DimInt>::algorithm_internal_batch_integrand_for_custom_hypercube (const double* dummyArgsFix, const std::size_t numPoints, const double* argsInt, double* values) const
+{
+	std::vector<Arguments<DimInt>> argsIntStd (numPoints);	// copy the content of 'argsInt' into a std::vector of std::arrays, such that it can be used as the argument of 'BatchFunc'
+	
+	std::vector<double> jacobians (numPoints);
+	
+	for ( std::size_t i_point = 0; i_point < numPoints; ++i_point )	// thereby, perform the changes of variables necessary to implement the integral boundaries 'LowerBounds' and 'UpperBounds'
+	{
+		jacobians[i_point] = map_to_custom_hypercube(&argsInt[i_point*DimInt], argsIntStd[i_point]);
+	}
+	
+	BatchFunc(numPoints, argsIntStd.data(), values);	// call the BatchIntegrandWithoutFixedArguments 'BatchFunc'
+	
+	for ( std::size_t i_point = 0; i_point < numPoints; ++i_point )
+	{
+		values[i_point] *= jacobians[i_point];
+	}
+}
+
+template <std::size_t DimInt>
+double MultiDimInt::Integrator<0, DimInt>::map_to_custom_hypercube (const double* argsInt, Arguments<DimInt>& argsIntStd) const
+{
+	double jacobian = 1.0;
+	
+	for ( std::size_t i_argInt = 0; i_argInt < DimInt; ++i_argInt )
+	{
+		const double argInt = argsInt[i_argInt];
+		
+		const double lowerBound = LowerBounds[i_argInt];
+		const double upperBound = UpperBounds[i_argInt];
 		
 		if ( lowerBound > NegativeInfinity )
 		{
@@ -536,5 +1335,273 @@ double MultiDimInt::Integrator<0, DimInt>::algorithm_internal_integrand_for_cust
 		}
 	}
 	
-	return Func(argsIntStd) * jacobian;	// call the IntegrandWithoutFixedArguments 'Func'
+	return jacobian;
+}
+
+template <std::size_t DimInt>
+MultiDimInt::Algorithm::Result MultiDimInt::Integrator<0, DimInt>::run_algorithm (const bool customBounds, const double signFlip) const
+{
+	if ( not Peaks.empty() )
+	{
+		pass_given_points(customBounds);
+	}
+	
+	Alg->set_infinite_bounds(infinite_bounds(customBounds));
+	
+	start_integration();
+	
+	const Algorithm::InternalIntegrand func = customBounds ? bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_custom_hypercube, *this)	// the 'bind_member_function_to_object' is needed to pass the member functions Integrator< 0, DimInt >::algorithm_internal_integrand_for_custom_hypercube and Integrator< 0, DimInt >::algorithm_internal_integrand_for_unit_hypercube as a MultiDimInt::Algorithm::InternalIntegrand
+														   : bind_member_function_to_object(&Integrator::algorithm_internal_integrand_for_unit_hypercube, *this);
+	
+	Algorithm::InternalBatchIntegrand batchFunc;	// stays empty if there is no batch integrand
+	
+	if ( BatchFunc )
+	{
+		batchFunc = customBounds ? bind_member_function_to_object(&Integrator::algorithm_internal_batch_integrand_for_custom_hypercube, *this)
+								 : bind_member_function_to_object(&Integrator::algorithm_internal_batch_integrand_for_unit_hypercube, *this);
+	}
+	
+	auto runAlgorithm = [&] (const Algorithm::InternalIntegrand& func, const Algorithm::InternalBatchIntegrand& batchFunc)
+	{
+		if ( batchFunc )	// hand whole batches of points to the batch integrand if the Algorithm samples in batches
+		{
+			return Alg->run_batch(batchFunc, DimInt, NULL);
+		}
+		else
+		{
+			return Alg->run(func, DimInt, NULL);
+		}
+	};
+	
+	const Algorithm::Result integral = traced_run(runAlgorithm, func, batchFunc, Alg->absolute_error_limit(), Alg->relative_error_limit());
+	
+	store_last_result(integral, customBounds, signFlip);	// also remembers the integration region and sign of the integral for Integrator::refine
+	
+	return integral;
+}
+
+template <std::size_t DimInt>
+MultiDimInt::Algorithm::Result MultiDimInt::Integrator<0, DimInt>::traced_run (const std::function<Algorithm::Result(const Algorithm::InternalIntegrand& func, const Algorithm::InternalBatchIntegrand& batchFunc)>& runAlgorithm,
+															   const Algorithm::InternalIntegrand& func, const Algorithm::InternalBatchIntegrand& batchFunc, const double absErr, const double relErr) const
+{
+	MULTIDIMINT_TRACEPOINT3(integration__start, Identifier.c_str(), 0, DimInt);
+	
+	if ( not Trace::is_enabled() )
+	{
+		const Algorithm::Result integral = runAlgorithm(func, batchFunc);
+		
+		MULTIDIMINT_TRACEPOINT4(integration__done, Identifier.c_str(), 0, DimInt, integral.Failed ? 1 : (integral.DeadlineReached ? 2 : 0));
+		
+		return integral;
+	}
+	
+	const std::size_t depth = Trace::nesting_depth();
+	
+	Trace::EvaluationCounter numEval;	// counted per thread, as the threads of the Algorithm would otherwise compete for a single counter
+	
+	const Algorithm::InternalIntegrand tracedFunc = [&] (const double* argsFix, const double* argsInt)	// the integrand may be evaluated by other threads of the Algorithm, which do not know the nesting depth
+	{
+		numEval.add(1);
+		
+		const std::size_t threadDepth = Trace::nesting_depth();
+		
+		Trace::set_nesting_depth(depth + 1);
+		
+		const double value = func(argsFix, argsInt);
+		
+		Trace::set_nesting_depth(threadDepth);
+		
+		return value;
+	};
+	
+	const Algorithm::InternalBatchIntegrand tracedBatchFunc = [&] (const double* argsFix, const std::size_t numPoints, const double* argsInt, double* values)
+	{
+		numEval.add(numPoints);
+		
+		const std::size_t threadDepth = Trace::nesting_depth();
+		
+		Trace::set_nesting_depth(depth + 1);
+		
+		batchFunc(argsFix, numPoints, argsInt, values);
+		
+		Trace::set_nesting_depth(threadDepth);
+	};
+	
+	const auto startTime = std::chrono::steady_clock::now();
+	
+	const Algorithm::Result integral = runAlgorithm(tracedFunc, batchFunc ? tracedBatchFunc : Algorithm::InternalBatchIntegrand());
+	
+	const double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	
+	const std::string status = integral.Failed ? "failed" : (integral.DeadlineReached ? "deadline reached" : "succeeded");
+	
+	Trace::record(Trace::Record{Identifier, 0, DimInt, Trace::algorithm_name(*Alg), absErr, relErr, integral.Error, numEval.total(), wallTime, status, depth});
+	
+	MULTIDIMINT_TRACEPOINT4(integration__done, Identifier.c_str(), 0, DimInt, integral.Failed ? 1 : (integral.DeadlineReached ? 2 : 0));
+	
+	return integral;
+}
+
+template <std::size_t DimInt>
+MultiDimInt::Algorithm::Context MultiDimInt::Integrator<0, DimInt>::algorithm_context (const Deadline& deadline) const
+{
+	return Algorithm::Context{Identifier, 0, deadline, Monitor};
+}
+
+template <std::size_t DimInt>
+void MultiDimInt::Integrator<0, DimInt>::start_integration () const
+{
+	if ( TimeLimit > 0.0 )	// the time limit applies to each integration separately, while a cancellation token has already been passed on by set_cancellation_token
+	{
+		Alg->set_context(algorithm_context(Deadline(TimeLimit, Token)));
+	}
+	
+	if ( Monitor )
+	{
+		Monitor->start();
+	}
+}
+
+template <std::size_t DimInt>
+void MultiDimInt::Integrator<0, DimInt>::store_last_result (const Algorithm::Result& integral, const bool customBounds, const double signFlip) const
+{
+	std::lock_guard<std::mutex> lock (LastResultMutex);
+	
+	LastResult = integral;
+	LastResult.Value *= signFlip;
+	LastCustomBounds = customBounds;
+	LastSignFlip = signFlip;
+	
+	if ( Monitor && Monitor->records_history() )
+	{
+		LastResult.History = Monitor->history();
+	}
+}
+
+template <std::size_t DimInt>
+MultiDimInt::Algorithm::Result MultiDimInt::Integrator<0, DimInt>::last_result (bool& customBounds, double& signFlip) const
+{
+	std::lock_guard<std::mutex> lock (LastResultMutex);
+	
+	customBounds = LastCustomBounds;
+	signFlip = LastSignFlip;
+	
+	return LastResult;
+}
+
+template <std::size_t DimInt>
+double MultiDimInt::Integrator<0, DimInt>::unit_hypercube_coordinate (const double arg, const std::size_t i_argInt, const bool customBounds) const
+{
+	if ( not customBounds )
+	{
+		return arg;
+	}
+	
+	const double lowerBound = LowerBounds[i_argInt];
+	const double upperBound = UpperBounds[i_argInt];
+	
+	if ( lowerBound > NegativeInfinity )
+	{
+		if ( upperBound < PositiveInfinity )	// finite integration region (lowerBound, upperBound)
+		{
+			return (arg - lowerBound) / (upperBound - lowerBound);
+		}
+		else	// semi-infinite integration region (lowerBound, +infinity)
+		{
+			return 1.0 / (arg - lowerBound + 1.0);
+		}
+	}
+	else
+	{
+		if ( upperBound < PositiveInfinity )	// semi-infinite integration region (-infinity, upperBound)
+		{
+			return 1.0 / (upperBound + 1.0 - arg);
+		}
+		else	// doubly-infinite integration region (-infinity, +infinity), using the numerically stable root of arg t (1 - t) = 2t - 1
+		{
+			return 2.0 / ((2.0 - arg) + std::sqrt(arg*arg + 4.0));
+		}
+	}
+}
+
+template <std::size_t DimInt>
+std::vector<double> MultiDimInt::Integrator<0, DimInt>::given_points (const bool customBounds) const
+{
+	std::vector<double> givenPoints;
+	
+	givenPoints.reserve(Peaks.size() * DimInt);
+	
+	for ( const Arguments<DimInt>& peak : Peaks )
+	{
+		Arguments<DimInt> point;
+		
+		bool insideIntegrationRegion = true;
+		
+		for ( std::size_t i_argInt = 0; i_argInt < DimInt; ++i_argInt )
+		{
+			point[i_argInt] = unit_hypercube_coordinate(peak[i_argInt], i_argInt, customBounds);
+			
+			if ( not ((point[i_argInt] >= 0.0) && (point[i_argInt] <= 1.0)) )	// peaks outside of the integration region are skipped
+			{
+				insideIntegrationRegion = false;
+			}
+		}
+		
+		if ( insideIntegrationRegion )
+		{
+			givenPoints.insert(givenPoints.end(), point.begin(), point.end());
+		}
+	}
+	
+	return givenPoints;
+}
+
+template <std::size_t DimInt>
+void MultiDimInt::Integrator<0, DimInt>::pass_given_points (const bool customBounds) const
+{
+	const std::vector<double> givenPoints = given_points(customBounds);
+	
+	std::lock_guard<std::mutex> lock (GivenPointsMutex);
+	
+	if ( givenPoints != GivenPoints )	// the positions are usually the same for all integrations, which may run concurrently, so that the Algorithm is only modified if they change
+	{
+		GivenPoints = givenPoints;
+		
+		Alg->set_given_points(GivenPoints);
+	}
+}
+
+template <std::size_t DimInt>
+std::vector<double> MultiDimInt::Integrator<0, DimInt>::passed_given_points () const
+{
+	std::lock_guard<std::mutex> lock (GivenPointsMutex);
+	
+	return GivenPoints;
+}
+
+template <std::size_t DimInt>
+std::vector<bool> MultiDimInt::Integrator<0, DimInt>::infinite_bounds (const bool customBounds) const
+{
+	std::vector<bool> infiniteBounds;
+	
+	if ( not customBounds )
+	{
+		return infiniteBounds;
+	}
+	
+	infiniteBounds.assign(2 * DimInt, false);	// non-empty flags tell that custom bounds are used, even if all of them are finite
+	
+	for ( std::size_t i_argInt = 0; i_argInt < DimInt; ++i_argInt )
+	{
+		const bool lowerInfinite = not (LowerBounds[i_argInt] > NegativeInfinity);
+		const bool upperInfinite = not (UpperBounds[i_argInt] < PositiveInfinity);
+		
+		if ( lowerInfinite || upperInfinite )	// a semi-infinite region is mapped such that its infinite bound lies at 0, see Integrator::map_to_custom_hypercube
+		{
+			infiniteBounds[2 * i_argInt] = true;
+			infiniteBounds[2 * i_argInt + 1] = lowerInfinite && upperInfinite;
+		}
+	}
+	
+	return infiniteBounds;
 }
\ No newline at end of file
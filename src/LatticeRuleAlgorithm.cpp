@@ -0,0 +1,326 @@
+#include "LatticeRuleAlgorithm.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::LatticeRuleAlgorithm::LatticeRuleAlgorithm (const double absErr, const double relErr, const std::size_t maxEval, const Periodization periodization) :
+	LatticeRuleAlgorithm(absErr, relErr, maxEval, periodization, 17797, 16, (maxEval > 0) ? std::min<std::size_t>(4096, maxEval) : 4096, 1024)	// the first round must not exceed a smaller maximal number of integrand evaluations
+{}
+
+MultiDimInt::LatticeRuleAlgorithm::LatticeRuleAlgorithm (const double absErr, const double relErr, const std::size_t maxEval, const Periodization periodization, const std::uint32_t korobovParameter,
+														 const std::size_t numShifts, const std::size_t minEval, const std::size_t blockSize) :
+	Algorithm(absErr, relErr),
+	MaxEval(maxEval),
+	PeriodizingTransform(periodization),
+	KorobovParameter(korobovParameter),
+	GeneratingVector(),
+	NumShifts(numShifts),
+	MinEval(minEval),
+	BlockSize(blockSize),
+	RandomNumberGenerator(0)
+{
+	if ( KorobovParameter % 2 == 0 )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::LatticeRuleAlgorithm Error: Korobov parameter is not odd" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+
+	check_parameters();
+}
+
+MultiDimInt::LatticeRuleAlgorithm::LatticeRuleAlgorithm (const double absErr, const double relErr, const std::size_t maxEval, const Periodization periodization, const std::vector<std::uint32_t>& generatingVector,
+														 const std::size_t numShifts, const std::size_t minEval, const std::size_t blockSize) :
+	Algorithm(absErr, relErr),
+	MaxEval(maxEval),
+	PeriodizingTransform(periodization),
+	KorobovParameter(0),
+	GeneratingVector(generatingVector),
+	NumShifts(numShifts),
+	MinEval(minEval),
+	BlockSize(blockSize),
+	RandomNumberGenerator(0)
+{
+	if ( GeneratingVector.empty() )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::LatticeRuleAlgorithm Error: Generating vector is empty" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+
+	check_parameters();
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::LatticeRuleAlgorithm::run (const InternalIntegrand& func, const std::size_t dimInt, const double* argsFix) const
+{
+	Algorithm::Result integral{false, 0.0, 0.0, ""};
+
+	std::vector<std::uint32_t> generatingVector = GeneratingVector;
+
+	if ( generatingVector.empty() )
+	{
+		generatingVector = korobov_generating_vector(KorobovParameter, dimInt);
+	}
+	else if ( generatingVector.size() < dimInt )
+	{
+		integral.Failed = true;
+
+		integral.Comment = "	-Lattice rule error: Generating vector has fewer components than there are integration variables";
+
+		return integral;
+	}
+
+	const double twoToThe32 = 4294967296.0;
+
+	std::vector<double> shifts (NumShifts * dimInt);
+
+	std::uniform_real_distribution<double> uniform (0.0, 1.0);
+
+	for ( std::size_t i = 0; i < NumShifts * dimInt; ++i )
+	{
+		shifts[i] = uniform(RandomNumberGenerator);
+	}
+
+	std::vector<double> sums (NumShifts, 0.0);	// sum of the integrand values of each shift
+
+	std::vector<double> points (BlockSize * dimInt);
+	std::vector<double> values (NumShifts * BlockSize);
+
+	std::size_t numPointsUsed = 0;	// number of lattice points sampled so far with each shift
+	std::size_t numPointsRound = 1;	// total number of lattice points after the current round, always a power of two
+
+	while ( NumShifts * numPointsRound < MinEval )
+	{
+		numPointsRound *= 2;
+	}
+
+	if ( (MaxEval > 0) && (NumShifts * numPointsRound > MaxEval) )
+	{
+		numPointsRound /= 2;
+	}
+
+	while ( true )
+	{
+		while ( numPointsUsed < numPointsRound )	// sample the new lattice points of this round in blocks
+		{
+			const std::size_t numBlockPoints = std::min(BlockSize, numPointsRound - numPointsUsed);
+			const std::size_t numBlockEval = NumShifts * numBlockPoints;
+
+			for ( std::size_t i_point = 0; i_point < numBlockPoints; ++i_point )	// unshifted lattice points, computed exactly in integer arithmetic
+			{
+				std::uint32_t index = static_cast<std::uint32_t>(numPointsUsed + i_point);
+				std::uint32_t radicalInverse = 0;	// bit-reversed index, i.e. the radical inverse in base 2 times 2^32
+
+				for ( int i_bit = 0; i_bit < 32; ++i_bit )
+				{
+					radicalInverse = (radicalInverse << 1) | (index & 1);
+					index >>= 1;
+				}
+
+				for ( std::size_t i = 0; i < dimInt; ++i )
+				{
+					const std::uint32_t coordinate = radicalInverse * generatingVector[i];	// overflow performs the reduction modulo 2^32
+
+					points[i_point * dimInt + i] = coordinate / twoToThe32;
+				}
+			}
+
+			#pragma omp parallel	// evaluate all shifts of all lattice points of the block in parallel
+			{
+				std::vector<double> argsInt (dimInt);
+
+				#pragma omp for schedule(static)
+				for ( std::size_t i_eval = 0; i_eval < numBlockEval; ++i_eval )
+				{
+					const std::size_t i_shift = i_eval / numBlockPoints;
+					const std::size_t i_point = i_eval % numBlockPoints;
+
+					double jacobian = 1.0;
+
+					for ( std::size_t i = 0; i < dimInt; ++i )
+					{
+						double t = points[i_point * dimInt + i] + shifts[i_shift * dimInt + i];
+
+						if ( t >= 1.0 )
+						{
+							t -= 1.0;
+						}
+
+						argsInt[i] = periodize(t, jacobian);
+					}
+
+					values[i_eval] = (jacobian != 0.0) ? jacobian * func(argsFix, argsInt.data()) : 0.0;	// the integrand is not evaluated where the periodizing transform has a vanishing Jacobian, as it may be singular at the boundaries
+				}
+			}
+
+			for ( std::size_t i_shift = 0; i_shift < NumShifts; ++i_shift )	// summation is done serially to keep the result independent of the number of threads
+			{
+				for ( std::size_t i_point = 0; i_point < numBlockPoints; ++i_point )
+				{
+					sums[i_shift] += values[i_shift * numBlockPoints + i_point];
+				}
+			}
+
+			numPointsUsed += numBlockPoints;
+		}
+
+		double mean = 0.0;
+
+		for ( std::size_t i_shift = 0; i_shift < NumShifts; ++i_shift )
+		{
+			mean += sums[i_shift] / numPointsUsed;
+		}
+
+		mean /= NumShifts;
+
+		double variance = 0.0;
+
+		for ( std::size_t i_shift = 0; i_shift < NumShifts; ++i_shift )
+		{
+			variance += std::pow(sums[i_shift] / numPointsUsed - mean, 2);
+		}
+
+		variance /= NumShifts - 1;
+
+		integral.Value = mean;
+		integral.Error = std::sqrt(variance / NumShifts);	// standard error of the mean of the independent shifts
+
+		report_progress(integral.Value, integral.Error, NumShifts * numPointsUsed);
+
+		if ( not is_finite(integral.Value) )
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-Lattice rule error: Integral value is not finite";
+
+			break;
+		}
+
+		if ( (integral.Error <= AbsErr) || (integral.Error <= RelErr * std::abs(integral.Value)) )
+		{
+			break;
+		}
+
+		if ( (MaxEval > 0) && (2 * NumShifts * numPointsRound > MaxEval) )	// doubling the number of points would exceed the maximal number of integrand evaluations...
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-Lattice rule error: Maximal number of integrand evaluations reached";
+
+			break;
+		}
+
+		if ( 2 * numPointsRound > 4294967296.0 )	// ...or the size of the lattice sequence
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-Lattice rule error: Maximal number of lattice points reached";
+
+			break;
+		}
+
+		if ( deadline_reached() )
+		{
+			integral.DeadlineReached = true;
+
+			integral.Comment = "	-Lattice rule: Deadline reached before meeting the error limits";
+
+			break;
+		}
+
+		numPointsRound *= 2;
+	}
+
+	return integral;
+}
+
+bool MultiDimInt::LatticeRuleAlgorithm::is_parallelized () const
+{
+	return true;
+}
+
+MultiDimInt::LatticeRuleAlgorithm* MultiDimInt::LatticeRuleAlgorithm::clone () const
+{
+	return new LatticeRuleAlgorithm(*this);
+}
+
+std::vector<std::uint32_t> MultiDimInt::LatticeRuleAlgorithm::korobov_generating_vector (const std::uint32_t korobovParameter, const std::size_t dim)
+{
+	std::vector<std::uint32_t> generatingVector (dim);
+
+	std::uint32_t component = 1;
+
+	for ( std::size_t i = 0; i < dim; ++i )
+	{
+		generatingVector[i] = component;
+
+		component *= korobovParameter;	// overflow performs the reduction modulo 2^32
+	}
+
+	return generatingVector;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
+
+void MultiDimInt::LatticeRuleAlgorithm::check_parameters () const
+{
+	if ( NumShifts < 2 )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::LatticeRuleAlgorithm Error: Number of shifts is smaller than 2" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+
+	if ( BlockSize <= 0 )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::LatticeRuleAlgorithm Error: Block size is not positive" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+
+	if ( (MaxEval > 0) && (MaxEval < std::max(MinEval, NumShifts)) )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::LatticeRuleAlgorithm Error: Maximal number of integrand evaluations is smaller than the number of evaluations in the first round" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+}
+
+double MultiDimInt::LatticeRuleAlgorithm::periodize (const double t, double& jacobian) const
+{
+	switch ( PeriodizingTransform )
+	{
+		case Periodization::Baker:
+			return 1.0 - std::abs(2.0 * t - 1.0);	// measure-preserving, so the Jacobian is 1
+
+		case Periodization::Polynomial:
+			jacobian *= 6.0 * t * (1.0 - t);
+			return t * t * (3.0 - 2.0 * t);
+
+		case Periodization::Sidi:
+			jacobian *= 1.0 - std::cos(2.0 * M_PI * t);
+			return t - std::sin(2.0 * M_PI * t) / (2.0 * M_PI);
+
+		default:
+			return t;
+	}
+}
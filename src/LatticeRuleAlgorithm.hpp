@@ -0,0 +1,141 @@
+#ifndef MULTIDIMINT_LATTICE_RULE_ALGORITHM_H
+#define MULTIDIMINT_LATTICE_RULE_ALGORITHM_H
+
+#include "Algorithm.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class implementing a randomly shifted rank-1 lattice rule.
+	 *
+	 * The integrand is sampled at the points x_k = {phi(k) z + Delta} of an embedded rank-1 lattice sequence in base 2,
+	 * where phi is the radical inverse in base 2, z the integer generating vector and Delta a random shift, and {} denotes
+	 * the fractional part. The first 2^m points of this sequence form a complete lattice rule, such that the number of
+	 * points can be doubled while reusing all previously sampled ones. The generating vector is either of Korobov type,
+	 * z = (1, a, a^2, ...) modulo 2^32, or an arbitrary user-provided vector, e.g. one obtained by a component-by-component
+	 * construction.
+	 *
+	 * The integral value is the mean of the estimates obtained with several independent random shifts, and its error is
+	 * estimated from their scatter. The number of points is doubled until the error limits are met or the maximal number
+	 * of integrand evaluations would be exceeded. All shifts of a block of points are evaluated in parallel.
+	 *
+	 * Lattice rules converge fastest for periodic integrands. As the Integrator maps any integration domain onto the unit
+	 * hypercube, a periodizing transform of the unit hypercube can be applied on top of that mapping, which makes the
+	 * transformed integrand (close to) periodic without further changes to the bounds handling.
+	 */
+	class LatticeRuleAlgorithm : public Algorithm
+	{
+	public:
+		/**
+		 * Periodizing transforms of the unit interval that can be applied to each integration variable.
+		 *
+		 *  - None: no transform
+		 *  - Baker: baker's (tent) transform t -> 1 - |2t - 1|, which makes the integrand continuous on the torus
+		 *  - Polynomial: t -> 3t^2 - 2t^3, which makes the integrand continuous and its derivative vanish at the boundaries
+		 *  - Sidi: t -> t - sin(2 pi t) / (2 pi), which additionally lets the second derivative vanish at the boundaries
+		 */
+		enum class Periodization {None, Baker, Polynomial, Sidi};
+
+		/**
+		 * Constructor instantiating a randomly shifted rank-1 lattice rule with absolute error limit \a absErr, relative
+		 * error limit \a absRel, maximal number of integrand evaluations \a maxEval, which is unlimited if it is 0, and
+		 * periodizing transform \a periodization. All further parameters are set to the following standard values:
+		 *
+		 *  - korobovParameter = 17797
+		 *  - numShifts = 16
+		 *  - minEval = 4096, or \a maxEval if it is smaller and not 0
+		 *  - blockSize = 1024
+		 */
+		LatticeRuleAlgorithm (double absErr, double relErr, std::size_t maxEval, Periodization periodization = Periodization::Baker);
+
+		/**
+		 * Constructor instantiating a randomly shifted rank-1 lattice rule with absolute error limit \a absErr, relative
+		 * error limit \a absRel, maximal number of integrand evaluations \a maxEval, which is unlimited if it is 0,
+		 * periodizing transform \a periodization and a Korobov generating vector with parameter \a korobovParameter. The
+		 * lattice is shifted randomly \a numShifts times, the first round uses (at least) \a minEval integrand evaluations,
+		 * and the points are generated in blocks of \a blockSize points.
+		 */
+		LatticeRuleAlgorithm (double absErr, double relErr, std::size_t maxEval, Periodization periodization, std::uint32_t korobovParameter,
+							  std::size_t numShifts, std::size_t minEval, std::size_t blockSize);
+
+		/**
+		 * Constructor instantiating a randomly shifted rank-1 lattice rule with absolute error limit \a absErr, relative
+		 * error limit \a absRel, maximal number of integrand evaluations \a maxEval, which is unlimited if it is 0,
+		 * periodizing transform \a periodization and generating vector \a generatingVector, which has to be suitable for
+		 * lattices with 2^m points and to contain at least as many components as there are integration variables. The
+		 * lattice is shifted randomly \a numShifts times, the first round uses (at least) \a minEval integrand evaluations,
+		 * and the points are generated in blocks of \a blockSize points.
+		 */
+		LatticeRuleAlgorithm (double absErr, double relErr, std::size_t maxEval, Periodization periodization, const std::vector<std::uint32_t>& generatingVector,
+							  std::size_t numShifts, std::size_t minEval, std::size_t blockSize);
+
+		Algorithm::Result run (const InternalIntegrand& func, std::size_t dimInt, const double* argsFix) const;
+
+		bool is_parallelized () const;
+
+		LatticeRuleAlgorithm* clone () const;
+
+		/**
+		 * Returns the Korobov generating vector (1, a, a^2, ..., a^(\a dim - 1)) modulo 2^32 with parameter \a a = \a korobovParameter.
+		 */
+		static std::vector<std::uint32_t> korobov_generating_vector (std::uint32_t korobovParameter, std::size_t dim);
+
+	private:
+		/**
+		 * Checks the parameters set by the constructors.
+		 */
+		void check_parameters () const;
+
+		/**
+		 * Applies the periodizing transform to the integration variable \a t and returns the transformed variable. The
+		 * Jacobian of the transform is multiplied to \a jacobian.
+		 */
+		double periodize (double t, double& jacobian) const;
+
+		/**
+		 * Maximal number of integrand evaluations, which is unlimited if this is 0.
+		 */
+		std::size_t MaxEval;
+
+		/**
+		 * Periodizing transform applied to each integration variable.
+		 */
+		Periodization PeriodizingTransform;
+
+		/**
+		 * Korobov parameter used to construct the generating vector if LatticeRuleAlgorithm::GeneratingVector is empty.
+		 */
+		std::uint32_t KorobovParameter;
+
+		/**
+		 * User-provided generating vector.
+		 */
+		std::vector<std::uint32_t> GeneratingVector;
+
+		/**
+		 * Number of independent random shifts of the lattice.
+		 */
+		std::size_t NumShifts;
+
+		/**
+		 * Minimal number of integrand evaluations in the first round.
+		 */
+		std::size_t MinEval;
+
+		/**
+		 * Number of lattice points generated and evaluated at once.
+		 */
+		std::size_t BlockSize;
+
+		/**
+		 * Random number generator used for the shifts.
+		 */
+		mutable std::mt19937_64 RandomNumberGenerator;
+	};
+}
+
+#endif
@@ -0,0 +1,24 @@
+#include "ParallelHAdaptiveCubatureAlgorithm.hpp"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::ParallelHAdaptiveCubatureAlgorithm::ParallelHAdaptiveCubatureAlgorithm (const double absErr, const double relErr, const std::size_t maxEval, const std::size_t maxRegionsPerStep) :
+	HAdaptiveCubatureAlgorithm(absErr, relErr, maxEval, maxRegionsPerStep)
+{}
+
+bool MultiDimInt::ParallelHAdaptiveCubatureAlgorithm::is_parallelized () const
+{
+	return true;
+}
+
+MultiDimInt::ParallelHAdaptiveCubatureAlgorithm* MultiDimInt::ParallelHAdaptiveCubatureAlgorithm::clone () const
+{
+	return new ParallelHAdaptiveCubatureAlgorithm(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
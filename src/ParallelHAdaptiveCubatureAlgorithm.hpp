@@ -0,0 +1,36 @@
+#ifndef MULTIDIMINT_PARALLEL_H_ADAPTIVE_CUBATURE_ALGORITHM_H
+#define MULTIDIMINT_PARALLEL_H_ADAPTIVE_CUBATURE_ALGORITHM_H
+
+#include "HAdaptiveCubatureAlgorithm.hpp"
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class implementing a parallelized native h-adaptive cubature algorithm.
+	 *
+	 * Instead of bisecting only the subregion with the largest error, each step bisects the subregions with the largest
+	 * errors until the remaining ones could meet the error limits on their own, but at most a fixed number of them, like
+	 * the vectorized hcubature_v of the Cubature library. The integration rule is then applied to all resulting subregions
+	 * in parallel, i.e. not only the integrand evaluations but also the rule arithmetic and the choice of the splitting
+	 * dimensions are parallelized, while the partition is stored as a structure of arrays. As the selection of subregions
+	 * does not depend on the number of threads, the result does not either.
+	 *
+	 * Apart from this, it behaves exactly like HAdaptiveCubatureAlgorithm, including the refinement and partition reuse.
+	 */
+	class ParallelHAdaptiveCubatureAlgorithm : public HAdaptiveCubatureAlgorithm
+	{
+	public:
+		/**
+		 * Constructor instantiating a parallelized native h-adaptive cubature scheme with absolute error limit \a absErr,
+		 * relative error limit \a absRel and maximal number of integrand evaluations \a maxEval, which is unlimited if it
+		 * is 0, that bisects up to \a maxRegionsPerStep subregions at once.
+		 */
+		ParallelHAdaptiveCubatureAlgorithm (double absErr, double relErr, std::size_t maxEval, std::size_t maxRegionsPerStep = 256);
+
+		bool is_parallelized () const;
+
+		ParallelHAdaptiveCubatureAlgorithm* clone () const;
+	};
+}
+
+#endif
@@ -0,0 +1,245 @@
+#include "ParallelPAdaptiveCubatureAlgorithm.hpp"
+
+#include "ClenshawCurtisTable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include <omp.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::ParallelPAdaptiveCubatureAlgorithm::ParallelPAdaptiveCubatureAlgorithm (const double absErr, const double relErr, const std::size_t maxEval) :
+	Algorithm(absErr, relErr),
+	MaxEval(maxEval)
+{}
+
+MultiDimInt::Algorithm::Result MultiDimInt::ParallelPAdaptiveCubatureAlgorithm::run (const InternalIntegrand& func, const std::size_t dimInt, const double* argsFix) const
+{
+	std::vector<std::size_t> levels (dimInt, 1);	// start with the 3-point rule in each dimension, such that the midpoint rule provides the first error estimate
+
+	std::size_t numPoints = grid_size(levels);
+
+	if ( (numPoints == 0) || ((MaxEval > 0) && (numPoints > MaxEval)) )
+	{
+		return Algorithm::Result{true, 0.0, 0.0, "	-P-adaptive cubature error: Maximal number of integrand evaluations too small for the coarsest grid"};
+	}
+
+	EvaluationCache cache (dimInt);
+
+	while ( true )
+	{
+		cache.reserve(numPoints);
+
+		const std::vector<double> values = integrate_grid(func, argsFix, levels, cache);
+
+		Algorithm::Result integral = {false, values[0], 0.0, ""};
+
+		std::size_t i_refine = dimInt;	// dimension with the largest error whose level can still be raised
+		double maxRefinableError = 0.0;
+
+		for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )
+		{
+			const double error = std::abs(values[0] - values[1 + i_dim]);
+
+			integral.Error = std::max(integral.Error, error);
+
+			if ( (levels[i_dim] < ClenshawCurtisTable::MaxLevel) && ((i_refine == dimInt) || (error > maxRefinableError)) )
+			{
+				i_refine = i_dim;
+				maxRefinableError = error;
+			}
+		}
+
+		report_progress(integral.Value, integral.Error, numPoints);	// the Clenshaw-Curtis rules are nested, so the grid contains all points evaluated so far
+
+		if ( not is_finite(integral.Value) )
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-P-adaptive cubature error: Integral value is not finite";
+
+			return integral;
+		}
+
+		if ( (integral.Error <= AbsErr) || (integral.Error <= RelErr * std::abs(integral.Value)) )
+		{
+			return integral;
+		}
+
+		if ( deadline_reached() )
+		{
+			integral.DeadlineReached = true;
+
+			integral.Comment = "	-P-adaptive cubature: Deadline reached before meeting the error limits";
+
+			return integral;
+		}
+
+		if ( i_refine == dimInt )
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-P-adaptive cubature error: Highest level of the Clenshaw-Curtis rules reached";
+
+			return integral;
+		}
+
+		++levels[i_refine];
+
+		numPoints = grid_size(levels);
+
+		if ( (numPoints == 0) || ((MaxEval > 0) && (numPoints > MaxEval)) )
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-P-adaptive cubature error: Maximal number of integrand evaluations reached";
+
+			return integral;
+		}
+	}
+}
+
+bool MultiDimInt::ParallelPAdaptiveCubatureAlgorithm::is_parallelized () const
+{
+	return true;
+}
+
+MultiDimInt::ParallelPAdaptiveCubatureAlgorithm* MultiDimInt::ParallelPAdaptiveCubatureAlgorithm::clone () const
+{
+	return new ParallelPAdaptiveCubatureAlgorithm(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
+
+std::vector<double> MultiDimInt::ParallelPAdaptiveCubatureAlgorithm::integrate_grid (const InternalIntegrand& func, const double* argsFix, const std::vector<std::size_t>& levels, EvaluationCache& cache) const
+{
+	const ClenshawCurtisTable& table = ClenshawCurtisTable::shared();
+
+	const std::size_t dimInt = levels.size();
+	const std::size_t numPoints = grid_size(levels);
+
+	std::vector<std::size_t> numNodes (dimInt);
+	std::vector<char> skipLowerNode (dimInt);	// whether the first or last node lies on an infinite bound, where the integrand cannot be evaluated
+	std::vector<char> skipUpperNode (dimInt);
+
+	for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )
+	{
+		numNodes[i_dim] = table.number_of_nodes(levels[i_dim]);
+
+		skipLowerNode[i_dim] = (levels[i_dim] > 0) && infinite_bound(i_dim, false);	// the rule of level 0 only consists of the midpoint
+		skipUpperNode[i_dim] = (levels[i_dim] > 0) && infinite_bound(i_dim, true);
+	}
+
+	const int numThreads = omp_get_max_threads();
+
+	std::vector<std::vector<double>> threadValues (numThreads, std::vector<double>(dimInt + 1, 0.0));	// partial sums of each thread, which are added up in a fixed order below
+
+	#pragma omp parallel num_threads(numThreads) if ( numPoints > 1 )
+	{
+		std::vector<double>& values = threadValues[omp_get_thread_num()];
+
+		std::vector<std::uint32_t> key (dimInt);
+		std::vector<double> point (dimInt);
+		std::vector<double> weights (dimInt);
+		std::vector<double> lowerWeights (dimInt);
+		std::vector<double> leadingWeights (dimInt + 1);
+
+		#pragma omp for schedule(static)
+		for ( std::size_t i_point = 0; i_point < numPoints; ++i_point )
+		{
+			std::size_t remainder = i_point;
+
+			bool onInfiniteBound = false;
+
+			for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )	// decompose the index of the grid point into the indices of the nodes in each dimension
+			{
+				const std::size_t i_node = remainder % numNodes[i_dim];
+
+				remainder /= numNodes[i_dim];
+
+				if ( ((i_node == 0) && skipLowerNode[i_dim]) || ((i_node == numNodes[i_dim] - 1) && skipUpperNode[i_dim]) )
+				{
+					onInfiniteBound = true;
+				}
+
+				key[i_dim] = table.fine_index(levels[i_dim], i_node);
+				point[i_dim] = table.node(levels[i_dim], i_node);
+				weights[i_dim] = table.weight(levels[i_dim], i_node);
+				lowerWeights[i_dim] = table.weight_at_fine_index(levels[i_dim] - 1, key[i_dim]);
+			}
+
+			if ( onInfiniteBound )	// the points on infinite bounds get zero weight, as the integrand has to vanish there for the integral to exist
+			{
+				continue;
+			}
+
+			std::size_t i_slot;
+
+			if ( cache.find_or_claim(key.data(), i_slot) )	// evaluate the integrand only at points that are not in the cache yet
+			{
+				cache.value(i_slot) = func(argsFix, point.data());
+			}
+
+			const double value = cache.value(i_slot);
+
+			leadingWeights[0] = 1.0;	// products of the weights in all dimensions before the current one
+
+			for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )
+			{
+				leadingWeights[i_dim + 1] = leadingWeights[i_dim] * weights[i_dim];
+			}
+
+			values[0] += leadingWeights[dimInt] * value;
+
+			double trailingWeight = 1.0;	// product of the weights in all dimensions after the current one
+
+			for ( std::size_t i_dim = dimInt; i_dim-- > 0; )
+			{
+				values[1 + i_dim] += leadingWeights[i_dim] * lowerWeights[i_dim] * trailingWeight * value;
+
+				trailingWeight *= weights[i_dim];
+			}
+		}
+	}
+
+	std::vector<double> values (dimInt + 1, 0.0);
+
+	for ( int i_thread = 0; i_thread < numThreads; ++i_thread )
+	{
+		for ( std::size_t i_value = 0; i_value <= dimInt; ++i_value )
+		{
+			values[i_value] += threadValues[i_thread][i_value];
+		}
+	}
+
+	return values;
+}
+
+std::size_t MultiDimInt::ParallelPAdaptiveCubatureAlgorithm::grid_size (const std::vector<std::size_t>& levels)
+{
+	const ClenshawCurtisTable& table = ClenshawCurtisTable::shared();
+
+	std::size_t numPoints = 1;
+
+	for ( std::size_t i_dim = 0; i_dim < levels.size(); ++i_dim )
+	{
+		const std::size_t numNodes = table.number_of_nodes(levels[i_dim]);
+
+		if ( numPoints > std::numeric_limits<std::size_t>::max() / numNodes )
+		{
+			return 0;
+		}
+
+		numPoints *= numNodes;
+	}
+
+	return numPoints;
+}
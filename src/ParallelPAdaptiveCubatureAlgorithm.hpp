@@ -0,0 +1,67 @@
+#ifndef MULTIDIMINT_PARALLEL_P_ADAPTIVE_CUBATURE_ALGORITHM_H
+#define MULTIDIMINT_PARALLEL_P_ADAPTIVE_CUBATURE_ALGORITHM_H
+
+#include "Algorithm.hpp"
+#include "EvaluationCache.hpp"
+
+#include <vector>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class implementing a parallelized native p-adaptive cubature algorithm based on nested Clenshaw-Curtis rules.
+	 *
+	 * The algorithm follows the p-adaptive scheme of the <a href="https://github.com/stevengj/cubature">Cubature libarary</a>
+	 * used by CubatureParallelPAdaptiveAlgorithm: The whole unit hypercube is integrated with a tensor product of nested
+	 * Clenshaw-Curtis rules, and the error in each dimension is estimated by the difference to the rule whose level is
+	 * lower by one in that dimension. The level in the dimension with the largest error is then raised until the largest
+	 * error meets the error limits, the maximal number of integrand evaluations would be exceeded, or the highest level
+	 * ClenshawCurtisTable::MaxLevel is reached. This is well suited for smooth integrands in a few dimensions.
+	 *
+	 * In contrast to the Cubature library, the nodes and weights are not recomputed for every integration, but taken from
+	 * the shared, read-only ClenshawCurtisTable. Each refinement step traverses the whole tensor grid in parallel, and the
+	 * integrand values of the points of the coarser grids are kept in a lock-free EvaluationCache, such that all threads can
+	 * look them up and insert the newly evaluated points concurrently.
+	 *
+	 * As the outermost nodes of the Clenshaw-Curtis rules lie on the boundary of the unit hypercube, the nodes on bounds
+	 * that are infinite (see Algorithm::set_infinite_bounds) get zero weight instead of being evaluated.
+	 */
+	class ParallelPAdaptiveCubatureAlgorithm : public Algorithm
+	{
+	public:
+		/**
+		 * Constructor instantiating a parallelized native p-adaptive cubature scheme with absolute error limit \a absErr,
+		 * relative error limit \a absRel and maximal number of integrand evaluations \a maxEval, which is unlimited if it
+		 * is 0.
+		 */
+		ParallelPAdaptiveCubatureAlgorithm (double absErr, double relErr, std::size_t maxEval);
+
+		Algorithm::Result run (const InternalIntegrand& func, std::size_t dimInt, const double* argsFix) const;
+
+		bool is_parallelized () const;
+
+		ParallelPAdaptiveCubatureAlgorithm* clone () const;
+
+	private:
+		/**
+		 * Integrates the Algorithm::InternalIntegrand \a func with fixed arguments \a argsFix with the tensor product of
+		 * the Clenshaw-Curtis rules of the levels \a levels, evaluating it in parallel at all grid points that are not in
+		 * \a cache yet. The value of the integral is written into the first entry of the returned vector, followed by the
+		 * values for the rules whose level is lower by one in each dimension.
+		 */
+		std::vector<double> integrate_grid (const InternalIntegrand& func, const double* argsFix, const std::vector<std::size_t>& levels, EvaluationCache& cache) const;
+
+		/**
+		 * Returns the number of points of the tensor grid of the Clenshaw-Curtis rules of the levels \a levels, or 0 if it
+		 * exceeds the largest representable number.
+		 */
+		static std::size_t grid_size (const std::vector<std::size_t>& levels);
+
+		/**
+		 * Maximal number of integrand evaluations, which is unlimited if this is 0.
+		 */
+		std::size_t MaxEval;
+	};
+}
+
+#endif
@@ -0,0 +1,327 @@
+#include "PortfolioAlgorithm.hpp"
+
+#include "CubaAlgorithm.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <numeric>
+
+#include <omp.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::PortfolioAlgorithm::Member::Member (const Algorithm& alg) :
+	Alg(alg.clone())
+{}
+
+MultiDimInt::PortfolioAlgorithm::Member::Member (const Member& otherMember) :
+	Alg(otherMember.Alg->clone())
+{}
+
+MultiDimInt::PortfolioAlgorithm::Member& MultiDimInt::PortfolioAlgorithm::Member::operator= (const Member& otherMember)
+{
+	Alg.reset(otherMember.Alg->clone());
+
+	return *this;
+}
+
+MultiDimInt::PortfolioAlgorithm::PortfolioAlgorithm (const double absErr, const double relErr, const std::vector<Member>& members, const std::size_t narrowAfterWins) :
+	Algorithm(absErr, relErr),
+	Members(members),
+	NarrowAfterWins(narrowAfterWins)
+{
+	if ( Members.empty() )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::PortfolioAlgorithm Error: No members given" << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::PortfolioAlgorithm::run (const InternalIntegrand& func, const std::size_t dimInt, const double* argsFix) const
+{
+	return integrate(&func, NULL, dimInt, argsFix);
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::PortfolioAlgorithm::run_batch (const InternalBatchIntegrand& func, const std::size_t dimInt, const double* argsFix) const
+{
+	return integrate(NULL, &func, dimInt, argsFix);
+}
+
+bool MultiDimInt::PortfolioAlgorithm::is_parallelized () const
+{
+	return true;	// the members race in parallel
+}
+
+MultiDimInt::PortfolioAlgorithm* MultiDimInt::PortfolioAlgorithm::clone () const
+{
+	return new PortfolioAlgorithm(*this);
+}
+
+void MultiDimInt::PortfolioAlgorithm::set_given_points (const std::vector<double>& givenPoints)
+{
+	for ( Member& member : Members )
+	{
+		member.Alg->set_given_points(givenPoints);
+	}
+}
+
+void MultiDimInt::PortfolioAlgorithm::set_infinite_bounds (const std::vector<bool>& infiniteBounds)
+{
+	for ( Member& member : Members )
+	{
+		member.Alg->set_infinite_bounds(infiniteBounds);
+	}
+}
+
+std::vector<std::size_t> MultiDimInt::PortfolioAlgorithm::win_counts (const std::size_t dimInt) const
+{
+	const std::string key = record_key(dimInt);
+
+	std::vector<std::size_t> wins (Members.size(), 0);
+
+	if ( not key.empty() )
+	{
+		std::lock_guard<std::mutex> lock (win_records_mutex());
+
+		const auto record = win_records().find(key);
+
+		if ( record != win_records().end() )
+		{
+			wins = record->second;
+		}
+	}
+
+	return wins;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
+
+MultiDimInt::Algorithm::Result MultiDimInt::PortfolioAlgorithm::integrate (const InternalIntegrand* func, const InternalBatchIntegrand* batchFunc, const std::size_t dimInt, const double* argsFix) const
+{
+	const std::string key = record_key(dimInt);
+
+	std::vector<std::size_t> racers (Members.size());
+
+	std::iota(racers.begin(), racers.end(), 0);
+
+	Algorithm::Result leaderIntegral = {true, 0.0, std::numeric_limits<double>::infinity(), ""};	// result of the member the portfolio has been narrowed to, if any
+
+	std::size_t winner = Members.size();
+
+	if ( (NarrowAfterWins > 0) && (not key.empty()) )
+	{
+		const std::vector<std::size_t> wins = win_counts(dimInt);
+
+		const std::size_t leader = std::max_element(wins.begin(), wins.end()) - wins.begin();
+		const std::size_t totalWins = std::accumulate(wins.begin(), wins.end(), std::size_t(0));
+
+		if ( (wins[leader] >= NarrowAfterWins) && (2 * wins[leader] > totalWins) )	// the leader has won more races than all other members together
+		{
+			leaderIntegral = race(func, batchFunc, dimInt, argsFix, std::vector<std::size_t>(1, leader), winner);
+
+			racers.erase(racers.begin() + leader);
+
+			if ( (winner == leader) || racers.empty() || leaderIntegral.DeadlineReached )
+			{
+				racers.clear();
+			}
+		}
+	}
+
+	Algorithm::Result integral = leaderIntegral;
+
+	if ( not racers.empty() )
+	{
+		integral = race(func, batchFunc, dimInt, argsFix, racers, winner);
+
+		if ( integral.Failed && is_finite(leaderIntegral.Value) && (leaderIntegral.Error < integral.Error) )	// keep the estimate of the leader if it is still the best one
+		{
+			integral.Value = leaderIntegral.Value;
+			integral.Error = leaderIntegral.Error;
+		}
+	}
+
+	if ( (winner < Members.size()) && (not key.empty()) )
+	{
+		std::lock_guard<std::mutex> lock (win_records_mutex());
+
+		std::vector<std::size_t>& wins = win_records()[key];
+
+		wins.resize(Members.size(), 0);
+
+		++wins[winner];
+	}
+
+	return integral;
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::PortfolioAlgorithm::race (const InternalIntegrand* func, const InternalBatchIntegrand* batchFunc, const std::size_t dimInt, const double* argsFix, const std::vector<std::size_t>& racers, std::size_t& winner) const
+{
+	const std::size_t numRacers = racers.size();
+
+	std::atomic<bool> finished (false);				// set as soon as one racer has met the error limits
+	std::atomic<std::size_t> winningRacer (numRacers);
+
+	const CancellationToken raceToken;				// stops the other racers at their next check of the deadline once one has won
+
+	const InternalIntegrand cancellableFunc = [&] (const double* argsFix, const double* argsInt)
+	{
+		if ( finished.load(std::memory_order_relaxed) )
+		{
+			return std::numeric_limits<double>::quiet_NaN();
+		}
+
+		if ( func != NULL )
+		{
+			return (*func)(argsFix, argsInt);
+		}
+
+		double value;
+
+		(*batchFunc)(argsFix, 1, argsInt, &value);
+
+		return value;
+	};
+
+	const InternalBatchIntegrand cancellableBatchFunc = [&] (const double* argsFix, const std::size_t numPoints, const double* argsInt, double* values)	// only used if batchFunc is given
+	{
+		if ( finished.load(std::memory_order_relaxed) )
+		{
+			std::fill_n(values, numPoints, std::numeric_limits<double>::quiet_NaN());
+
+			return;
+		}
+
+		(*batchFunc)(argsFix, numPoints, argsInt, values);
+	};
+
+	std::vector<Algorithm::Result> results (numRacers, Algorithm::Result{true, 0.0, std::numeric_limits<double>::infinity(), "	-Portfolio error: Member was cancelled before it started"});
+
+	auto run_racer = [&] (const std::size_t i_racer)
+	{
+		if ( finished.load() )
+		{
+			return;
+		}
+
+		const std::unique_ptr<Algorithm> racer (Members[racers[i_racer]].Alg->clone());	// a fresh copy, such that no state of a cancelled member persists
+
+		CubaAlgorithm* const cubaRacer = dynamic_cast<CubaAlgorithm*>(racer.get());
+
+		if ( (cubaRacer != NULL) && (not cubaRacer->uses_thread_mode()) )	// forked Cuba workers would never see that the race is over
+		{
+			cubaRacer->set_thread_mode(true);
+		}
+
+		Context racerContext = IntegrationContext;	// the members do not report their progress, which would interleave
+
+		racerContext.Monitor = nullptr;
+		racerContext.IntegrationDeadline = Deadline(IntegrationContext.IntegrationDeadline, raceToken);
+
+		racer->set_context(racerContext);
+
+		results[i_racer] = (func != NULL) ? racer->run(cancellableFunc, dimInt, argsFix) : racer->run_batch(cancellableBatchFunc, dimInt, argsFix);
+
+		std::size_t noWinner = numRacers;
+
+		if ( meets_error_limits(results[i_racer]) && winningRacer.compare_exchange_strong(noWinner, i_racer) )
+		{
+			finished.store(true);
+
+			raceToken.cancel();
+		}
+	};
+
+	if ( numRacers == 1 )	// a single member keeps all threads for itself
+	{
+		run_racer(0);
+	}
+	else
+	{
+		#pragma omp parallel for schedule(dynamic, 1) num_threads(static_cast<int>(numRacers))
+		for ( std::size_t i_racer = 0; i_racer < numRacers; ++i_racer )
+		{
+			run_racer(i_racer);
+		}
+	}
+
+	if ( winningRacer.load() < numRacers )
+	{
+		winner = racers[winningRacer.load()];
+
+		return results[winningRacer.load()];
+	}
+
+	winner = Members.size();
+
+	Algorithm::Result bestIntegral = {true, 0.0, std::numeric_limits<double>::infinity(), ""};	// failed result with the smallest error estimate
+
+	std::string comments ("");
+
+	for ( std::size_t i_racer = 0; i_racer < numRacers; ++i_racer )
+	{
+		comments += std::string("	-Portfolio member ") + std::to_string(racers[i_racer] + 1) + std::string(results[i_racer].DeadlineReached ? " stopped:" : " failed:") + std::string("\n")
+				  + results[i_racer].Comment + std::string("\n");
+
+		if ( is_finite(results[i_racer].Value) && (results[i_racer].Error < bestIntegral.Error) )
+		{
+			bestIntegral = results[i_racer];
+		}
+	}
+
+	if ( deadline_reached() && is_finite(bestIntegral.Error) )
+	{
+		bestIntegral.Failed = false;
+		bestIntegral.DeadlineReached = true;
+
+		bestIntegral.Comment = comments + std::string("	-Portfolio: Deadline reached before any member met the error limits, returning the result with the smallest error estimate");
+
+		return bestIntegral;
+	}
+
+	bestIntegral.Failed = true;
+
+	bestIntegral.Comment = comments + std::string("	-Portfolio error: No member met the error limits, returning the result with the smallest error estimate");
+
+	return bestIntegral;
+}
+
+bool MultiDimInt::PortfolioAlgorithm::meets_error_limits (const Algorithm::Result& integral) const
+{
+	return (not integral.Failed) && ((integral.Error <= AbsErr) || (integral.Error <= RelErr * std::abs(integral.Value)));
+}
+
+std::string MultiDimInt::PortfolioAlgorithm::record_key (const std::size_t dimInt) const
+{
+	if ( IntegrationContext.Identifier.empty() )
+	{
+		return "";
+	}
+
+	return IntegrationContext.Identifier + "/" + std::to_string(dimInt) + "/" + std::to_string(Members.size());
+}
+
+std::map<std::string, std::vector<std::size_t>>& MultiDimInt::PortfolioAlgorithm::win_records ()
+{
+	static std::map<std::string, std::vector<std::size_t>> records;
+
+	return records;
+}
+
+std::mutex& MultiDimInt::PortfolioAlgorithm::win_records_mutex ()
+{
+	static std::mutex mutex;
+
+	return mutex;
+}
@@ -0,0 +1,143 @@
+#ifndef MULTIDIMINT_PORTFOLIO_ALGORITHM_H
+#define MULTIDIMINT_PORTFOLIO_ALGORITHM_H
+
+#include "Algorithm.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class implementing a race between several integration algorithms.
+	 *
+	 * The PortfolioAlgorithm runs copies of all its member algorithms concurrently, each in its own OpenMP thread, and
+	 * returns the first result that meets its own error limits. Members that are parallelized themselves only use a
+	 * single thread during the race, unless nested parallelism is enabled. Each race derives a Deadline of its own from
+	 * the one of the PortfolioAlgorithm, which is reached as soon as one member has won, such that all others stop at
+	 * their next check of the deadline. As the algorithms leaving the iterations to an external library do not check it,
+	 * the integrand additionally returns NaN to the losing members, which makes them finish their remaining evaluations
+	 * quickly. For this to reach them, members derived from CubaAlgorithm always race in the thread mode (see
+	 * CubaAlgorithm::set_thread_mode), as the worker processes Cuba forks otherwise would not notice the end of the race.
+	 * The results of the losing members are discarded.
+	 *
+	 * The wins of each member are recorded per identifier of the Integrator using the PortfolioAlgorithm and per number
+	 * of integration variables. Once one member has won a given number of races and more often than all others together,
+	 * later integrations narrow the portfolio to this member alone, which then has all threads at its disposal. Only if
+	 * it fails to meet the error limits, the remaining members race again. Integrators without identifier always race
+	 * all members.
+	 *
+	 * If no member meets the error limits, the PortfolioAlgorithm returns the result with the smallest error estimate
+	 * among them, together with their comments. The members do not report their progress, as the reports of several
+	 * members running concurrently would interleave.
+	 */
+	class PortfolioAlgorithm : public Algorithm
+	{
+	public:
+		/**
+		 * Structure holding a copy \a Alg of one member algorithm of the PortfolioAlgorithm.
+		 */
+		struct Member
+		{
+			/**
+			 * Constructor instantiating a member with a copy of the integration algorithm \a alg. It is implicit, such
+			 * that the members can be given as a list of algorithms.
+			 */
+			Member (const Algorithm& alg);
+
+			/**
+			 * Copy-constructor creating a copy of the integration algorithm of the Member \a otherMember.
+			 */
+			Member (const Member& otherMember);
+
+			/**
+			 * Assignment operator creating a copy of the integration algorithm of the Member \a otherMember.
+			 */
+			Member& operator= (const Member& otherMember);
+
+			std::unique_ptr<Algorithm> Alg;
+		};
+
+		/**
+		 * Constructor instantiating a race between the integration algorithms in \a members with absolute error limit
+		 * \a absErr and relative error limit \a absRel. The portfolio is narrowed to a single member once it has won
+		 * \a narrowAfterWins races, where 0 disables the narrowing.
+		 */
+		PortfolioAlgorithm (double absErr, double relErr, const std::vector<Member>& members, std::size_t narrowAfterWins = 3);
+
+		Algorithm::Result run (const InternalIntegrand& func, std::size_t dimInt, const double* argsFix) const;
+
+		Algorithm::Result run_batch (const InternalBatchIntegrand& func, std::size_t dimInt, const double* argsFix) const;
+
+		bool is_parallelized () const;
+
+		PortfolioAlgorithm* clone () const;
+
+		/**
+		 * Passes the points \a givenPoints on to all member algorithms.
+		 */
+		void set_given_points (const std::vector<double>& givenPoints);
+
+		/**
+		 * Passes the flags \a infiniteBounds on to all member algorithms.
+		 */
+		void set_infinite_bounds (const std::vector<bool>& infiniteBounds);
+
+		/**
+		 * Returns the number of races each member has won so far in integrations over \a dimInt variables by Integrators
+		 * with the identifier of the Integrator using this PortfolioAlgorithm.
+		 */
+		std::vector<std::size_t> win_counts (std::size_t dimInt) const;
+
+	private:
+		/**
+		 * Integrates the Algorithm::InternalIntegrand \a func, or the Algorithm::InternalBatchIntegrand \a batchFunc if
+		 * \a func is \c NULL, with fixed arguments \a argsFix and \a dimInt integration variables, narrowing the portfolio
+		 * if one member has dominated the earlier races.
+		 */
+		Algorithm::Result integrate (const InternalIntegrand* func, const InternalBatchIntegrand* batchFunc, std::size_t dimInt, const double* argsFix) const;
+
+		/**
+		 * Races the members with indices \a racers, integrating as described for PortfolioAlgorithm::integrate, and writes
+		 * the index of the winning member to \a winner, or the number of members if none meets the error limits.
+		 */
+		Algorithm::Result race (const InternalIntegrand* func, const InternalBatchIntegrand* batchFunc, std::size_t dimInt, const double* argsFix, const std::vector<std::size_t>& racers, std::size_t& winner) const;
+
+		/**
+		 * Returns \c true if the Algorithm::Result \a integral did not fail and meets the error limits.
+		 */
+		bool meets_error_limits (const Algorithm::Result& integral) const;
+
+		/**
+		 * Returns the key of the records of the wins for integrations over \a dimInt variables, which is empty if the
+		 * Integrator using this PortfolioAlgorithm has no identifier.
+		 */
+		std::string record_key (std::size_t dimInt) const;
+
+		/**
+		 * Returns the records of the wins of the members, with the key provided by PortfolioAlgorithm::record_key, which
+		 * are shared by all instances of PortfolioAlgorithm.
+		 */
+		static std::map<std::string, std::vector<std::size_t>>& win_records ();
+
+		/**
+		 * Returns the mutex guarding the records of the wins.
+		 */
+		static std::mutex& win_records_mutex ();
+
+		/**
+		 * Member algorithms racing each other.
+		 */
+		std::vector<Member> Members;
+
+		/**
+		 * Number of races a member has to win before the portfolio is narrowed to it, where 0 disables the narrowing.
+		 */
+		std::size_t NarrowAfterWins;
+	};
+}
+
+#endif
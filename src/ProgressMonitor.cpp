@@ -0,0 +1,65 @@
+#include "ProgressMonitor.hpp"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::ProgressMonitor::ProgressMonitor (const Callback& callback, const bool recordHistory) :
+	ProgressCallback(callback),
+	RecordHistory(recordHistory),
+	StartTime(std::chrono::steady_clock::now()),
+	History(),
+	Mutex()
+{}
+
+MultiDimInt::ProgressMonitor::ProgressMonitor (const ProgressMonitor& otherProgressMonitor) :
+	ProgressMonitor(otherProgressMonitor.ProgressCallback, otherProgressMonitor.RecordHistory)
+{}
+
+void MultiDimInt::ProgressMonitor::start ()
+{
+	std::lock_guard<std::mutex> lock (Mutex);
+
+	StartTime = std::chrono::steady_clock::now();
+
+	History.clear();
+}
+
+void MultiDimInt::ProgressMonitor::report (const double value, const double error, const std::size_t numEval)
+{
+	std::lock_guard<std::mutex> lock (Mutex);
+
+	const Progress progress = {value, error, numEval, std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count()};
+
+	if ( RecordHistory )
+	{
+		History.push_back(progress);
+	}
+
+	if ( ProgressCallback )
+	{
+		ProgressCallback(progress);
+	}
+}
+
+const MultiDimInt::ProgressMonitor::Callback& MultiDimInt::ProgressMonitor::callback () const
+{
+	return ProgressCallback;
+}
+
+bool MultiDimInt::ProgressMonitor::records_history () const
+{
+	return RecordHistory;
+}
+
+std::vector<MultiDimInt::ProgressMonitor::Progress> MultiDimInt::ProgressMonitor::history () const
+{
+	std::lock_guard<std::mutex> lock (Mutex);
+
+	return History;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
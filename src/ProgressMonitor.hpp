@@ -0,0 +1,109 @@
+#ifndef MULTIDIMINT_PROGRESS_MONITOR_H
+#define MULTIDIMINT_PROGRESS_MONITOR_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class collecting the progress of running integrations.
+	 *
+	 * Integration algorithms that iterate report their current estimate after each iteration, pass or round, which is
+	 * handed to a callback and optionally recorded as the convergence history of the integration. The ProgressMonitor
+	 * is passed to the algorithms as part of their Algorithm::Context by the Integrator, see
+	 * Integrator::set_progress_callback. The reports are serialized by a mutex, such that the callback never runs
+	 * concurrently with itself, even if an algorithm reports from several threads.
+	 */
+	class ProgressMonitor
+	{
+	public:
+		/**
+		 * Structure describing the state of an integration after one iteration. \a Value and \a Error are the current
+		 * estimates of the integral and its absolute error, \a NumEval is the number of integrand evaluations used so
+		 * far, and \a ElapsedTime is the wall-clock time in seconds since the integration started.
+		 */
+		struct Progress
+		{
+			double Value;
+			double Error;
+			std::size_t NumEval;
+			double ElapsedTime;
+		};
+
+		/**
+		 * Functions receiving the reports are expected to be of this form. They are called by the thread running the
+		 * integration, so they should return quickly. To stop the integration early, they can cancel the
+		 * CancellationToken of the Integrator.
+		 */
+		using Callback = std::function<void(const Progress& progress)>;
+
+		/**
+		 * Constructor instantiating a monitor that passes all reports on to \a callback, which may be empty, and records
+		 * them if \a recordHistory is \c true.
+		 */
+		ProgressMonitor (const Callback& callback, bool recordHistory);
+
+		/**
+		 * Copy-constructor creating a monitor with the same callback and recording mode as the ProgressMonitor
+		 * \a otherProgressMonitor, but with an empty history.
+		 */
+		ProgressMonitor (const ProgressMonitor& otherProgressMonitor);
+
+		/**
+		 * Restarts the clock and clears the history at the beginning of a new integration.
+		 */
+		void start ();
+
+		/**
+		 * Reports the current estimates \a value and \a error of the integral after \a numEval integrand evaluations.
+		 */
+		void report (double value, double error, std::size_t numEval);
+
+		/**
+		 * Returns the function receiving the reports.
+		 */
+		const Callback& callback () const;
+
+		/**
+		 * Returns \c true if the reports are recorded.
+		 */
+		bool records_history () const;
+
+		/**
+		 * Returns all reports since the last call of ProgressMonitor::start, if they are recorded.
+		 */
+		std::vector<Progress> history () const;
+
+	private:
+		/**
+		 * Function receiving the reports.
+		 */
+		Callback ProgressCallback;
+
+		/**
+		 * Whether the reports are recorded.
+		 */
+		bool RecordHistory;
+
+		/**
+		 * Point in time at which the current integration started.
+		 */
+		std::chrono::steady_clock::time_point StartTime;
+
+		/**
+		 * Reports recorded since the current integration started.
+		 */
+		std::vector<Progress> History;
+
+		/**
+		 * Mutex serializing the reports.
+		 */
+		mutable std::mutex Mutex;
+	};
+}
+
+#endif
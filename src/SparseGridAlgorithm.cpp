@@ -0,0 +1,322 @@
+#include "SparseGridAlgorithm.hpp"
+
+#include "ClenshawCurtisTable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <string>
+
+#include <omp.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::SparseGridAlgorithm::SparseGridAlgorithm (const double absErr, const double relErr, const std::size_t maxEval) :
+	Algorithm(absErr, relErr),
+	MaxEval(maxEval)
+{}
+
+MultiDimInt::Algorithm::Result MultiDimInt::SparseGridAlgorithm::run (const InternalIntegrand& func, const std::size_t dimInt, const double* argsFix) const
+{
+	EvaluationCache cache (dimInt);
+
+	std::set<MultiIndex> oldIndices;			// multi-indices that have already been replaced by their forward neighbors
+	std::vector<ActiveIndex> activeIndices;		// multi-indices at the border of the sparse grid
+
+	std::vector<MultiIndex> newIndices (1, MultiIndex(dimInt, 0));	// start with the midpoint rule
+
+	std::size_t numEval = 0;
+
+	Algorithm::Result integral = {false, 0.0, 0.0, ""};
+
+	while ( true )
+	{
+		std::size_t numNew = 0;
+
+		for ( std::size_t i_index = 0; i_index < newIndices.size(); ++i_index )
+		{
+			const std::size_t numNewPoints = number_of_new_points(newIndices[i_index]);
+
+			numNew = (numNewPoints > std::numeric_limits<std::size_t>::max() - numNew) ? std::numeric_limits<std::size_t>::max() : numNew + numNewPoints;
+		}
+
+		if ( (numNew == std::numeric_limits<std::size_t>::max()) || ((MaxEval > 0) && (numEval + numNew > MaxEval)) )
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-Sparse grid error: Maximal number of integrand evaluations reached";
+
+			return integral;
+		}
+
+		cache.reserve(numEval + numNew);
+
+		const std::vector<double> newContributions = contributions(func, argsFix, newIndices, cache);
+
+		numEval += numNew;
+
+		for ( std::size_t i_index = 0; i_index < newIndices.size(); ++i_index )
+		{
+			activeIndices.push_back(ActiveIndex{newIndices[i_index], newContributions[i_index]});
+
+			integral.Value += newContributions[i_index];
+		}
+
+		integral.Error = 0.0;	// the surpluses at the border of the sparse grid estimate the error
+
+		for ( std::size_t i_active = 0; i_active < activeIndices.size(); ++i_active )
+		{
+			integral.Error += std::abs(activeIndices[i_active].Contribution);
+		}
+
+		report_progress(integral.Value, integral.Error, numEval);
+
+		if ( not is_finite(integral.Value) )
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-Sparse grid error: Integral value is not finite";
+
+			return integral;
+		}
+
+		if ( (not oldIndices.empty()) && ((integral.Error <= AbsErr) || (integral.Error <= RelErr * std::abs(integral.Value))) )	// the midpoint rule alone provides no meaningful error estimate
+		{
+			return integral;
+		}
+
+		if ( deadline_reached() )
+		{
+			integral.DeadlineReached = true;
+
+			integral.Comment = "	-Sparse grid: Deadline reached before meeting the error limits";
+
+			return integral;
+		}
+
+		if ( activeIndices.empty() )
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-Sparse grid error: Highest level of the Clenshaw-Curtis rules reached";
+
+			return integral;
+		}
+
+		auto largestContribution = std::max_element(activeIndices.begin(), activeIndices.end(), [] (const ActiveIndex& first, const ActiveIndex& second) { return std::abs(first.Contribution) < std::abs(second.Contribution); });
+
+		const MultiIndex index = largestContribution->Index;
+
+		*largestContribution = activeIndices.back();	// replace the multi-index with the largest contribution...
+		activeIndices.pop_back();
+
+		oldIndices.insert(index);
+
+		newIndices.clear();
+
+		for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )	// ...by all its forward neighbors whose backward neighbors have all been replaced as well
+		{
+			if ( index[i_dim] == ClenshawCurtisTable::MaxLevel )
+			{
+				continue;
+			}
+
+			MultiIndex forwardIndex = index;
+
+			++forwardIndex[i_dim];
+
+			bool admissible = true;
+
+			for ( std::size_t j_dim = 0; (j_dim < dimInt) && admissible; ++j_dim )
+			{
+				if ( (j_dim != i_dim) && (forwardIndex[j_dim] > 0) )
+				{
+					MultiIndex backwardIndex = forwardIndex;
+
+					--backwardIndex[j_dim];
+
+					admissible = (oldIndices.count(backwardIndex) > 0);
+				}
+			}
+
+			if ( admissible )
+			{
+				newIndices.push_back(forwardIndex);
+			}
+		}
+	}
+}
+
+bool MultiDimInt::SparseGridAlgorithm::is_parallelized () const
+{
+	return true;
+}
+
+MultiDimInt::SparseGridAlgorithm* MultiDimInt::SparseGridAlgorithm::clone () const
+{
+	return new SparseGridAlgorithm(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
+
+std::vector<double> MultiDimInt::SparseGridAlgorithm::contributions (const InternalIntegrand& func, const double* argsFix, const std::vector<MultiIndex>& indices, EvaluationCache& cache) const
+{
+	const ClenshawCurtisTable& table = ClenshawCurtisTable::shared();
+
+	const std::size_t numIndices = indices.size();
+
+	if ( numIndices == 0 )
+	{
+		return std::vector<double>();
+	}
+
+	const std::size_t dimInt = indices[0].size();
+
+	std::vector<std::size_t> newOffsets (numIndices + 1, 0);	// the new points and all points of the multi-indices are each enumerated consecutively
+	std::vector<std::size_t> offsets (numIndices + 1, 0);
+
+	for ( std::size_t i_index = 0; i_index < numIndices; ++i_index )
+	{
+		std::size_t numPoints = 1;
+
+		for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )
+		{
+			numPoints *= table.number_of_nodes(indices[i_index][i_dim]);
+		}
+
+		newOffsets[i_index + 1] = newOffsets[i_index] + number_of_new_points(indices[i_index]);
+		offsets[i_index + 1] = offsets[i_index] + numPoints;
+	}
+
+	const int numThreads = omp_get_max_threads();
+
+	std::vector<std::vector<double>> threadContributions (numThreads, std::vector<double>(numIndices, 0.0));	// partial sums of each thread, which are added up in a fixed order below
+
+	#pragma omp parallel num_threads(numThreads)
+	{
+		std::vector<double>& partialContributions = threadContributions[omp_get_thread_num()];
+
+		std::vector<std::uint32_t> key (dimInt);
+		std::vector<double> point (dimInt);
+
+		#pragma omp for schedule(dynamic, 16)
+		for ( std::size_t i_newPoint = 0; i_newPoint < newOffsets[numIndices]; ++i_newPoint )	// evaluate the integrand at the new points of all multi-indices as one batch
+		{
+			const std::size_t i_index = std::upper_bound(newOffsets.begin(), newOffsets.end(), i_newPoint) - newOffsets.begin() - 1;
+
+			std::size_t remainder = i_newPoint - newOffsets[i_index];
+
+			bool onInfiniteBound = false;
+
+			for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )
+			{
+				const std::size_t level = indices[i_index][i_dim];
+				const std::size_t numNewNodes = number_of_new_nodes(level);
+				const std::size_t i_node = new_node_index(level, remainder % numNewNodes);
+
+				remainder /= numNewNodes;
+
+				key[i_dim] = table.fine_index(level, i_node);
+				point[i_dim] = table.node(level, i_node);
+
+				if ( (level > 0) && (((i_node == 0) && infinite_bound(i_dim, false)) || ((i_node == table.number_of_nodes(level) - 1) && infinite_bound(i_dim, true))) )
+				{
+					onInfiniteBound = true;
+				}
+			}
+
+			std::size_t i_slot;
+
+			if ( cache.find_or_claim(key.data(), i_slot) )	// the points on infinite bounds get zero weight, as the integrand has to vanish there for the integral to exist
+			{
+				cache.value(i_slot) = onInfiniteBound ? 0.0 : func(argsFix, point.data());
+			}
+		}	// the implicit barrier makes all new values visible below
+
+		#pragma omp for schedule(static)
+		for ( std::size_t i_point = 0; i_point < offsets[numIndices]; ++i_point )	// add up the products of the differences of the weights of successive levels over all points of each multi-index
+		{
+			const std::size_t i_index = std::upper_bound(offsets.begin(), offsets.end(), i_point) - offsets.begin() - 1;
+
+			std::size_t remainder = i_point - offsets[i_index];
+
+			double weight = 1.0;
+
+			for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )
+			{
+				const std::size_t level = indices[i_index][i_dim];
+				const std::size_t numNodes = table.number_of_nodes(level);
+				const std::size_t i_node = remainder % numNodes;
+
+				remainder /= numNodes;
+
+				key[i_dim] = table.fine_index(level, i_node);
+
+				weight *= table.weight(level, i_node) - ((level > 0) ? table.weight_at_fine_index(level - 1, key[i_dim]) : 0.0);
+			}
+
+			std::size_t i_slot;
+
+			cache.find_or_claim(key.data(), i_slot);	// all points of a multi-index whose backward neighbors have been evaluated are in the cache
+
+			partialContributions[i_index] += weight * cache.value(i_slot);
+		}
+	}
+
+	std::vector<double> contributions (numIndices, 0.0);
+
+	for ( int i_thread = 0; i_thread < numThreads; ++i_thread )
+	{
+		for ( std::size_t i_index = 0; i_index < numIndices; ++i_index )
+		{
+			contributions[i_index] += threadContributions[i_thread][i_index];
+		}
+	}
+
+	return contributions;
+}
+
+std::size_t MultiDimInt::SparseGridAlgorithm::number_of_new_points (const MultiIndex& index)
+{
+	std::size_t numPoints = 1;
+
+	for ( std::size_t i_dim = 0; i_dim < index.size(); ++i_dim )
+	{
+		const std::size_t numNewNodes = number_of_new_nodes(index[i_dim]);
+
+		if ( numPoints > std::numeric_limits<std::size_t>::max() / numNewNodes )
+		{
+			return std::numeric_limits<std::size_t>::max();
+		}
+
+		numPoints *= numNewNodes;
+	}
+
+	return numPoints;
+}
+
+std::size_t MultiDimInt::SparseGridAlgorithm::number_of_new_nodes (const std::size_t level)
+{
+	if ( level <= 1 )	// the midpoint at level 0, and both end points at level 1
+	{
+		return level + 1;
+	}
+
+	return std::size_t(1) << (level - 1);	// the nodes with odd indices at all higher levels
+}
+
+std::size_t MultiDimInt::SparseGridAlgorithm::new_node_index (const std::size_t level, const std::size_t i_newNode)
+{
+	if ( level <= 1 )
+	{
+		return 2 * i_newNode;
+	}
+
+	return 2 * i_newNode + 1;
+}
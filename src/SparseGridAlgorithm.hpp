@@ -0,0 +1,94 @@
+#ifndef MULTIDIMINT_SPARSE_GRID_ALGORITHM_H
+#define MULTIDIMINT_SPARSE_GRID_ALGORITHM_H
+
+#include "Algorithm.hpp"
+#include "EvaluationCache.hpp"
+
+#include <vector>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class implementing a native dimension-adaptive sparse grid integration algorithm.
+	 *
+	 * The algorithm follows Gerstner and Griebel: The integral is written as a sum of the tensor products of the differences
+	 * between nested Clenshaw-Curtis rules of successive levels (see ClenshawCurtisTable), one for each multi-index of levels.
+	 * Starting from the midpoint rule, the multi-index with the largest contribution is repeatedly replaced by those of its
+	 * forward neighbors whose backward neighbors have all been replaced already. The sum of the absolute contributions of
+	 * the multi-indices that have not been replaced yet, i.e. of the surpluses at the border of the sparse grid, serves as
+	 * the error estimate. The refinement stops once it meets the error limits, if the maximal number of integrand
+	 * evaluations would be exceeded, or if no multi-index is left below the highest level ClenshawCurtisTable::MaxLevel.
+	 *
+	 * As the sparse grid only grows along the dimensions and combinations of dimensions that contribute most, this takes
+	 * advantage of the smoothness of an integrand even in 8 to 20 dimensions, where tensor product rules are no longer
+	 * feasible. The integrand values are kept in a lock-free EvaluationCache, so no point is evaluated twice, and all new
+	 * points of the multi-indices added in one step are evaluated in parallel as a single batch.
+	 *
+	 * As the end points of the Clenshaw-Curtis rules lie on the boundary of the unit hypercube, the points on bounds that
+	 * are infinite (see Algorithm::set_infinite_bounds) get zero weight instead of being evaluated.
+	 */
+	class SparseGridAlgorithm : public Algorithm
+	{
+	public:
+		/**
+		 * Constructor instantiating a dimension-adaptive sparse grid integration scheme with absolute error limit \a absErr,
+		 * relative error limit \a absRel and maximal number of integrand evaluations \a maxEval, which is unlimited if it
+		 * is 0.
+		 */
+		SparseGridAlgorithm (double absErr, double relErr, std::size_t maxEval);
+
+		Algorithm::Result run (const InternalIntegrand& func, std::size_t dimInt, const double* argsFix) const;
+
+		bool is_parallelized () const;
+
+		SparseGridAlgorithm* clone () const;
+
+	private:
+		/**
+		 * Multi-index containing the level of the Clenshaw-Curtis rule in each dimension.
+		 */
+		using MultiIndex = std::vector<std::size_t>;
+
+		/**
+		 * Structure describing a multi-index \a Index that has not been replaced by its forward neighbors yet, together
+		 * with its \a Contribution to the integral.
+		 */
+		struct ActiveIndex
+		{
+			MultiIndex Index;
+			double Contribution;
+		};
+
+		/**
+		 * Evaluates the Algorithm::InternalIntegrand \a func with fixed arguments \a argsFix in parallel at the points that
+		 * are new for the multi-indices \a indices, stores the values in \a cache, and returns the contributions of the
+		 * multi-indices to the integral. All their backward neighbors must have been evaluated before.
+		 */
+		std::vector<double> contributions (const InternalIntegrand& func, const double* argsFix, const std::vector<MultiIndex>& indices, EvaluationCache& cache) const;
+
+		/**
+		 * Returns the number of points that are new for the multi-index \a index, i.e. that do not belong to any of its
+		 * backward neighbors, or the largest representable number if it is larger.
+		 */
+		static std::size_t number_of_new_points (const MultiIndex& index);
+
+		/**
+		 * Returns the number of nodes of the Clenshaw-Curtis rule of level \a level that do not belong to the rule of the
+		 * level below.
+		 */
+		static std::size_t number_of_new_nodes (std::size_t level);
+
+		/**
+		 * Returns the index of the node with index \a i_newNode among the nodes of the Clenshaw-Curtis rule of level \a level
+		 * that do not belong to the rule of the level below.
+		 */
+		static std::size_t new_node_index (std::size_t level, std::size_t i_newNode);
+
+		/**
+		 * Maximal number of integrand evaluations, which is unlimited if this is 0.
+		 */
+		std::size_t MaxEval;
+	};
+}
+
+#endif
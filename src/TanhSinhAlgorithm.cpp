@@ -0,0 +1,346 @@
+#include "TanhSinhAlgorithm.hpp"
+
+#include "TanhSinhTable.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+MultiDimInt::TanhSinhAlgorithm::TanhSinhAlgorithm (const double absErr, const double relErr, const std::size_t maxEval, const std::size_t maxTensorProductDim) :
+	Algorithm(absErr, relErr),
+	MaxEval(maxEval),
+	MaxTensorProductDim(maxTensorProductDim)
+{}
+
+MultiDimInt::Algorithm::Result MultiDimInt::TanhSinhAlgorithm::run (const InternalIntegrand& func, const std::size_t dimInt, const double* argsFix) const
+{
+	const InternalBatchIntegrand batchFunc = [&func, dimInt] (const double* argsFix, const std::size_t numPoints, const double* argsInt, double* values)	// evaluate the integrand point by point for each batch
+	{
+		for ( std::size_t i_point = 0; i_point < numPoints; ++i_point )
+		{
+			values[i_point] = func(argsFix, &argsInt[i_point * dimInt]);
+		}
+	};
+
+	return run_batch(batchFunc, dimInt, argsFix);
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::TanhSinhAlgorithm::run_batch (const InternalBatchIntegrand& func, const std::size_t dimInt, const double* argsFix) const
+{
+	std::size_t numEval = 0;
+
+	const double minAbscissa = std::pow(TanhSinhTable::MinAbscissa, 1.0 / dimInt);	// the Jacobians of the changes of variables for infinite boundaries are multiplied over all dimensions, so each factor has to stay below the 1/dimInt-th power of the largest finite one
+
+	if ( dimInt <= MaxTensorProductDim )
+	{
+		return integrate_tensor_product(func, dimInt, argsFix, minAbscissa, numEval);
+	}
+	else
+	{
+		std::vector<double> point (dimInt, 0.0);
+
+		bool budgetExhausted = false;
+
+		return integrate_nested(func, argsFix, minAbscissa, point, 0, numEval, budgetExhausted);
+	}
+}
+
+bool MultiDimInt::TanhSinhAlgorithm::is_parallelized () const
+{
+	return false;
+}
+
+MultiDimInt::TanhSinhAlgorithm* MultiDimInt::TanhSinhAlgorithm::clone () const
+{
+	return new TanhSinhAlgorithm(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
+
+MultiDimInt::Algorithm::Result MultiDimInt::TanhSinhAlgorithm::refine_levels (const std::function<bool(std::size_t level, double& sum, double& errorSum)>& addLevel, const std::size_t dimStep, const std::size_t* numEval) const
+{
+	const TanhSinhTable& table = TanhSinhTable::shared();
+
+	Algorithm::Result integral = {false, 0.0, 0.0, ""};
+
+	double sum = 0.0;		// weighted integrand values of all points used so far
+	double errorSum = 0.0;	// weighted errors of the inner integrals used so far
+
+	for ( std::size_t level = 0; level <= TanhSinhTable::MaxLevel; ++level )
+	{
+		if ( not addLevel(level, sum, errorSum) )
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-Tanh-sinh error: Maximal number of integrand evaluations reached";
+
+			return integral;
+		}
+
+		const double previousValue = integral.Value;
+		const double scale = std::pow(table.step(level), static_cast<double>(dimStep));
+
+		integral.Value = scale * sum;
+		integral.Error = std::abs(integral.Value - previousValue) + scale * errorSum;	// at level 0, this is just the absolute value of the integral
+
+		if ( numEval != NULL )
+		{
+			report_progress(integral.Value, integral.Error, *numEval);
+		}
+
+		if ( not is_finite(integral.Value) )
+		{
+			integral.Failed = true;
+
+			integral.Comment = "	-Tanh-sinh error: Integral value is not finite";
+
+			return integral;
+		}
+
+		if ( (level > 0) && ((integral.Error <= AbsErr) || (integral.Error <= RelErr * std::abs(integral.Value))) )
+		{
+			return integral;
+		}
+
+		if ( deadline_reached() )	// also stops the inner integrals of the nested rules, whose estimates so far enter the outer one
+		{
+			integral.DeadlineReached = true;
+
+			integral.Comment = "	-Tanh-sinh: Deadline reached before meeting the error limits";
+
+			return integral;
+		}
+	}
+
+	integral.Failed = true;
+
+	integral.Comment = "	-Tanh-sinh error: Highest level of the tanh-sinh rules reached";
+
+	return integral;
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::TanhSinhAlgorithm::integrate_tensor_product (const InternalBatchIntegrand& func, const std::size_t dimInt, const double* argsFix, const double minAbscissa, std::size_t& numEval) const
+{
+	const TanhSinhTable& table = TanhSinhTable::shared();
+
+	const std::size_t batchSize = 4096;	// maximal number of points passed to the integrand at once
+
+	std::vector<double> nodes;		// abscissas and weights of all levels used so far, which are the same in each dimension
+	std::vector<double> weights;
+
+	std::vector<double> batchPoints;
+	std::vector<double> batchWeights;
+	std::vector<double> batchValues (batchSize);
+
+	batchPoints.reserve(batchSize * dimInt);
+	batchWeights.reserve(batchSize);
+
+	auto flush_batch = [&] (double& sum)
+	{
+		const std::size_t numPoints = batchWeights.size();
+
+		func(argsFix, numPoints, batchPoints.data(), batchValues.data());
+
+		for ( std::size_t i_point = 0; i_point < numPoints; ++i_point )
+		{
+			sum += batchWeights[i_point] * batchValues[i_point];
+		}
+
+		numEval += numPoints;
+
+		batchPoints.clear();
+		batchWeights.clear();
+	};
+
+	auto addLevel = [&] (const std::size_t level, double& sum, double& errorSum)
+	{
+		const std::size_t numOldNodes = nodes.size();
+
+		for ( std::size_t i_node = 0; i_node < table.number_of_nodes(level); ++i_node )
+		{
+			if ( table.node(level, i_node) >= minAbscissa )
+			{
+				nodes.push_back(table.node(level, i_node));
+				weights.push_back(table.weight(level, i_node));
+			}
+		}
+
+		const std::size_t numNodes = nodes.size();
+
+		const double numNew = std::pow(static_cast<double>(numNodes), static_cast<double>(dimInt)) - std::pow(static_cast<double>(numOldNodes), static_cast<double>(dimInt));	// points with at least one coordinate that is new at this level
+
+		if ( (numNew > 1e18) || (not within_budget(numEval, static_cast<std::size_t>(numNew))) )
+		{
+			return false;
+		}
+
+		std::vector<std::size_t> indices (dimInt, 0);	// indices of the nodes of the current point in each dimension
+
+		while ( true )
+		{
+			if ( std::any_of(indices.begin(), indices.end(), [numOldNodes] (const std::size_t i_node) { return i_node >= numOldNodes; }) )
+			{
+				double weight = 1.0;
+
+				for ( std::size_t i_dim = 0; i_dim < dimInt; ++i_dim )
+				{
+					batchPoints.push_back(nodes[indices[i_dim]]);
+
+					weight *= weights[indices[i_dim]];
+				}
+
+				batchWeights.push_back(weight);
+
+				if ( batchWeights.size() == batchSize )
+				{
+					flush_batch(sum);
+				}
+			}
+
+			std::size_t i_dim = 0;	// advance to the next point
+
+			while ( (i_dim < dimInt) && (++indices[i_dim] == numNodes) )
+			{
+				indices[i_dim] = 0;
+
+				++i_dim;
+			}
+
+			if ( i_dim == dimInt )
+			{
+				break;
+			}
+		}
+
+		if ( not batchWeights.empty() )
+		{
+			flush_batch(sum);
+		}
+
+		return true;
+	};
+
+	return refine_levels(addLevel, dimInt, &numEval);
+}
+
+MultiDimInt::Algorithm::Result MultiDimInt::TanhSinhAlgorithm::integrate_nested (const InternalBatchIntegrand& func, const double* argsFix, const double minAbscissa, std::vector<double>& point, const std::size_t i_dim, std::size_t& numEval, bool& budgetExhausted) const
+{
+	const TanhSinhTable& table = TanhSinhTable::shared();
+
+	const std::size_t dimInt = point.size();
+
+	if ( i_dim + 1 == dimInt )	// innermost dimension, where all new points of a level along the line form one batch
+	{
+		std::vector<std::size_t> batchNodes;
+		std::vector<double> batchPoints;
+		std::vector<double> batchValues;
+
+		auto addLevel = [&] (const std::size_t level, double& sum, double& errorSum)
+		{
+			batchNodes.clear();
+
+			for ( std::size_t i_node = 0; i_node < table.number_of_nodes(level); ++i_node )
+			{
+				if ( table.node(level, i_node) >= minAbscissa )
+				{
+					batchNodes.push_back(i_node);
+				}
+			}
+
+			const std::size_t numPoints = batchNodes.size();
+
+			if ( not within_budget(numEval, numPoints) )
+			{
+				budgetExhausted = true;
+
+				return false;
+			}
+
+			batchPoints.resize(numPoints * dimInt);
+			batchValues.resize(numPoints);
+
+			for ( std::size_t i_point = 0; i_point < numPoints; ++i_point )
+			{
+				std::copy(point.begin(), point.end() - 1, &batchPoints[i_point * dimInt]);
+
+				batchPoints[i_point * dimInt + i_dim] = table.node(level, batchNodes[i_point]);
+			}
+
+			func(argsFix, numPoints, batchPoints.data(), batchValues.data());
+
+			numEval += numPoints;
+
+			for ( std::size_t i_point = 0; i_point < numPoints; ++i_point )
+			{
+				sum += table.weight(level, batchNodes[i_point]) * batchValues[i_point];
+			}
+
+			return true;
+		};
+
+		return refine_levels(addLevel, 1, (i_dim == 0) ? &numEval : NULL);	// only the outermost integral reports its progress
+	}
+
+	bool innerFailed = false;		// whether any inner integral failed, and the comment of the first one that did
+	std::string innerComment ("");
+
+	auto addLevel = [&] (const std::size_t level, double& sum, double& errorSum)
+	{
+		for ( std::size_t i_node = 0; i_node < table.number_of_nodes(level); ++i_node )
+		{
+			if ( table.node(level, i_node) < minAbscissa )
+			{
+				continue;
+			}
+
+			if ( not within_budget(numEval, 1) )
+			{
+				budgetExhausted = true;
+
+				return false;
+			}
+
+			point[i_dim] = table.node(level, i_node);
+
+			const Algorithm::Result innerIntegral = integrate_nested(func, argsFix, minAbscissa, point, i_dim + 1, numEval, budgetExhausted);
+
+			if ( budgetExhausted )	// the inner integral stopped early, so neither it nor this level can be completed
+			{
+				return false;
+			}
+
+			if ( innerIntegral.Failed && (not innerFailed) )
+			{
+				innerFailed = true;
+				innerComment = innerIntegral.Comment;
+			}
+
+			sum += table.weight(level, i_node) * innerIntegral.Value;
+			errorSum += table.weight(level, i_node) * innerIntegral.Error;
+		}
+
+		return true;
+	};
+
+	Algorithm::Result integral = refine_levels(addLevel, 1, (i_dim == 0) ? &numEval : NULL);
+
+	if ( innerFailed && (not integral.Failed) )
+	{
+		integral.Failed = true;
+
+		integral.Comment = innerComment;
+	}
+
+	return integral;
+}
+
+bool MultiDimInt::TanhSinhAlgorithm::within_budget (const std::size_t numEval, const std::size_t numNew) const
+{
+	return (MaxEval == 0) || (numEval + numNew <= MaxEval);
+}
@@ -0,0 +1,95 @@
+#ifndef MULTIDIMINT_TANH_SINH_ALGORITHM_H
+#define MULTIDIMINT_TANH_SINH_ALGORITHM_H
+
+#include "Algorithm.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class implementing a native tanh-sinh (double exponential) integration algorithm.
+	 *
+	 * The tanh-sinh rules (see TanhSinhTable) cluster their points double exponentially towards the ends of the unit interval,
+	 * so that they converge quickly even for integrands with integrable singularities there, as well as for the integrands
+	 * produced by the changes of variables that Integrator uses to implement semi-infinite and infinite integration
+	 * boundaries. The step size is halved level by level, reusing all points of the previous levels, until the difference
+	 * between the results of two successive levels meets the error limits.
+	 *
+	 * Integrals over up to a given number of variables are performed with the tensor product of the tanh-sinh rules, which
+	 * refines all dimensions at once. Integrals over more variables are performed as nested one-dimensional integrations,
+	 * where each inner integral is refined separately until it meets the error limits, and the estimated errors of the
+	 * inner integrals are added to that of the outer one.
+	 *
+	 * The integrand is always evaluated in batches: for all new points of a level of the tensor product, or for all new
+	 * points along a line in the innermost dimension of the nested integration. If the integrand is passed as a batch
+	 * integrand via Algorithm::run_batch, these batches are handed to it directly.
+	 */
+	class TanhSinhAlgorithm : public Algorithm
+	{
+	public:
+		/**
+		 * Constructor instantiating a tanh-sinh integration scheme with absolute error limit \a absErr, relative error limit
+		 * \a absRel and maximal number of integrand evaluations \a maxEval, which is unlimited if it is 0. Integrals over
+		 * at most \a maxTensorProductDim variables are performed with the tensor product rule, all others by nested
+		 * one-dimensional integrations.
+		 */
+		TanhSinhAlgorithm (double absErr, double relErr, std::size_t maxEval, std::size_t maxTensorProductDim = 3);
+
+		Algorithm::Result run (const InternalIntegrand& func, std::size_t dimInt, const double* argsFix) const;
+
+		Algorithm::Result run_batch (const InternalBatchIntegrand& func, std::size_t dimInt, const double* argsFix) const;
+
+		bool is_parallelized () const;
+
+		TanhSinhAlgorithm* clone () const;
+
+	private:
+		/**
+		 * Adds the contributions of the points that are new at each level to a running sum via \a addLevel, which takes the
+		 * level and adds the weighted integrand values and the weighted errors of inner integrals to its second and third
+		 * argument, and returns \c false if this would exceed the maximal number of integrand evaluations. The sums are
+		 * multiplied by the \a dimStep-th power of the step size of each level, until the difference between the results
+		 * of two successive levels meets the error limits. Returns the resulting Algorithm::Result. Unless \a numEval is
+		 * \c NULL, the estimate after each level is reported as the progress, together with the number of integrand
+		 * evaluations \a numEval points to.
+		 */
+		Algorithm::Result refine_levels (const std::function<bool(std::size_t level, double& sum, double& errorSum)>& addLevel, std::size_t dimStep, const std::size_t* numEval) const;
+
+		/**
+		 * Integrates the Algorithm::InternalBatchIntegrand \a func with fixed arguments \a argsFix over all \a dimInt
+		 * integration variables with the tensor product of the tanh-sinh rules, skipping all abscissas below \a minAbscissa
+		 * and counting the integrand evaluations in \a numEval.
+		 */
+		Algorithm::Result integrate_tensor_product (const InternalBatchIntegrand& func, std::size_t dimInt, const double* argsFix, double minAbscissa, std::size_t& numEval) const;
+
+		/**
+		 * Integrates the Algorithm::InternalBatchIntegrand \a func with fixed arguments \a argsFix over the integration
+		 * variables with indices from \a i_dim on, while those before are kept fixed at the values in \a point, by nested
+		 * one-dimensional integrations, skipping all abscissas below \a minAbscissa and counting the integrand evaluations
+		 * in \a numEval. If the maximal number of integrand evaluations is reached, \a budgetExhausted is set to \c true and
+		 * all enclosing integrations stop as well, failing with the respective comment.
+		 */
+		Algorithm::Result integrate_nested (const InternalBatchIntegrand& func, const double* argsFix, double minAbscissa, std::vector<double>& point, std::size_t i_dim, std::size_t& numEval, bool& budgetExhausted) const;
+
+		/**
+		 * Returns \c true if \a numNew further integrand evaluations, given that \a numEval of them have already been used,
+		 * do not exceed the maximal number of integrand evaluations.
+		 */
+		bool within_budget (std::size_t numEval, std::size_t numNew) const;
+
+		/**
+		 * Maximal number of integrand evaluations, which is unlimited if this is 0.
+		 */
+		std::size_t MaxEval;
+
+		/**
+		 * Maximal number of integration variables for which the tensor product rule is used.
+		 */
+		std::size_t MaxTensorProductDim;
+	};
+}
+
+#endif
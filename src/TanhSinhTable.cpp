@@ -0,0 +1,73 @@
+#include "TanhSinhTable.hpp"
+
+#include <cmath>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+constexpr std::size_t MultiDimInt::TanhSinhTable::MaxLevel;
+constexpr double MultiDimInt::TanhSinhTable::MinAbscissa;
+
+const MultiDimInt::TanhSinhTable& MultiDimInt::TanhSinhTable::shared ()
+{
+	static const TanhSinhTable table;	// the initialization of local static variables is thread-safe
+
+	return table;
+}
+
+double MultiDimInt::TanhSinhTable::step (const std::size_t level) const
+{
+	return std::ldexp(1.0, -static_cast<int>(level));
+}
+
+std::size_t MultiDimInt::TanhSinhTable::number_of_nodes (const std::size_t level) const
+{
+	return Nodes[level].size();
+}
+
+double MultiDimInt::TanhSinhTable::node (const std::size_t level, const std::size_t i_node) const
+{
+	return Nodes[level][i_node];
+}
+
+double MultiDimInt::TanhSinhTable::weight (const std::size_t level, const std::size_t i_node) const
+{
+	return Weights[level][i_node];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
+
+MultiDimInt::TanhSinhTable::TanhSinhTable () :
+	Nodes(MaxLevel + 1),
+	Weights(MaxLevel + 1)
+{
+	for ( std::size_t level = 0; level <= MaxLevel; ++level )
+	{
+		const double h = step(level);
+		const long stride = (level == 0) ? 1 : 2;	// only the odd multiples of the step size are new at levels above 0
+
+		for ( int direction = -1; direction <= 1; direction += 2 )	// go from the center towards the lower and the upper end of the interval
+		{
+			for ( long j = (direction < 0) ? -1 : ((level == 0) ? 0 : 1); true; j += direction * stride )
+			{
+				const double t = j * h;
+				const double u = M_PI * std::sinh(t);
+				const double expU = std::exp(-std::abs(u));	// computing x and x*(1-x) from exp(-|u|) avoids cancellations
+
+				const double x = (u < 0.0) ? expU / (1.0 + expU) : 1.0 / (1.0 + expU);
+
+				if ( (x < MinAbscissa) || (x >= 1.0) )
+				{
+					break;
+				}
+
+				Nodes[level].push_back(x);
+				Weights[level].push_back(M_PI * std::cosh(t) * expU / (1.0 + expU) / (1.0 + expU));	// x'(t) = pi*cosh(t) * x*(1-x)
+			}
+		}
+	}
+}
@@ -0,0 +1,94 @@
+#ifndef MULTIDIMINT_TANH_SINH_TABLE_H
+#define MULTIDIMINT_TANH_SINH_TABLE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace MultiDimInt
+{
+	/**
+	 * \brief Class holding the abscissas and weights of the tanh-sinh (double exponential) rules on the unit interval.
+	 *
+	 * The tanh-sinh rule with step size h samples the unit interval at the points x(t) = (1+tanh(pi/2*sinh(t)))/2 for all
+	 * multiples t of h, with weights h*x'(t), which decay double exponentially towards both ends of the interval. The rule
+	 * of level l has the step size 2^-l, such that it contains all points of the rules of lower levels. For each level,
+	 * only the points that are new at that level are stored, i.e. the odd multiples of its step size (all multiples for
+	 * level 0), and the weights are stored without the factor h.
+	 *
+	 * The points are truncated towards the lower end of the interval at TanhSinhTable::MinAbscissa, which keeps the
+	 * Jacobian of the change of variables implementing an infinite integration boundary in Integrator finite, and towards
+	 * the upper end where they can no longer be distinguished from 1. Singularities should thus be placed at the lower end
+	 * of the interval if possible. As the Jacobians of several integration variables are multiplied, TanhSinhAlgorithm
+	 * truncates the points of dimInt integration variables at the dimInt-th root of TanhSinhTable::MinAbscissa.
+	 *
+	 * There is only one table, which is computed when it is first accessed via TanhSinhTable::shared and never modified
+	 * afterwards, so it can be read by any number of threads and integrations at once.
+	 */
+	class TanhSinhTable
+	{
+	public:
+		/**
+		 * Highest level of the tabulated rules.
+		 */
+		static constexpr std::size_t MaxLevel = 10;
+
+		/**
+		 * Smallest abscissa of the tabulated rules.
+		 */
+		static constexpr double MinAbscissa = 1e-150;
+
+		/**
+		 * Returns the shared table, computing it on the first call.
+		 */
+		static const TanhSinhTable& shared ();
+
+		/**
+		 * Returns the step size of the rule of level \a level.
+		 */
+		double step (std::size_t level) const;
+
+		/**
+		 * Returns the number of points that are new at level \a level.
+		 */
+		std::size_t number_of_nodes (std::size_t level) const;
+
+		/**
+		 * Returns the abscissa of the point with index \a i_node among the points that are new at level \a level.
+		 */
+		double node (std::size_t level, std::size_t i_node) const;
+
+		/**
+		 * Returns the weight, without the factor of the step size, of the point with index \a i_node among the points that
+		 * are new at level \a level.
+		 */
+		double weight (std::size_t level, std::size_t i_node) const;
+
+		/**
+		 * Deleted copy-constructor, as there shall only be the shared table.
+		 */
+		TanhSinhTable (const TanhSinhTable& otherTable) = delete;
+
+		/**
+		 * Deleted assignment operator, as there shall only be the shared table.
+		 */
+		TanhSinhTable& operator= (const TanhSinhTable& otherTable) = delete;
+
+	private:
+		/**
+		 * Constructor computing the abscissas and weights of the rules of all levels up to TanhSinhTable::MaxLevel.
+		 */
+		TanhSinhTable ();
+
+		/**
+		 * Abscissas of the points that are new at each level.
+		 */
+		std::vector<std::vector<double>> Nodes;
+
+		/**
+		 * Weights, without the factor of the step size, of the points that are new at each level.
+		 */
+		std::vector<std::vector<double>> Weights;
+	};
+}
+
+#endif
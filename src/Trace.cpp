@@ -0,0 +1,368 @@
+#include "Trace.hpp"
+
+#include "Algorithm.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <typeinfo>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// public
+
+void MultiDimInt::Trace::enable (const std::string& fileName, const Format format)
+{
+	Trace& trace = shared();
+
+	std::unique_lock<std::mutex> lock (trace.StateMutex);
+
+	trace.finish(lock);
+
+	trace.write_buffers(true);	// discard records that arrived after the last trace was finished
+
+	trace.File.open(fileName, std::ios::out | std::ios::trunc);
+
+	if ( not trace.File.is_open() )
+	{
+		std::cout << std::endl
+				  << " MultiDimInt::Trace Error: Unable to open file " << fileName << std::endl
+				  << std::endl;
+
+		exit(EXIT_FAILURE);
+	}
+
+	trace.FileFormat = format;
+
+	if ( trace.FileFormat == Format::CSV )
+	{
+		trace.File << "identifier,dim_fix,dim_int,algorithm,abs_err,rel_err,error,num_eval,wall_time,status,depth" << std::endl;
+	}
+
+	trace.StopWriter = false;
+	trace.Writer = std::thread(&Trace::run_writer, &trace);
+
+	Enabled.store(true);
+}
+
+void MultiDimInt::Trace::disable ()
+{
+	Trace& trace = shared();
+
+	std::unique_lock<std::mutex> lock (trace.StateMutex);
+
+	trace.finish(lock);
+}
+
+bool MultiDimInt::Trace::is_enabled ()
+{
+	return Enabled.load(std::memory_order_relaxed);
+}
+
+void MultiDimInt::Trace::flush ()
+{
+	if ( not is_enabled() )
+	{
+		return;
+	}
+
+	Trace& trace = shared();
+
+	std::lock_guard<std::mutex> lock (trace.StateMutex);
+
+	if ( trace.File.is_open() )
+	{
+		trace.write_buffers(false);
+	}
+}
+
+void MultiDimInt::Trace::record (const Record& record)
+{
+	if ( not is_enabled() )
+	{
+		return;
+	}
+
+	ThreadBuffer& buffer = shared().thread_buffer();
+
+	std::lock_guard<std::mutex> lock (buffer.Mutex);	// only ever contended while the background thread takes the records
+
+	buffer.Records.push_back(record);
+}
+
+std::size_t MultiDimInt::Trace::nesting_depth ()
+{
+	return NestingDepth;
+}
+
+void MultiDimInt::Trace::set_nesting_depth (const std::size_t depth)
+{
+	NestingDepth = depth;
+}
+
+std::string MultiDimInt::Trace::algorithm_name (const Algorithm& alg)
+{
+	std::string name (typeid(alg).name());
+
+#ifdef __GNUG__
+	int status;
+	char* demangledName = abi::__cxa_demangle(name.c_str(), NULL, NULL, &status);
+
+	if ( status == 0 )
+	{
+		name = demangledName;
+	}
+
+	std::free(demangledName);
+#endif
+
+	const std::string prefix ("MultiDimInt::");
+
+	if ( name.compare(0, prefix.size(), prefix) == 0 )
+	{
+		name.erase(0, prefix.size());
+	}
+
+	return name;
+}
+
+MultiDimInt::Trace::EvaluationCounter::EvaluationCounter () :
+	Slots(std::max(std::thread::hardware_concurrency(), 1u))	// the slots are value-initialized, i.e. zero
+{}
+
+void MultiDimInt::Trace::EvaluationCounter::add (const std::size_t numEval)
+{
+	Slots[thread_index() % Slots.size()].Count.fetch_add(numEval, std::memory_order_relaxed);	// only contended if there are more threads than slots
+}
+
+std::size_t MultiDimInt::Trace::EvaluationCounter::total () const
+{
+	std::size_t numEval = 0;
+
+	for ( const Slot& slot : Slots )
+	{
+		numEval += slot.Count.load();
+	}
+
+	return numEval;
+}
+
+MultiDimInt::Trace::~Trace ()
+{
+	std::unique_lock<std::mutex> lock (StateMutex);
+
+	finish(lock);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// protected
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// private
+
+std::atomic<bool> MultiDimInt::Trace::Enabled (false);
+
+thread_local std::size_t MultiDimInt::Trace::NestingDepth = 0;
+
+std::size_t MultiDimInt::Trace::EvaluationCounter::thread_index ()
+{
+	static std::atomic<std::size_t> numThreads (0);
+
+	static thread_local const std::size_t index = numThreads.fetch_add(1);
+
+	return index;
+}
+
+MultiDimInt::Trace::Trace () :
+	File(),
+	FileFormat(Format::JSONLines),
+	Buffers(),
+	BuffersMutex(),
+	Writer(),
+	StopWriter(false),
+	WriterCondition(),
+	StateMutex()
+{}
+
+MultiDimInt::Trace& MultiDimInt::Trace::shared ()
+{
+	static Trace trace;	// the initialization of local static variables is thread-safe
+
+	return trace;
+}
+
+MultiDimInt::Trace::ThreadBuffer& MultiDimInt::Trace::thread_buffer ()
+{
+	static thread_local std::shared_ptr<ThreadBuffer> buffer;
+
+	if ( not buffer )	// first record of this thread
+	{
+		buffer = std::make_shared<ThreadBuffer>();
+
+		std::lock_guard<std::mutex> lock (BuffersMutex);	// not Trace::StateMutex, which the background thread holds while writing
+
+		Buffers.push_back(buffer);
+	}
+
+	return *buffer;
+}
+
+void MultiDimInt::Trace::finish (std::unique_lock<std::mutex>& lock)
+{
+	if ( not Writer.joinable() )
+	{
+		return;
+	}
+
+	Enabled.store(false);
+
+	StopWriter = true;
+
+	WriterCondition.notify_one();
+
+	std::thread writer;	// take over the background thread, such that no concurrent call joins it as well
+
+	std::swap(writer, Writer);
+
+	lock.unlock();	// the background thread needs the mutex to finish its last round
+
+	writer.join();
+
+	lock.lock();
+
+	write_buffers(false);
+
+	File.close();
+}
+
+void MultiDimInt::Trace::write_buffers (const bool discard)
+{
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+	{
+		std::lock_guard<std::mutex> lock (BuffersMutex);
+
+		buffers = Buffers;	// copied, such that threads recording for the first time can register their buffers while the file is written
+	}
+
+	std::vector<Record> records;
+
+	for ( const std::shared_ptr<ThreadBuffer>& buffer : buffers )
+	{
+		{
+			std::lock_guard<std::mutex> lock (buffer->Mutex);
+
+			records.swap(buffer->Records);	// the records are taken out at once to keep the thread waiting as short as possible
+		}
+
+		if ( not discard )
+		{
+			for ( const Record& record : records )
+			{
+				write_record(record);
+			}
+		}
+
+		records.clear();
+	}
+
+	if ( not discard )
+	{
+		File.flush();
+	}
+}
+
+void MultiDimInt::Trace::write_record (const Record& record)
+{
+	auto write_string = [this] (const std::string& text)
+	{
+		File << '"';
+
+		for ( const char character : text )
+		{
+			if ( FileFormat == Format::CSV )	// quotes are doubled in CSV
+			{
+				File << ((character == '"') ? "\"\"" : std::string(1, character));
+			}
+			else if ( (character == '"') || (character == '\\') )
+			{
+				File << '\\' << character;
+			}
+			else if ( static_cast<unsigned char>(character) < 0x20 )	// control characters are escaped in JSON
+			{
+				File << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(character) << std::dec << std::setfill(' ');
+			}
+			else
+			{
+				File << character;
+			}
+		}
+
+		File << '"';
+	};
+
+	auto write_number = [this] (const double number)
+	{
+		if ( Algorithm::is_finite(number) || (FileFormat == Format::CSV) )	// Algorithm::is_finite also detects NaN under -ffast-math
+		{
+			File << std::setprecision(9) << number;
+		}
+		else	// JSON has no representation of infinite values and NaN
+		{
+			File << "null";
+		}
+	};
+
+	if ( FileFormat == Format::CSV )
+	{
+		write_string(record.Identifier);
+		File << ',' << record.DimFix << ',' << record.DimInt << ',';
+		write_string(record.AlgorithmName);
+		File << ',';
+		write_number(record.AbsErr);
+		File << ',';
+		write_number(record.RelErr);
+		File << ',';
+		write_number(record.Error);
+		File << ',' << record.NumEval << ',';
+		write_number(record.WallTime);
+		File << ',';
+		write_string(record.Status);
+		File << ',' << record.Depth << '\n';
+	}
+	else
+	{
+		File << "{\"identifier\":";
+		write_string(record.Identifier);
+		File << ",\"dim_fix\":" << record.DimFix << ",\"dim_int\":" << record.DimInt << ",\"algorithm\":";
+		write_string(record.AlgorithmName);
+		File << ",\"abs_err\":";
+		write_number(record.AbsErr);
+		File << ",\"rel_err\":";
+		write_number(record.RelErr);
+		File << ",\"error\":";
+		write_number(record.Error);
+		File << ",\"num_eval\":" << record.NumEval << ",\"wall_time\":";
+		write_number(record.WallTime);
+		File << ",\"status\":";
+		write_string(record.Status);
+		File << ",\"depth\":" << record.Depth << "}\n";
+	}
+}
+
+void MultiDimInt::Trace::run_writer ()
+{
+	std::unique_lock<std::mutex> lock (StateMutex);
+
+	while ( not StopWriter )
+	{
+		WriterCondition.wait_for(lock, std::chrono::milliseconds(100));
+
+		write_buffers(false);
+	}
+}
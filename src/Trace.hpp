@@ -0,0 +1,242 @@
+#ifndef MULTIDIMINT_TRACE_H
+#define MULTIDIMINT_TRACE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MultiDimInt
+{
+	class Algorithm;
+
+	/**
+	 * \brief Class writing a trace of all integrations for offline performance analysis.
+	 *
+	 * Once tracing is switched on by Trace::enable, every integration and refinement performed by an Integrator, including
+	 * the inner integrations of nested integrals, is described by a Trace::Record that is written as one line of a JSON
+	 * Lines or CSV file. The records are collected in a buffer per thread that is guarded by its own mutex, which only the
+	 * background thread writing the file ever competes for, such that the integrations never wait for the file. While tracing is switched off, each
+	 * integration only checks an atomic flag.
+	 *
+	 * As all integrations are traced, there is only one trace, which is accessed via the static methods of this class.
+	 */
+	class Trace
+	{
+	public:
+		/**
+		 * Formats of the trace file. With Format::JSONLines, each record is a JSON object on a line of its own, with
+		 * Format::CSV, each record is a line of comma-separated values below a header line naming the fields.
+		 */
+		enum class Format
+		{
+			JSONLines,
+			CSV
+		};
+
+		/**
+		 * Structure describing one integration. \a Identifier is the identifier of the Integrator, \a DimFix and \a DimInt
+		 * are its numbers of fixed arguments and integration variables, \a AlgorithmName is the class name of its
+		 * integration Algorithm, and \a AbsErr and \a RelErr are the absolute and relative error limits. \a Error is the
+		 * resulting absolute error estimate, \a NumEval the number of integrand evaluations, \a WallTime the wall-clock
+		 * time in seconds, \a Status is one of "succeeded", "failed" and "deadline reached", and \a Depth is the number of
+		 * integrations the integration is nested in.
+		 */
+		struct Record
+		{
+			std::string Identifier;
+			std::size_t DimFix;
+			std::size_t DimInt;
+			std::string AlgorithmName;
+			double AbsErr;
+			double RelErr;
+			double Error;
+			std::size_t NumEval;
+			double WallTime;
+			std::string Status;
+			std::size_t Depth;
+		};
+
+		/**
+		 * \brief Class counting the integrand evaluations of one traced integration.
+		 *
+		 * Each thread adds to a counter of its own, which lies on a separate cache line, such that the threads of an
+		 * Algorithm evaluating the integrand concurrently do not compete for a single counter. The counters are only
+		 * summed up by EvaluationCounter::total.
+		 */
+		class EvaluationCounter
+		{
+		public:
+			/**
+			 * Constructor instantiating a counter with one slot per hardware thread.
+			 */
+			EvaluationCounter ();
+
+			/**
+			 * Adds \a numEval evaluations to the slot of the calling thread.
+			 */
+			void add (std::size_t numEval);
+
+			/**
+			 * Returns the number of evaluations added by all threads.
+			 */
+			std::size_t total () const;
+
+		private:
+			/**
+			 * Counter of one or, if there are more threads than slots, several threads, padded to a cache line of its own.
+			 */
+			struct Slot
+			{
+				std::atomic<std::size_t> Count;
+				char Padding[64 - sizeof(std::atomic<std::size_t>)];
+			};
+
+			/**
+			 * Returns the index of the calling thread, which is assigned on its first call.
+			 */
+			static std::size_t thread_index ();
+
+			std::vector<Slot> Slots;
+		};
+
+		/**
+		 * Switches tracing on, writing all following records to the file \a fileName in the format \a format. A trace
+		 * that is already being written is finished first.
+		 */
+		static void enable (const std::string& fileName, Format format);
+
+		/**
+		 * Switches tracing off, writing all remaining records and closing the file.
+		 */
+		static void disable ();
+
+		/**
+		 * Returns \c true if tracing is switched on.
+		 */
+		static bool is_enabled ();
+
+		/**
+		 * Writes all records collected so far to the file, without waiting for the background thread.
+		 */
+		static void flush ();
+
+		/**
+		 * Adds the Trace::Record \a record to the buffer of the calling thread, if tracing is switched on.
+		 */
+		static void record (const Record& record);
+
+		/**
+		 * Returns the number of integrations the calling thread is currently nested in.
+		 */
+		static std::size_t nesting_depth ();
+
+		/**
+		 * Sets the number of integrations the calling thread is currently nested in to \a depth. This is done by the
+		 * Integrator around each evaluation of a traced integrand, as the threads of the integration Algorithm do not
+		 * know the depth of the integration they are working for.
+		 */
+		static void set_nesting_depth (std::size_t depth);
+
+		/**
+		 * Returns the class name of the Algorithm \a alg, without the namespace.
+		 */
+		static std::string algorithm_name (const Algorithm& alg);
+
+		/**
+		 * Destructor finishing the trace, if it is still being written, at the end of the program.
+		 */
+		~Trace ();
+
+	private:
+		/**
+		 * Structure holding the records of one thread that have not been written yet, together with the mutex guarding
+		 * them.
+		 */
+		struct ThreadBuffer
+		{
+			std::mutex Mutex;
+			std::vector<Record> Records;
+		};
+
+		/**
+		 * Constructor instantiating a trace that is switched off.
+		 */
+		Trace ();
+
+		/**
+		 * Returns the only trace.
+		 */
+		static Trace& shared ();
+
+		/**
+		 * Returns the buffer of the calling thread, creating and registering it on its first call.
+		 */
+		ThreadBuffer& thread_buffer ();
+
+		/**
+		 * Finishes the trace that is being written, if there is one. The caller has to hold Trace::StateMutex via \a lock,
+		 * which is released while waiting for the background thread.
+		 */
+		void finish (std::unique_lock<std::mutex>& lock);
+
+		/**
+		 * Takes the records out of all buffers and writes them to the file, or discards them if \a discard is \c true.
+		 * The caller has to hold Trace::StateMutex.
+		 */
+		void write_buffers (bool discard);
+
+		/**
+		 * Writes the Trace::Record \a record as one line of the file.
+		 */
+		void write_record (const Record& record);
+
+		/**
+		 * Loop of the background thread, which writes the buffers periodically until Trace::StopWriter is set.
+		 */
+		void run_writer ();
+
+		/**
+		 * Whether tracing is switched on. This is a static member, such that it can be checked without accessing the
+		 * trace itself.
+		 */
+		static std::atomic<bool> Enabled;
+
+		/**
+		 * Number of integrations the current thread is nested in, see Trace::nesting_depth.
+		 */
+		static thread_local std::size_t NestingDepth;
+
+		/**
+		 * File the records are written to, and its format.
+		 */
+		std::ofstream File;
+		Format FileFormat;
+
+		/**
+		 * Buffers of all threads that have recorded an integration so far, which are kept after the threads have ended,
+		 * and the mutex guarding the list of them, which is never held while writing the file.
+		 */
+		std::vector<std::shared_ptr<ThreadBuffer>> Buffers;
+		std::mutex BuffersMutex;
+
+		/**
+		 * Background thread writing the buffers, the flag telling it to stop, and the condition variable it waits on.
+		 */
+		std::thread Writer;
+		bool StopWriter;
+		std::condition_variable WriterCondition;
+
+		/**
+		 * Mutex guarding the file and the background thread.
+		 */
+		std::mutex StateMutex;
+	};
+}
+
+#endif
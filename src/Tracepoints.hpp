@@ -0,0 +1,41 @@
+#ifndef MULTIDIMINT_TRACEPOINTS_H
+#define MULTIDIMINT_TRACEPOINTS_H
+
+/**
+ * \file Tracepoints.hpp
+ * \brief Static tracepoints (USDT probes) on the hot path of the integrations.
+ *
+ * If MultiDimInt is compiled with the macro MULTIDIMINT_USDT defined (make USDT=1), which requires the header sys/sdt.h
+ * of SystemTap, the macros below place static tracepoints of the provider "multidimint" into the code. Each of them is a
+ * single nop instruction until a tracer like perf or bpftrace attaches to it, so they can stay in production builds
+ * (see tools/multidimint.bt for an example). Otherwise, the macros expand to nothing and their arguments are not even
+ * evaluated. The tracepoints are
+ *
+ *  - integration__start(identifier, dimFix, dimInt) and integration__done(identifier, dimFix, dimInt, status) around
+ *    each integration and refinement of an Integrator, where identifier is its identifier as a C string and status is 0
+ *    if the integration succeeded, 1 if it failed and 2 if it reached its Deadline,
+ *  - cubature__batch__start(numPoints) and cubature__batch__done(numPoints) around the batches of points that the
+ *    vectorized Cubature routines pass to CubatureParallelAlgorithm and CubatureSerialAlgorithm,
+ *  - cuba__batch__start(numPoints) and cuba__batch__done(numPoints) around the batches of points that Cuba passes to
+ *    CubaAlgorithm in the thread mode,
+ *  - nested__level__start(level) and nested__level__done(level) around each inner one-dimensional integration of
+ *    GSLNestedAlgorithm, where level is the index of its integration variable.
+ */
+
+#ifdef MULTIDIMINT_USDT
+
+#include <sys/sdt.h>
+
+#define MULTIDIMINT_TRACEPOINT1(name, arg1) DTRACE_PROBE1(multidimint, name, arg1)
+#define MULTIDIMINT_TRACEPOINT3(name, arg1, arg2, arg3) DTRACE_PROBE3(multidimint, name, arg1, arg2, arg3)
+#define MULTIDIMINT_TRACEPOINT4(name, arg1, arg2, arg3, arg4) DTRACE_PROBE4(multidimint, name, arg1, arg2, arg3, arg4)
+
+#else
+
+#define MULTIDIMINT_TRACEPOINT1(name, arg1) ((void) 0)
+#define MULTIDIMINT_TRACEPOINT3(name, arg1, arg2, arg3) ((void) 0)
+#define MULTIDIMINT_TRACEPOINT4(name, arg1, arg2, arg3, arg4) ((void) 0)
+
+#endif
+
+#endif